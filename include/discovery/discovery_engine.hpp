@@ -172,6 +172,7 @@ struct DiscoveryConfig {
 
     // Global
     size_t max_total_insights = 2000;    // Hard cap total insights
+    size_t num_threads = 0;              // Workers for parallel operators (0 = hardware concurrency)
 
     // Dynamic calibration targets
     size_t target_insights_per_operator = 20; // Soft target per operator
@@ -267,14 +268,21 @@ private:
         size_t tail;      // Entity index
     };
 
-    // Embedding model state
+    // Embedding model state (row-major so rows feed the vector kernels directly)
     struct EmbeddingModel {
-        std::vector<std::vector<double>> entity_embeddings;   // [num_entities][dim]
-        std::vector<std::vector<double>> relation_embeddings; // [num_relations][dim]
+        size_t dim = 0;
+        std::vector<float> entity_embeddings;    // [num_entities * dim]
+        std::vector<float> relation_embeddings;  // [num_relations * dim]
         std::unordered_map<std::string, size_t> entity_to_idx;
         std::unordered_map<std::string, size_t> relation_to_idx;
         std::vector<std::string> idx_to_entity;
         std::vector<std::string> idx_to_relation;
+
+        size_t num_entities() const { return dim == 0 ? 0 : entity_embeddings.size() / dim; }
+        float* entity(size_t i) { return entity_embeddings.data() + i * dim; }
+        const float* entity(size_t i) const { return entity_embeddings.data() + i * dim; }
+        float* relation(size_t i) { return relation_embeddings.data() + i * dim; }
+        const float* relation(size_t i) const { return relation_embeddings.data() + i * dim; }
     };
 
     // Extract triples from hypergraph (convert hyperedges to binary relations)
@@ -283,8 +291,8 @@ private:
     // Initialize embeddings randomly
     void init_embeddings(EmbeddingModel& model, size_t num_entities, size_t num_relations) const;
 
-    // TransE scoring: ||h + r - t||
-    double transe_score(const EmbeddingModel& model, const Triple& triple) const;
+    // TransE residual h + r - t; the triple's score is its L2 norm
+    void transe_residual(const EmbeddingModel& model, const Triple& triple, float* out) const;
 
     // Train TransE model
     void train_transe(EmbeddingModel& model, const std::vector<Triple>& triples);
@@ -296,9 +304,6 @@ private:
     std::vector<std::pair<Triple, double>> predict_links(
         const EmbeddingModel& model,
         const std::vector<Triple>& existing_triples) const;
-
-    // L2 normalize a vector
-    void normalize_vector(std::vector<double>& vec) const;
 };
 
 } // namespace kg
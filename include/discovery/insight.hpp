@@ -1,5 +1,6 @@
 #pragma once
 
+#include "util/json_stream.hpp"
 #include <nlohmann/json.hpp>
 #include <string>
 #include <vector>
@@ -216,19 +217,42 @@ struct InsightCollection {
         return col;
     }
 
-    void save_to_json(const std::string& path) const {
-        std::ofstream file(path);
-        file << to_json().dump(2);
+    // Same document as to_json(), streamed one insight at a time
+    void write_json(std::ostream& out, bool compact = false) const {
+        JsonWriter writer(out, compact);
+        writer.begin_object();
+
+        writer.key("meta").begin_object();
+        writer.member("run_id", run_id);
+        writer.member("created_utc", created_utc);
+        writer.member("source_graph", source_graph);
+        writer.member("total_insights", insights.size());
+        writer.end_object();
+
+        std::map<std::string, int> by_type;
+        writer.key("insights").begin_array();
+        for (const auto& ins : insights) {
+            writer.value(ins.to_json());
+            by_type[insight_type_to_string(ins.type)]++;
+        }
+        writer.end_array();
+
+        writer.member("summary_by_type", by_type);
+        writer.end_object();
+    }
+
+    void save_to_json(const std::string& path, const JsonWriteOptions& options = {}) const {
+        JsonOutputFile file(path, options);
+        write_json(file.stream(), options.compact);
+        file.close();
     }
 
     static InsightCollection load_from_json(const std::string& path) {
-        std::ifstream file(path);
-        if (!file.is_open()) {
+        if (!std::ifstream(path).is_open()) {
             throw std::runtime_error("Cannot open insights file: " + path);
         }
-        nlohmann::json j;
-        file >> j;
-        return from_json(j);
+        auto input = open_json_input(path);
+        return from_json(nlohmann::json::parse(*input));
     }
 };
 
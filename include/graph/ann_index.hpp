@@ -0,0 +1,193 @@
+#pragma once
+
+#include <nlohmann/json.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace kg {
+
+/**
+ * @brief Search strategy behind a VectorIndex
+ */
+enum class AnnMethod {
+    Exact,      // Brute-force scan; ground truth for validation
+    Hnsw        // Hierarchical navigable small-world graph
+};
+
+/**
+ * @brief Parse "exact" / "hnsw" (case-sensitive); throws std::invalid_argument otherwise
+ */
+AnnMethod ann_method_from_string(const std::string& name);
+std::string ann_method_to_string(AnnMethod method);
+
+/**
+ * @brief Tuning knobs for make_vector_index and embedding deduplication
+ */
+struct AnnConfig {
+    AnnMethod method = AnnMethod::Hnsw;
+    size_t exact_below = 20000;         // Fall back to Exact for fewer vectors than this
+    size_t max_neighbors = 32;          // Cap on neighbours per threshold query (0 = unbounded)
+    size_t hnsw_m = 16;                 // Links per node on upper layers (twice this on layer 0)
+    size_t hnsw_ef_construction = 200;  // Candidate list size while inserting
+    size_t hnsw_ef_search = 64;         // Candidate list size while querying
+    size_t num_threads = 0;             // Query workers (0 = hardware concurrency)
+    uint64_t seed = 42;                 // Level assignment seed, so builds are reproducible
+};
+
+/**
+ * @brief A neighbour returned by a VectorIndex query
+ */
+struct AnnNeighbor {
+    uint32_t id;                        // Insertion index of the vector
+    float similarity;                   // Cosine similarity to the query
+};
+
+/**
+ * @brief In-process nearest-neighbour index over fixed-dimension vectors
+ *
+ * Vectors are L2-normalized on insertion and addressed by insertion order,
+ * so similarity is cosine. Queries are const and safe to run concurrently
+ * once all vectors have been added.
+ */
+class VectorIndex {
+public:
+    explicit VectorIndex(size_t dimension);
+    virtual ~VectorIndex() = default;
+
+    VectorIndex(const VectorIndex&) = delete;
+    VectorIndex& operator=(const VectorIndex&) = delete;
+
+    /**
+     * @brief Add a vector of dimension() floats; returns its id
+     */
+    uint32_t add(const float* vector);
+    uint32_t add(const std::vector<float>& vector);
+
+    /**
+     * @brief Up to k most similar vectors, most similar first
+     */
+    virtual std::vector<AnnNeighbor> search(const float* query, size_t k) const = 0;
+
+    /**
+     * @brief Vectors with similarity >= threshold, most similar first
+     * @param k Cap on results (0 = unbounded for Exact, ef_search for approximate indexes)
+     */
+    virtual std::vector<AnnNeighbor> search_threshold(
+        const float* query, float threshold, size_t k = 0) const;
+
+    virtual AnnMethod method() const = 0;
+
+    size_t dimension() const { return dimension_; }
+    size_t size() const { return count_; }
+
+    /**
+     * @brief Normalized copy of vector id
+     */
+    const float* vector(uint32_t id) const { return data_.data() + static_cast<size_t>(id) * dimension_; }
+
+protected:
+    virtual void on_add(uint32_t id) = 0;
+
+    float similarity(const float* a, const float* b) const;
+
+    size_t dimension_;
+    size_t count_ = 0;
+    std::vector<float> data_;           // count_ x dimension_, row-major, unit length
+};
+
+/**
+ * @brief Brute-force index; every query scans all vectors
+ */
+class ExactVectorIndex : public VectorIndex {
+public:
+    explicit ExactVectorIndex(size_t dimension) : VectorIndex(dimension) {}
+
+    std::vector<AnnNeighbor> search(const float* query, size_t k) const override;
+    std::vector<AnnNeighbor> search_threshold(
+        const float* query, float threshold, size_t k = 0) const override;
+    AnnMethod method() const override { return AnnMethod::Exact; }
+
+protected:
+    void on_add(uint32_t) override {}
+};
+
+/**
+ * @brief HNSW graph index (Malkov & Yashunin), built incrementally on add()
+ */
+class HnswVectorIndex : public VectorIndex {
+public:
+    HnswVectorIndex(size_t dimension, const AnnConfig& config);
+
+    std::vector<AnnNeighbor> search(const float* query, size_t k) const override;
+    std::vector<AnnNeighbor> search_threshold(
+        const float* query, float threshold, size_t k = 0) const override;
+    AnnMethod method() const override { return AnnMethod::Hnsw; }
+
+protected:
+    void on_add(uint32_t id) override;
+
+private:
+    using Candidate = std::pair<float, uint32_t>;   // (distance, id)
+
+    std::vector<Candidate> search_layer(const float* query, uint32_t entry,
+                                        size_t ef, int layer) const;
+    uint32_t greedy_descend(const float* query, uint32_t entry,
+                            int from_layer, int to_layer) const;
+    std::vector<uint32_t> select_neighbors(const std::vector<Candidate>& candidates,
+                                           size_t m) const;
+    void shrink_links(uint32_t id, int layer);
+    std::vector<AnnNeighbor> query(const float* query, size_t ef, size_t k) const;
+
+    size_t m_;
+    size_t m0_;
+    size_t ef_construction_;
+    size_t ef_search_;
+    double level_mult_;
+    uint64_t rng_state_;
+
+    std::vector<std::vector<std::vector<uint32_t>>> links_;   // links_[id][layer]
+    uint32_t entry_point_ = 0;
+    int max_level_ = -1;
+};
+
+/**
+ * @brief Create the index selected by config for the given vector count
+ *
+ * Requests for Hnsw return an ExactVectorIndex when expected_size is below
+ * config.exact_below, where a scan is both exact and cheaper than a build.
+ */
+std::unique_ptr<VectorIndex> make_vector_index(
+    size_t dimension, size_t expected_size, const AnnConfig& config);
+
+/**
+ * @brief Recall and latency of an approximate index against brute force
+ */
+struct AnnReport {
+    std::string method;
+    size_t num_vectors = 0;
+    size_t dimension = 0;
+    size_t num_queries = 0;
+    size_t k = 0;
+    double recall_at_k = 0.0;                          // Mean |approx ∩ exact| / |exact| over queries
+    double build_ms = 0.0;                             // Index construction
+    double exact_build_ms = 0.0;
+    double mean_query_us = 0.0;                        // Per query, single thread
+    double exact_mean_query_us = 0.0;
+
+    nlohmann::json to_json() const;
+};
+
+/**
+ * @brief Build both indexes over vectors and compare top-k results
+ * @param num_queries Queries drawn (deterministically) from the vectors themselves
+ */
+AnnReport evaluate_vector_index(const std::vector<std::vector<float>>& vectors,
+                                const AnnConfig& config,
+                                size_t num_queries = 200,
+                                size_t k = 10);
+
+} // namespace kg
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "graph/hypergraph.hpp"
+#include "util/section_file.hpp"
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace kg {
+
+/**
+ * @brief Read-only view of a binary hypergraph snapshot (see Hypergraph::export_to_binary)
+ *
+ * The file is mapped with mmap and every accessor reads straight from the
+ * mapping, so opening is O(1) in the graph size and concurrent readers
+ * share one copy in the page cache. The constructor checks the header and
+ * section directory only; accessors are unchecked, and validate() does the
+ * full pass over offsets and handles before a snapshot from an untrusted
+ * source is traversed.
+ *
+ * Layout (version 2, a SectionFile with magic "KGSNAP\r\n"):
+ * - counts: node, edge and string counts
+ * - string table: offsets + UTF-8 bytes; every ID, label, relation and
+ *   provenance string is stored once and referenced by index
+ * - CSR incidence: node -> edges (incidence order) and edge -> distinct
+ *   members (ascending), exactly as IncidenceCSR
+ * - edge columns: sources, targets, id, relation, document, chunk, page,
+ *   confidence and properties, one array per field
+ * - node columns: id, label, properties and embedding
+ *
+ * Handles are dense: tombstones are dropped on export, so node n and edge
+ * e are the n-th live node and e-th live edge of the exported graph.
+ */
+class GraphSnapshot {
+public:
+    /**
+     * @brief Map a snapshot file
+     * @throws std::runtime_error if the file cannot be mapped or is not a valid snapshot
+     */
+    explicit GraphSnapshot(const std::string& filename);
+
+    /**
+     * @brief Check the magic bytes without mapping the file
+     */
+    static bool is_snapshot_file(const std::string& filename);
+
+    static constexpr uint32_t VERSION = 2;
+
+    /**
+     * @brief Check that every offset array is monotonic and every handle and
+     *        string index is in range
+     * @throws std::runtime_error describing the first inconsistency
+     */
+    void validate() const;
+
+    size_t num_nodes() const { return num_nodes_; }
+    size_t num_edges() const { return num_edges_; }
+    size_t num_strings() const { return num_strings_; }
+
+    std::string_view string(uint32_t index) const;
+
+    // Node columns
+    std::string_view node_id(NodeId n) const { return string(node_ids_[n]); }
+    std::string_view node_label(NodeId n) const { return string(node_labels_[n]); }
+    IdSpan<uint32_t> node_properties(NodeId n) const;   // Alternating key, value string indices
+    IdSpan<float> node_embedding(NodeId n) const;
+
+    // CSR incidence
+    IdSpan<EdgeId> edges_of(NodeId n) const;
+    IdSpan<NodeId> nodes_of(EdgeId e) const;
+
+    // Edge columns
+    IdSpan<NodeId> sources_of(EdgeId e) const;
+    IdSpan<NodeId> targets_of(EdgeId e) const;
+    std::string_view edge_id(EdgeId e) const { return string(edge_ids_[e]); }
+    std::string_view edge_relation(EdgeId e) const { return string(edge_relations_[e]); }
+    std::string_view edge_document(EdgeId e) const { return string(edge_documents_[e]); }
+    std::string_view edge_chunk(EdgeId e) const { return string(edge_chunks_[e]); }
+    int edge_page(EdgeId e) const { return edge_pages_[e]; }
+    double edge_confidence(EdgeId e) const { return edge_confidences_[e]; }
+    IdSpan<uint32_t> edge_properties(EdgeId e) const;   // Alternating key, value string indices
+
+    /**
+     * @brief Copy the CSR arrays into an IncidenceCSR
+     */
+    IncidenceCSR incidence() const;
+
+private:
+    template <typename T>
+    using Column = ArrayView<T>;
+
+    static IdSpan<uint32_t> row(const Column<uint64_t>& offsets, const Column<uint32_t>& values, size_t i) {
+        return {values.data + offsets[i], values.data + offsets[i + 1]};
+    }
+
+    SectionFile file_;
+    size_t num_nodes_ = 0;
+    size_t num_edges_ = 0;
+    size_t num_strings_ = 0;
+
+    Column<uint64_t> string_offsets_;
+    Column<char> string_data_;
+
+    Column<uint32_t> node_ids_;
+    Column<uint32_t> node_labels_;
+    Column<uint64_t> node_property_offsets_;
+    Column<uint32_t> node_properties_;
+    Column<uint64_t> node_embedding_offsets_;
+    Column<float> node_embeddings_;
+
+    Column<uint64_t> node_edge_offsets_;
+    Column<uint32_t> node_edges_;
+    Column<uint64_t> edge_node_offsets_;
+    Column<uint32_t> edge_nodes_;
+
+    Column<uint64_t> edge_source_offsets_;
+    Column<uint32_t> edge_sources_;
+    Column<uint64_t> edge_target_offsets_;
+    Column<uint32_t> edge_targets_;
+    Column<uint32_t> edge_ids_;
+    Column<uint32_t> edge_relations_;
+    Column<uint32_t> edge_documents_;
+    Column<uint32_t> edge_chunks_;
+    Column<int32_t> edge_pages_;
+    Column<double> edge_confidences_;
+    Column<uint64_t> edge_property_offsets_;
+    Column<uint32_t> edge_properties_;
+};
+
+} // namespace kg
@@ -2,16 +2,37 @@
 #define HYPERGRAPH_HPP
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <map>
 #include <set>
+#include <unordered_map>
 #include <memory>
 #include <optional>
 #include <functional>
+#include <cstdint>
+#include <cstddef>
+#include <iosfwd>
+#include <iterator>
+#include <limits>
+#include <mutex>
 #include <nlohmann/json.hpp>
+#include "util/json_stream.hpp"
+#include "graph/ann_index.hpp"
 
 namespace kg {
 
+/**
+ * @brief Dense integer handles for interned nodes and hyperedges
+ *
+ * Handles index directly into the Hypergraph's contiguous storage and stay
+ * stable for the lifetime of the graph: removals leave a tombstone instead
+ * of renumbering, so a handle is either live or permanently dead.
+ */
+using NodeId = uint32_t;
+using EdgeId = uint32_t;
+constexpr uint32_t INVALID_ID = std::numeric_limits<uint32_t>::max();
+
 /**
  * @brief Represents a node in the hypergraph
  *
@@ -33,6 +54,11 @@ struct HyperNode {
      */
     nlohmann::json to_json() const;
 
+    /**
+     * @brief Stream the same fields as to_json()
+     */
+    void write_json(JsonWriter& writer) const;
+
     /**
      * @brief Create node from JSON
      */
@@ -91,6 +117,12 @@ struct HyperEdge {
      */
     nlohmann::json to_json() const;
 
+    /**
+     * @brief Stream the same fields as to_json()
+     * @param include_metadata Also write properties and provenance
+     */
+    void write_json(JsonWriter& writer, bool include_metadata = true) const;
+
     /**
      * @brief Create hyperedge from JSON
      */
@@ -118,6 +150,14 @@ struct HypergraphStatistics {
     size_t num_pairs_overlap_2 = 0;
     size_t num_pairs_overlap_3 = 0;
 
+    // Set when the overlap fields above are estimated from a sample of edges;
+    // max_edge_intersection is then the largest overlap seen in the sample
+    bool overlap_estimated = false;
+    size_t overlap_sample_size = 0;
+    double overlap_1_margin = 0.0;                     // 95% confidence half-widths
+    double overlap_2_margin = 0.0;
+    double overlap_3_margin = 0.0;
+
     // Power law fit for degree distribution (if applicable)
     std::optional<double> power_law_exponent;
     std::optional<double> power_law_r_squared;
@@ -125,6 +165,50 @@ struct HypergraphStatistics {
     nlohmann::json to_json() const;
 };
 
+/**
+ * @brief How much work Hypergraph::compute_statistics should do
+ */
+enum class StatisticsTier {
+    Cheap,      // Counts, edge sizes and node degrees from incrementally kept counters
+    Full        // Adds duplicate, pairwise-overlap and power-law analysis (memoized)
+};
+
+/**
+ * @brief Tuning knobs for Hypergraph::compute_statistics
+ */
+struct StatisticsOptions {
+    StatisticsTier tier = StatisticsTier::Full;
+    size_t num_threads = 0;                            // Overlap kernel workers (0 = hardware concurrency)
+    size_t overlap_sample_threshold = 200000;          // Estimate overlaps above this many edges (0 = always exact)
+    size_t overlap_sample_size = 20000;                // Edges sampled when estimating
+    uint64_t seed = 42;                                // Sampling seed, so estimates are reproducible
+};
+
+/**
+ * @brief Outcome of merging one hypergraph into another
+ */
+struct MergeResult {
+    size_t edges_merged = 0;                           // Incoming edges added
+    size_t nodes_added = 0;                            // Nodes new to the destination
+    size_t duplicate_edges = 0;                        // Edges dropped as signature duplicates
+    size_t self_loops = 0;                             // Edges dropped as self-loops
+
+    nlohmann::json to_json() const;
+};
+
+/**
+ * @brief Field projections and trust settings for Hypergraph::load_from_json
+ *
+ * Projected-out fields are skipped by the tokenizer and never allocated.
+ */
+struct JsonLoadOptions {
+    bool embeddings = true;                            // Node embedding vectors
+    bool node_properties = true;
+    bool edge_properties = true;
+    bool provenance = true;                            // source_document, source_chunk_id, source_page
+    bool trust_normalized_flag = true;                 // Take IDs verbatim when metadata.normalized is set
+};
+
 /**
  * @brief Result of a path search query
  */
@@ -137,6 +221,179 @@ struct PathSearchResult {
     nlohmann::json to_json() const;
 };
 
+/**
+ * @brief Non-owning view over a contiguous run of handles
+ */
+template <typename T>
+class IdSpan {
+public:
+    IdSpan() = default;
+    IdSpan(const T* first, const T* last) : first_(first), last_(last) {}
+
+    const T* begin() const { return first_; }
+    const T* end() const { return last_; }
+    size_t size() const { return static_cast<size_t>(last_ - first_); }
+    bool empty() const { return first_ == last_; }
+    const T& operator[](size_t i) const { return first_[i]; }
+
+private:
+    const T* first_ = nullptr;
+    const T* last_ = nullptr;
+};
+
+/**
+ * @brief Forward range over the live entries of a slot vector
+ *
+ * Yields const references to each live slot's value, skipping tombstones.
+ * Slot must expose `bool alive` and `const Value& value() const`.
+ */
+template <typename Slot, typename Value>
+class LiveSlotView {
+public:
+    class iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Value;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Value*;
+        using reference = const Value&;
+
+        iterator() = default;
+        iterator(const Slot* current, const Slot* last) : current_(current), last_(last) {
+            skip_dead();
+        }
+
+        reference operator*() const { return current_->value(); }
+        pointer operator->() const { return &current_->value(); }
+        iterator& operator++() { ++current_; skip_dead(); return *this; }
+        iterator operator++(int) { iterator tmp = *this; ++*this; return tmp; }
+        bool operator==(const iterator& other) const { return current_ == other.current_; }
+        bool operator!=(const iterator& other) const { return current_ != other.current_; }
+
+    private:
+        void skip_dead() {
+            while (current_ != last_ && !current_->alive) ++current_;
+        }
+
+        const Slot* current_ = nullptr;
+        const Slot* last_ = nullptr;
+    };
+
+    LiveSlotView(const Slot* first, const Slot* last, size_t live)
+        : first_(first), last_(last), live_(live) {}
+
+    iterator begin() const { return iterator(first_, last_); }
+    iterator end() const { return iterator(last_, last_); }
+    size_t size() const { return live_; }
+    bool empty() const { return live_ == 0; }
+
+private:
+    const Slot* first_;
+    const Slot* last_;
+    size_t live_;
+};
+
+/**
+ * @brief Forward range mapping a run of handles to the values they address
+ */
+template <typename Slot, typename Value, typename Id>
+class HandleView {
+public:
+    class iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Value;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Value*;
+        using reference = const Value&;
+
+        iterator() = default;
+        iterator(const Slot* slots, const Id* current) : slots_(slots), current_(current) {}
+
+        reference operator*() const { return slots_[*current_].value(); }
+        pointer operator->() const { return &slots_[*current_].value(); }
+        iterator& operator++() { ++current_; return *this; }
+        iterator operator++(int) { iterator tmp = *this; ++current_; return tmp; }
+        bool operator==(const iterator& other) const { return current_ == other.current_; }
+        bool operator!=(const iterator& other) const { return current_ != other.current_; }
+
+    private:
+        const Slot* slots_ = nullptr;
+        const Id* current_ = nullptr;
+    };
+
+    HandleView() = default;
+    HandleView(const Slot* slots, const Id* first, const Id* last)
+        : slots_(slots), first_(first), last_(last) {}
+
+    iterator begin() const { return iterator(slots_, first_); }
+    iterator end() const { return iterator(slots_, last_); }
+    size_t size() const { return static_cast<size_t>(last_ - first_); }
+    bool empty() const { return first_ == last_; }
+    const Value& operator[](size_t i) const { return slots_[first_[i]].value(); }
+
+private:
+    const Slot* slots_ = nullptr;
+    const Id* first_ = nullptr;
+    const Id* last_ = nullptr;
+};
+
+/**
+ * @brief Immutable compressed-sparse-row incidence of a hypergraph snapshot
+ *
+ * Node row n lists the edges incident to node n in insertion order; edge
+ * row e lists the distinct member nodes of edge e in ascending order. Rows
+ * of dead handles are empty, so both sides can be indexed by any handle
+ * below the bound the snapshot was built with.
+ */
+struct IncidenceCSR {
+    std::vector<uint64_t> node_offsets;                // num_node_rows() + 1 entries
+    std::vector<EdgeId> node_edges;                    // Concatenated node rows
+    std::vector<uint64_t> edge_offsets;                // num_edge_rows() + 1 entries
+    std::vector<NodeId> edge_nodes;                    // Concatenated edge rows
+
+    size_t num_node_rows() const { return node_offsets.empty() ? 0 : node_offsets.size() - 1; }
+    size_t num_edge_rows() const { return edge_offsets.empty() ? 0 : edge_offsets.size() - 1; }
+
+    IdSpan<EdgeId> edges_of(NodeId n) const {
+        return {node_edges.data() + node_offsets[n], node_edges.data() + node_offsets[n + 1]};
+    }
+
+    IdSpan<NodeId> nodes_of(EdgeId e) const {
+        return {edge_nodes.data() + edge_offsets[e], edge_nodes.data() + edge_offsets[e + 1]};
+    }
+};
+
+class GraphSnapshot;
+class Hypergraph;
+
+/**
+ * @brief Receives structural mutations of a Hypergraph as they happen
+ *
+ * Removal and update-begin events fire while the element is still intact,
+ * so observers can read its members; add and update-end events fire once
+ * the graph reflects the change. merge_nodes() reports each rewritten edge
+ * as an update, then removes the merged node. Edits made through the
+ * mutable get_node() / get_hyperedge() pointers are not reported.
+ *
+ * Observers are registered by pointer and never owned. They are not carried
+ * over by copies or moves of the graph; a graph that is destroyed or
+ * assigned over calls on_detached() and forgets its observers.
+ */
+class HypergraphObserver {
+public:
+    virtual ~HypergraphObserver() = default;
+
+    virtual void on_node_added(const Hypergraph&, NodeId) {}
+    virtual void on_node_removing(const Hypergraph&, NodeId) {}
+    virtual void on_edge_added(const Hypergraph&, EdgeId) {}
+    virtual void on_edge_removing(const Hypergraph&, EdgeId) {}
+    virtual void on_edge_updating(const Hypergraph&, EdgeId) {}
+    virtual void on_edge_updated(const Hypergraph&, EdgeId) {}
+    virtual void on_cleared(const Hypergraph&) {}
+    virtual void on_detached() {}
+};
+
 /**
  * @brief Main Hypergraph class implementing higher-order knowledge representation
  *
@@ -145,6 +402,8 @@ struct PathSearchResult {
  *
  * Key features:
  * - Directed hyperedges with multiple sources and targets
+ * - Interned integer storage: string IDs map to dense NodeId/EdgeId handles,
+ *   and all traversal runs on the integer topology
  * - Efficient node-to-edge indexing for fast traversal
  * - s-connected path finding (paths where adjacent edges share ≥s nodes)
  * - k-shortest path algorithms (Yen's algorithm adapted for hypergraphs)
@@ -152,7 +411,14 @@ struct PathSearchResult {
  * - Multiple export formats (JSON, DOT, incidence matrix)
  */
 class Hypergraph {
+    struct NodeSlot;
+    struct EdgeSlot;
+
 public:
+    using NodeView = LiveSlotView<NodeSlot, HyperNode>;
+    using EdgeView = LiveSlotView<EdgeSlot, HyperEdge>;
+    using IncidentEdgeView = HandleView<EdgeSlot, HyperEdge, EdgeId>;
+
     Hypergraph() = default;
 
     // ==========================================
@@ -178,6 +444,14 @@ public:
         const std::string& source_chunk_id = ""
     );
 
+    /**
+     * @brief Add many hyperedges, normalizing all of their node labels as one batch
+     * @return IDs of the added edges, in input order
+     *
+     * Equivalent to calling add_hyperedge() on each edge in turn.
+     */
+    std::vector<std::string> add_hyperedges(std::vector<HyperEdge> edges);
+
     /**
      * @brief Add or update a node
      */
@@ -195,12 +469,20 @@ public:
 
     /**
      * @brief Get a node by ID
+     *
+     * Returned pointers are invalidated by any later insertion.
      */
     const HyperNode* get_node(const std::string& node_id) const;
     HyperNode* get_node(const std::string& node_id);
 
     /**
      * @brief Get a hyperedge by ID
+     *
+     * The mutable overload may be used to edit the relation, properties and
+     * provenance. Sources and targets must not be changed through it; use
+     * merge_nodes() or remove/add instead so the integer topology stays in sync.
+     * Mutable access drops the persistent duplicate-signature index, which is
+     * rebuilt on next use.
      */
     const HyperEdge* get_hyperedge(const std::string& edge_id) const;
     HyperEdge* get_hyperedge(const std::string& edge_id);
@@ -220,6 +502,42 @@ public:
      */
     std::vector<HyperEdge> get_all_edges() const;
 
+    // ==========================================
+    // Zero-Copy Views
+    // ==========================================
+    //
+    // Views hand out const references into the graph's storage without
+    // allocating. They are invalidated by any insertion or removal.
+
+    /**
+     * @brief All live nodes, in insertion order
+     */
+    NodeView nodes_view() const;
+
+    /**
+     * @brief All live hyperedges, in insertion order
+     */
+    EdgeView edges_view() const;
+
+    /**
+     * @brief Hyperedges incident to a node (empty if the node does not exist)
+     */
+    IncidentEdgeView incident_view(const std::string& node_id) const;
+    IncidentEdgeView incident_view(NodeId id) const;
+
+    /**
+     * @brief Invoke fn(const HyperNode&) / fn(const HyperEdge&) for every live entry
+     */
+    template <typename Fn>
+    void for_each_node(Fn&& fn) const {
+        for (const auto& node : nodes_view()) fn(node);
+    }
+
+    template <typename Fn>
+    void for_each_edge(Fn&& fn) const {
+        for (const auto& edge : edges_view()) fn(edge);
+    }
+
     /**
      * @brief Check if a node exists
      */
@@ -230,6 +548,88 @@ public:
      */
     bool has_edge(const std::string& edge_id) const;
 
+    // ==========================================
+    // Integer-ID Access
+    // ==========================================
+
+    /**
+     * @brief Resolve a node ID (normalized internally) to its handle
+     * @return Handle, or INVALID_ID if the node does not exist
+     */
+    NodeId find_node_id(const std::string& node_id) const;
+
+    /**
+     * @brief Resolve an edge ID to its handle
+     * @return Handle, or INVALID_ID if the edge does not exist
+     */
+    EdgeId find_edge_id(const std::string& edge_id) const;
+
+    /**
+     * @brief Upper bound (exclusive) on node handles, including tombstones
+     *
+     * Suitable for sizing dense per-node arrays indexed by NodeId.
+     */
+    size_t node_id_bound() const { return node_slots_.size(); }
+
+    /**
+     * @brief Upper bound (exclusive) on edge handles, including tombstones
+     */
+    size_t edge_id_bound() const { return edge_slots_.size(); }
+
+    /**
+     * @brief Check whether a handle refers to a live node / edge
+     */
+    bool is_live_node(NodeId id) const {
+        return id < node_slots_.size() && node_slots_[id].alive;
+    }
+    bool is_live_edge(EdgeId id) const {
+        return id < edge_slots_.size() && edge_slots_[id].alive;
+    }
+
+    /**
+     * @brief Access a live node / edge by handle (unchecked)
+     */
+    const HyperNode& node_at(NodeId id) const { return node_slots_[id].node; }
+    const HyperEdge& edge_at(EdgeId id) const { return edge_slots_[id].edge; }
+
+    /**
+     * @brief Handles of the hyperedges incident to a node, in insertion order
+     */
+    const std::vector<EdgeId>& incident_edge_ids(NodeId id) const {
+        return node_slots_[id].edges;
+    }
+
+    /**
+     * @brief Distinct member nodes of a hyperedge, sorted ascending by handle
+     */
+    const std::vector<NodeId>& edge_node_ids(EdgeId id) const {
+        return edge_slots_[id].members;
+    }
+
+    /**
+     * @brief Source / target handles of a hyperedge, in declaration order
+     */
+    const std::vector<NodeId>& edge_source_ids(EdgeId id) const {
+        return edge_slots_[id].sources;
+    }
+    const std::vector<NodeId>& edge_target_ids(EdgeId id) const {
+        return edge_slots_[id].targets;
+    }
+
+    /**
+     * @brief Immutable CSR incidence for the current graph state
+     *
+     * Built on first use after a structural change and shared until the
+     * next one. The returned snapshot stays valid for its holder even if
+     * the graph is modified afterwards.
+     */
+    std::shared_ptr<const IncidenceCSR> incidence() const;
+
+    /**
+     * @brief Counter bumped by every structural mutation (nodes, edges, membership)
+     */
+    uint64_t generation() const { return generation_; }
+
     // ==========================================
     // Graph Operations
     // ==========================================
@@ -240,9 +640,24 @@ public:
      * @param merge_frequency How often to perform merging (every N documents)
      *
      * Implements the node merging algorithm from the paper (Algorithm 1, lines 19-35)
+     * with an exact, uncapped all-pairs comparison; pass an AnnConfig to
+     * use an approximate index instead.
      */
     void merge_similar_nodes(double similarity_threshold = 0.95);
 
+    /**
+     * @brief Merge similar nodes, finding candidate pairs through a VectorIndex
+     * @param similarity_threshold Cosine similarity threshold [0, 1]
+     * @param ann Index selection; AnnMethod::Exact reproduces the all-pairs scan
+     * @return Number of nodes merged away
+     *
+     * Each embedded node queries its threshold neighbours (at most
+     * ann.max_neighbors), and components of the resulting similarity graph
+     * are merged into their highest-degree member. Nodes are only compared
+     * with nodes whose embeddings have the same dimension.
+     */
+    size_t merge_similar_nodes(double similarity_threshold, const AnnConfig& ann);
+
     /**
      * @brief Merge two nodes (used in deduplication)
      */
@@ -256,6 +671,11 @@ public:
     /**
      * @brief Find duplicate hyperedges
      * @return Map of canonical edge ID to list of duplicate edge IDs
+     *
+     * Edges are duplicates when they share a canonical signature: the same
+     * relation, the same set of sources and the same set of targets. Edges
+     * are grouped by a hash of that signature in a single linear pass; the
+     * earliest inserted edge of each group is its canonical representative.
      */
     std::map<std::string, std::vector<std::string>> find_duplicate_edges() const;
 
@@ -282,9 +702,31 @@ public:
 
     /**
      * @brief Compute statistics about the hypergraph
+     *
+     * The full result is memoized against generation(), so repeated calls on
+     * an unchanged graph return the cached statistics.
      */
     HypergraphStatistics compute_statistics() const;
 
+    /**
+     * @brief Compute statistics at the given tier
+     *
+     * StatisticsTier::Cheap only fills counts, edge sizes and node degrees;
+     * it reads incrementally maintained counters and never scans the graph.
+     */
+    HypergraphStatistics compute_statistics(StatisticsTier tier) const;
+
+    /**
+     * @brief Compute statistics with explicit threading and sampling settings
+     *
+     * options.tier selects how much is computed; see StatisticsTier.
+     * Pairwise overlap counts come from the CSR incidence: each edge counts
+     * its co-incident edges through the node->edge lists, sharded across
+     * threads. Above options.overlap_sample_threshold edges the counts are
+     * estimated from a uniform edge sample and reported with 95% bounds.
+     */
+    HypergraphStatistics compute_statistics(const StatisticsOptions& options) const;
+
     // ==========================================
     // Path Finding Algorithms
     // ==========================================
@@ -297,7 +739,8 @@ public:
      * @return Path as sequence of hyperedges, or empty if no path exists
      *
      * Uses BFS to find shortest path where adjacent hyperedges share ≥s nodes.
-     * Implements the traversal algorithm from section 4.4 of the paper.
+     * Implements the traversal algorithm from section 4.4 of the paper,
+     * searching from both endpoints at once over integer edge handles.
      */
     std::vector<HyperEdge> find_shortest_path(
         const std::string& start,
@@ -311,15 +754,58 @@ public:
      * @param end Ending node ID
      * @param k Number of paths to find
      * @param min_intersection_size Minimum number of shared nodes (s parameter)
+     * @param max_hops Ignore paths longer than this many edges (0 = unbounded)
      * @return PathSearchResult containing up to k shortest paths
      *
-     * Adapts Yen's k-shortest paths algorithm to hypergraphs.
+     * Adapts Yen's k-shortest paths algorithm to hypergraphs: spurs branch at
+     * each edge of the previous path, candidates sit in a deduplicated heap,
+     * and only spur indices past a path's deviation point are re-searched.
      */
     PathSearchResult find_k_shortest_paths(
         const std::string& start,
         const std::string& end,
         int k = 3,
-        int min_intersection_size = 1
+        int min_intersection_size = 1,
+        size_t max_hops = 0
+    ) const;
+
+    /**
+     * @brief Shortest s-path lengths from one node to many targets
+     * @param start Starting node ID
+     * @param targets Target node IDs
+     * @param min_intersection_size Minimum number of shared nodes (s parameter)
+     * @param max_hops Stop after paths of this many edges (0 = unbounded)
+     * @return Per target, the edge count of its shortest path, or -1 if none
+     *
+     * Matches find_shortest_path(start, t).size() for every target, but runs
+     * a single bounded BFS sweep instead of one search per target.
+     */
+    std::vector<int> find_path_lengths(
+        const std::string& start,
+        const std::vector<std::string>& targets,
+        int min_intersection_size = 1,
+        size_t max_hops = 0
+    ) const;
+
+    /**
+     * @brief k shortest s-paths from one node to each of many targets
+     * @param start Starting node ID
+     * @param targets Target node IDs
+     * @param k Number of paths to find per target
+     * @param min_intersection_size Minimum number of shared nodes (s parameter)
+     * @param max_hops Ignore paths longer than this many edges (0 = unbounded)
+     * @return Per target, what find_k_shortest_paths(start, target) returns
+     *
+     * One bounded sweep from start yields every target's shortest path,
+     * which seeds Yen's algorithm directly; only the spur searches still
+     * run per target. Among equally short paths the sweep's pick may differ.
+     */
+    std::vector<PathSearchResult> find_k_shortest_paths_to(
+        const std::string& start,
+        const std::vector<std::string>& targets,
+        int k = 3,
+        int min_intersection_size = 1,
+        size_t max_hops = 0
     ) const;
 
     /**
@@ -333,6 +819,21 @@ public:
         int min_intersection_size = 1
     ) const;
 
+    /**
+     * @brief s-connected components for several s-values in one pass
+     * @param s_values Intersection thresholds, in any order (duplicates allowed)
+     * @param num_threads Workers for pair enumeration (0 = hardware concurrency)
+     * @return s -> components, each as find_s_connected_components(s) returns them
+     *
+     * Co-incident edge pairs are enumerated once, sharded across threads,
+     * with their overlap counts; each pair is unioned into the concurrent
+     * union-find of every requested s it satisfies.
+     */
+    std::map<int, std::vector<std::set<std::string>>> find_s_connected_components_multi(
+        const std::vector<int>& s_values,
+        size_t num_threads = 0
+    ) const;
+
     /**
      * @brief Get the h-hop neighborhood of a node
      * @param node_id Starting node
@@ -415,8 +916,18 @@ public:
 
     /**
      * @brief Export to JSON file
+     *
+     * Streams through JsonWriter, so no DOM is built. Metadata is written
+     * first and nodes before hyperedges, which lets load_from_json insert
+     * records as they arrive.
      */
-    void export_to_json(const std::string& filename, bool include_metadata = true) const;
+    void export_to_json(const std::string& filename, bool include_metadata = true,
+                        const JsonWriteOptions& options = {}) const;
+
+    /**
+     * @brief Stream the export_to_json() document to any output stream
+     */
+    void write_json(std::ostream& out, bool include_metadata = true, bool compact = false) const;
 
     /**
      * @brief Export to Graphviz DOT format for visualization
@@ -447,13 +958,60 @@ public:
 
     /**
      * @brief Load hypergraph from JSON
+     *
+     * IDs are re-normalized unless metadata.normalized is true, which
+     * to_json() always sets.
      */
     static Hypergraph from_json(const nlohmann::json& j);
 
     /**
-     * @brief Load hypergraph from JSON file
+     * @brief Load hypergraph from a JSON file (optionally gzip-compressed)
+     *        without building a DOM
+     *
+     * Nodes and hyperedges are built directly from SAX events, so peak
+     * memory is about the size of the resulting graph. The result equals
+     * from_json() on the parsed file: hyperedges that precede the "nodes"
+     * array are held back until it has been read so that declared node
+     * labels win. The metadata.normalized flag is honoured when it appears
+     * before the first node or hyperedge is inserted.
+     * @throws std::runtime_error on I/O errors, malformed JSON or missing fields
      */
-    static Hypergraph load_from_json(const std::string& filename);
+    static Hypergraph load_from_json(const std::string& filename,
+                                     const JsonLoadOptions& options = {});
+
+    /**
+     * @brief Streaming load from an already opened stream (see load_from_json)
+     */
+    static Hypergraph load_from_json_stream(std::istream& input,
+                                            const JsonLoadOptions& options = {});
+
+    /**
+     * @brief Write a binary snapshot (layout documented on GraphSnapshot)
+     *
+     * Tombstones are dropped, so handles in the snapshot are renumbered
+     * densely in insertion order.
+     */
+    void export_to_binary(const std::string& filename) const;
+
+    /**
+     * @brief Materialize a graph from a mapped snapshot
+     *
+     * Snapshot IDs are already normalized, so nodes and edges are placed
+     * straight into storage without re-normalizing or re-interning.
+     * @throws std::runtime_error if the snapshot fails validation
+     */
+    static Hypergraph from_snapshot(const GraphSnapshot& snapshot);
+
+    /**
+     * @brief Load hypergraph from a binary snapshot file
+     */
+    static Hypergraph load_from_binary(const std::string& filename);
+
+    /**
+     * @brief Load a hypergraph file in either format, detected from its leading bytes
+     * @param options Applied to JSON input only; snapshots always load in full
+     */
+    static Hypergraph load(const std::string& filename, const JsonLoadOptions& options = {});
 
     // ==========================================
     // Merge Operations
@@ -462,11 +1020,17 @@ public:
     /**
      * @brief Merge another hypergraph into this one
      * @param other The hypergraph to merge
-     * @param deduplicate Whether to deduplicate nodes and edges after merge
+     * @param deduplicate Whether to drop duplicate edges and self-loops
+     * @return Counts of merged, duplicate and self-loop edges
      *
-     * Implements the incremental merge operation from Algorithm 1 (lines 14-17)
+     * Implements the incremental merge operation from Algorithm 1 (lines 14-17).
+     * With deduplication, incoming edges are streamed through the persistent
+     * signature index, so each edge costs O(1) regardless of graph size. The
+     * destination itself is swept for duplicates and self-loops only when the
+     * index has to be (re)built. Incoming edges whose ID is already taken are
+     * given a fresh ID rather than replacing the existing edge.
      */
-    void merge(const Hypergraph& other, bool deduplicate = true);
+    MergeResult merge(const Hypergraph& other, bool deduplicate = true);
 
     // ==========================================
     // Utility Methods
@@ -475,23 +1039,32 @@ public:
     /**
      * @brief Get total number of nodes
      */
-    size_t num_nodes() const { return nodes_.size(); }
+    size_t num_nodes() const { return live_nodes_; }
 
     /**
      * @brief Get total number of hyperedges
      */
-    size_t num_edges() const { return hyperedges_.size(); }
+    size_t num_edges() const { return live_edges_; }
 
     /**
      * @brief Check if hypergraph is empty
      */
-    bool empty() const { return nodes_.empty() && hyperedges_.empty(); }
+    bool empty() const { return live_nodes_ == 0 && live_edges_ == 0; }
 
     /**
      * @brief Clear all nodes and edges
      */
     void clear();
 
+    /**
+     * @brief Report structural mutations to an observer until it is removed
+     *
+     * Registering the same observer twice has no effect. Mutations must not
+     * run concurrently with each other, so neither do observer callbacks.
+     */
+    void add_observer(HypergraphObserver* observer);
+    void remove_observer(HypergraphObserver* observer);
+
     /**
      * @brief Generate a unique edge ID
      */
@@ -513,14 +1086,120 @@ public:
      */
     static std::string normalize_node_id(const std::string& label);
 
+    /**
+     * @brief Normalize into a caller-owned buffer, reusing its capacity
+     *
+     * Same result as the overload above. ASCII is trimmed, lowercased and
+     * singularized in place without locale calls, so once the buffer is
+     * large enough nothing is allocated.
+     */
+    static void normalize_node_id(std::string_view label, std::string& out);
+
+    /**
+     * @brief Normalize a batch of labels, in input order
+     * @param num_threads Workers for large batches (0 = default_thread_count())
+     */
+    static std::vector<std::string> normalize_node_ids(const std::vector<std::string>& labels,
+                                                       size_t num_threads = 0);
+
 private:
     // ==========================================
     // Internal Data Structures
     // ==========================================
 
-    std::map<std::string, HyperNode> nodes_;           // node_id -> node
-    std::map<std::string, HyperEdge> hyperedges_;      // edge_id -> hyperedge
-    std::map<std::string, std::vector<std::string>> node_to_edges_;  // node_id -> [edge_ids]
+    struct NodeSlot {
+        HyperNode node;
+        std::vector<EdgeId> edges;                     // Incident edge handles
+        bool alive = false;
+
+        const HyperNode& value() const { return node; }
+    };
+
+    struct EdgeSlot {
+        HyperEdge edge;
+        std::vector<NodeId> sources;                   // Parallel to edge.sources
+        std::vector<NodeId> targets;                   // Parallel to edge.targets
+        std::vector<NodeId> members;                   // Sorted, distinct sources ∪ targets
+        bool alive = false;
+
+        const HyperEdge& value() const { return edge; }
+    };
+
+    std::vector<NodeSlot> node_slots_;                 // NodeId -> slot
+    std::vector<EdgeSlot> edge_slots_;                 // EdgeId -> slot
+    std::unordered_map<std::string, NodeId> node_lookup_;  // normalized node_id -> handle
+    std::unordered_map<std::string, EdgeId> edge_lookup_;  // edge_id -> handle
+    size_t live_nodes_ = 0;
+    size_t live_edges_ = 0;
+    uint64_t generation_ = 0;
+
+    // Counters behind the cheap statistics tier, kept current on every add
+    // and remove: edge_size_counts_[k] live edges of size k, degree_counts_[d]
+    // live nodes of degree d
+    std::vector<size_t> edge_size_counts_;
+    std::vector<size_t> degree_counts_;
+    size_t total_edge_size_ = 0;
+    size_t total_degree_ = 0;
+
+    // Persistent duplicate index: signature hash -> edges with that hash.
+    // Maintained by add/remove once built; dropped on mutable edge access.
+    std::unordered_map<uint64_t, std::vector<EdgeId>> signature_index_;
+    bool signature_index_valid_ = false;
+
+    /**
+     * @brief Structures derived from the graph, rebuilt when the generation moves
+     *
+     * Copies start empty so a copied graph never shares or races on caches.
+     */
+    struct DerivedCache {
+        std::mutex mutex;
+        uint64_t incidence_generation = 0;
+        std::shared_ptr<const IncidenceCSR> incidence;
+        uint64_t statistics_generation = 0;
+        StatisticsOptions statistics_options;          // Sampling settings the memo was built with
+        std::shared_ptr<const HypergraphStatistics> statistics;
+
+        DerivedCache() = default;
+        DerivedCache(const DerivedCache&) {}
+        DerivedCache& operator=(const DerivedCache&) {
+            incidence.reset();
+            statistics.reset();
+            return *this;
+        }
+    };
+
+    mutable DerivedCache cache_;
+
+    /**
+     * @brief Registered observers; copies and moves start empty
+     *
+     * Destruction or assignment detaches the current observers, since the
+     * graph they were following no longer exists.
+     */
+    struct ObserverList {
+        std::vector<HypergraphObserver*> observers;
+
+        ObserverList() = default;
+        ObserverList(const ObserverList&) {}
+        ObserverList& operator=(const ObserverList&) {
+            detach_all();
+            return *this;
+        }
+        ~ObserverList() { detach_all(); }
+
+        void detach_all() {
+            auto detached = std::move(observers);
+            observers.clear();
+            for (auto* observer : detached) observer->on_detached();
+        }
+
+        template <typename Fn>
+        void notify(Fn&& fn) const {
+            for (auto* observer : observers) fn(*observer);
+        }
+    };
+
+    ObserverList observers_;
 
     // Counter for generating unique IDs
     static inline size_t edge_id_counter_ = 0;
@@ -529,48 +1208,195 @@ private:
     // Internal Helper Methods
     // ==========================================
 
+    /**
+     * @brief Return the handle for a normalized node ID, creating the node if needed
+     */
+    NodeId intern_node(const std::string& normalized_id, const std::string& label);
+
+    /**
+     * @brief add_hyperedge / add_node taking ownership; with normalized set,
+     *        node IDs are used verbatim instead of passing through normalize_node_id
+     */
+    std::string insert_hyperedge(HyperEdge edge, bool normalized);
+    void insert_node(HyperNode node, bool normalized);
+
+    /**
+     * @brief Remove a live node and its incident edges by handle
+     */
+    void remove_node_at(NodeId id);
+
     /**
      * @brief Update internal indices after adding an edge
      */
-    void update_indices(const HyperEdge& edge);
+    void update_indices(EdgeId edge_id);
 
     /**
      * @brief Remove edge from internal indices
      */
-    void remove_from_indices(const std::string& edge_id);
+    void remove_from_indices(EdgeId edge_id);
 
     /**
-     * @brief Check if two hyperedges are duplicates
+     * @brief Rebuild the sorted member list of an edge from its sources/targets
      */
-    bool are_duplicate_edges(const HyperEdge& e1, const HyperEdge& e2) const;
+    void rebuild_members(EdgeSlot& slot) const;
 
     /**
-     * @brief BFS helper for path finding
+     * @brief Canonical duplicate-detection key of a hyperedge
+     *
+     * Relation plus the sorted, distinct source and target handles. Two
+     * edges are duplicates iff their signatures compare equal.
      */
-    std::vector<HyperEdge> bfs_path_search(
-        const std::string& start,
-        const std::string& end,
+    struct EdgeSignature {
+        const std::string* relation = nullptr;
+        std::vector<NodeId> sources;
+        std::vector<NodeId> targets;
+        uint64_t hash = 0;
+
+        bool operator==(const EdgeSignature& other) const {
+            return hash == other.hash && *relation == *other.relation &&
+                   sources == other.sources && targets == other.targets;
+        }
+    };
+
+    /**
+     * @brief Build the signature of a live edge / of explicit handle lists
+     */
+    EdgeSignature signature_of(EdgeId edge_id) const;
+    static EdgeSignature make_signature(
+        const std::string& relation,
+        std::vector<NodeId> sources,
+        std::vector<NodeId> targets
+    );
+
+    /**
+     * @brief Build the persistent signature index if it is not current
+     */
+    void ensure_signature_index();
+
+    /**
+     * @brief Add / remove a live edge in the persistent signature index (if built)
+     */
+    void index_signature(EdgeId edge_id);
+    void unindex_signature(EdgeId edge_id);
+
+    /**
+     * @brief Look up an existing edge with the given signature
+     * @return Handle of the earliest matching edge, or INVALID_ID
+     */
+    EdgeId find_signature(const EdgeSignature& signature) const;
+
+    /**
+     * @brief Bidirectional s-path search over edge handles
+     * @param seeds Edges the path may start with
+     * @param end Node the last edge of the path must contain
+     * @param max_hops Longest path to accept, in edges (0 = unbounded)
+     * @param banned Edges the path may not use
+     * @return Edge handles from a seed to an edge containing end, or empty
+     *
+     * Level-synchronous BFS from both ends at once, always expanding the
+     * smaller frontier. Visit marks are epoch-stamped in thread-local
+     * scratch, so a query only pays for the part of the graph it touches.
+     */
+    static std::vector<EdgeId> s_path_search(
+        const IncidenceCSR& csr,
+        IdSpan<EdgeId> seeds,
+        NodeId end,
         int min_intersection_size,
-        const std::set<std::string>& excluded_edges = {}
-    ) const;
+        size_t max_hops = 0,
+        const std::vector<EdgeId>& banned = {}
+    );
+
+    /**
+     * @brief One BFS sweep from start towards many targets
+     * @return Per target, the first edge reached that contains it, or INVALID_ID
+     *
+     * Parents and depths stay in the calling thread's search scratch until
+     * its next search, so paths can be walked back from the returned edges.
+     */
+    static std::vector<EdgeId> s_path_sweep(
+        const IncidenceCSR& csr,
+        NodeId start,
+        const std::vector<NodeId>& targets,
+        int min_intersection_size,
+        size_t max_hops
+    );
 
     /**
-     * @brief Check if two hyperedges share at least s nodes
+     * @brief Yen's algorithm from a known shortest path (empty = none)
      */
-    bool are_s_connected(
-        const HyperEdge& e1,
-        const HyperEdge& e2,
-        int min_intersection_size
+    PathSearchResult k_shortest_from(
+        const IncidenceCSR& csr,
+        NodeId start,
+        NodeId end,
+        std::vector<EdgeId> shortest,
+        int k,
+        int min_intersection_size,
+        size_t max_hops
     ) const;
 
     /**
-     * @brief Get all hyperedges that are s-connected to a given edge
+     * @brief Number of nodes shared by two hyperedges
+     */
+    size_t edge_overlap(EdgeId e1, EdgeId e2) const;
+
+    /**
+     * @brief Statistics derivable from the incremental counters alone
+     */
+    HypergraphStatistics cheap_statistics() const;
+
+    /**
+     * @brief Move one node between degree buckets of the cheap counters
+     */
+    void move_degree(size_t from, size_t to);
+
+    /**
+     * @brief Fill the pairwise overlap fields of stats (exact or sampled)
      */
-    std::vector<std::string> get_s_connected_neighbors(
-        const std::string& edge_id,
-        int min_intersection_size
+    void compute_overlap_statistics(
+        HypergraphStatistics& stats,
+        const StatisticsOptions& options
     ) const;
 
+    /**
+     * @brief Build the CSR incidence from the current slots
+     */
+    std::shared_ptr<const IncidenceCSR> build_incidence() const;
+
+    /**
+     * @brief Visit every edge co-incident with edge_id with its shared-node count
+     * @param only_higher Skip partners with a smaller handle, so that looping
+     *        over all edges visits each pair exactly once
+     * @param overlap Scratch counters sized to csr.num_edge_rows(), all zero on entry and exit
+     * @param touched Scratch list, overwritten
+     * @param visit Called as visit(partner, shared)
+     */
+    template <typename Visit>
+    static void for_each_overlap(
+        const IncidenceCSR& csr,
+        EdgeId edge_id,
+        bool only_higher,
+        std::vector<uint32_t>& overlap,
+        std::vector<EdgeId>& touched,
+        Visit&& visit
+    ) {
+        // Each co-incident edge is counted once per shared node; the first
+        // touch records it as a candidate
+        touched.clear();
+        for (NodeId node_id : csr.nodes_of(edge_id)) {
+            for (EdgeId other : csr.edges_of(node_id)) {
+                if (other == edge_id || (only_higher && other < edge_id)) continue;
+                if (overlap[other]++ == 0) {
+                    touched.push_back(other);
+                }
+            }
+        }
+        for (EdgeId other : touched) {
+            uint32_t shared = overlap[other];
+            overlap[other] = 0;
+            visit(other, shared);
+        }
+    }
+
     /**
      * @brief Find connected components in similarity graph
      */
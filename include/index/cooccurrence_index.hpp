@@ -0,0 +1,146 @@
+#pragma once
+
+#include "graph/hypergraph.hpp"
+#include "util/section_file.hpp"
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace kg {
+
+/**
+ * @brief Entity co-occurrence counts as sorted per-entity adjacency
+ *
+ * Entities are the graph's nodes numbered densely in ID order. Row e of
+ * the CSR lists every entity sharing at least one hyperedge with e
+ * (sources and targets combined), in ascending order, with the number of
+ * such co-occurrences alongside; each pair is stored in both rows. So
+ * count() is a binary search in one row, O(log deg) and allocation-free,
+ * and partners of an entity are a contiguous slice.
+ *
+ * The arrays are either owned (build(), from_pairs()) and shared between
+ * copies, or views into a mapped HypergraphIndex file, valid while that
+ * index is alive.
+ */
+class CooccurrenceIndex {
+public:
+    using Entity = uint32_t;
+    static constexpr Entity NO_ENTITY = INVALID_ID;
+
+    /**
+     * @brief Pending changes for updated(), accumulated by ID
+     */
+    struct Update {
+        std::set<std::string> added;                   // New entities
+        std::set<std::string> removed;                 // Dropped with any pairs left
+        std::map<std::pair<std::string, std::string>, int> deltas;  // (min, max) -> count change
+
+        bool empty() const { return added.empty() && removed.empty() && deltas.empty(); }
+
+        /**
+         * @brief Count every pair of one hyperedge's members (sources then targets) by delta
+         */
+        void add_edge(const std::vector<std::string_view>& members, int delta);
+    };
+
+    CooccurrenceIndex() = default;
+
+    /**
+     * @brief Count pairwise co-occurrences in every hyperedge
+     * @param num_threads Workers for the pair scan (0 = default_thread_count())
+     */
+    static CooccurrenceIndex build(const Hypergraph& graph, size_t num_threads = 0);
+
+    /**
+     * @brief Build from explicit (id, id, count) triples; repeated pairs are summed
+     */
+    static CooccurrenceIndex from_pairs(const std::vector<std::tuple<std::string, std::string, int>>& pairs);
+
+    /**
+     * @brief View over serialized arrays (see HypergraphIndex::save_to_binary)
+     * @param entity_strings Entity -> index into strings, ascending; strings must be sorted
+     * @throws std::runtime_error via file.corrupt() if the arrays are inconsistent
+     */
+    static CooccurrenceIndex from_sections(const SectionFile& file, StringTableView strings,
+                                           ArrayView<uint32_t> entity_strings, ArrayView<uint64_t> offsets,
+                                           ArrayView<uint32_t> partners, ArrayView<int32_t> counts);
+
+    /**
+     * @brief A copy with the update applied, in one merge over the existing pairs
+     *
+     * Entities are renumbered to stay in ID order, and pairs whose count
+     * drops to zero or below are dropped. The result always owns its arrays.
+     */
+    CooccurrenceIndex updated(const Update& update) const;
+
+    size_t num_entities() const { return offsets_.empty() ? 0 : offsets_.size - 1; }
+    size_t num_pairs() const { return num_pairs_; }
+
+    /**
+     * @brief Entity with exactly this ID (no normalization), or NO_ENTITY
+     */
+    Entity find(std::string_view id) const;
+
+    std::string_view name(Entity e) const {
+        return strings_[entity_strings_.empty() ? e : entity_strings_[e]];
+    }
+
+    /**
+     * @brief Co-occurrence count of a pair; 0 for NO_ENTITY or unrelated entities
+     */
+    int count(Entity a, Entity b) const;
+
+    IdSpan<Entity> partners(Entity e) const {
+        return {partners_.data + offsets_[e], partners_.data + offsets_[e + 1]};
+    }
+    IdSpan<int32_t> counts(Entity e) const {
+        return {counts_.data + offsets_[e], counts_.data + offsets_[e + 1]};
+    }
+
+    /**
+     * @brief The k partners with the highest counts (ties by entity order)
+     */
+    std::vector<std::pair<Entity, int>> top_partners(Entity e, size_t k) const;
+
+    /**
+     * @brief Visit every unordered pair once as fn(a, b, count) with a <= b
+     */
+    template <typename Fn>
+    void for_each_pair(Fn&& fn) const {
+        for (Entity a = 0; a < num_entities(); ++a) {
+            for (uint64_t i = offsets_[a]; i < offsets_[a + 1]; ++i) {
+                if (partners_[i] >= a) fn(a, partners_[i], counts_[i]);
+            }
+        }
+    }
+
+    // Raw arrays, for serialization
+    const ArrayView<uint64_t>& offset_array() const { return offsets_; }
+    const ArrayView<uint32_t>& partner_array() const { return partners_; }
+    const ArrayView<int32_t>& count_array() const { return counts_; }
+
+private:
+    struct Data;
+
+    /**
+     * Symmetric CSR from pairs sorted by (a, b) with a <= b
+     */
+    static CooccurrenceIndex from_sorted(std::vector<std::string> names,
+                                         const std::vector<std::pair<uint64_t, int32_t>>& pairs);
+
+    std::shared_ptr<const Data> data_;                 // Owner of the arrays when not mapped
+    StringTableView strings_;
+    ArrayView<uint32_t> entity_strings_;               // Empty: entity e is string e
+    ArrayView<uint64_t> offsets_;                      // num_entities() + 1 entries
+    ArrayView<uint32_t> partners_;
+    ArrayView<int32_t> counts_;
+    size_t num_pairs_ = 0;
+};
+
+} // namespace kg
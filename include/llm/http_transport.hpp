@@ -0,0 +1,136 @@
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace kg {
+
+// ============================================================================
+// Async HTTP Transport
+// ============================================================================
+
+/**
+ * @brief One HTTP POST
+ */
+struct HttpRequest {
+    std::string url;
+    std::string body;
+    std::vector<std::string> headers;   ///< "Name: value" lines
+    int timeout_seconds = 60;
+};
+
+/**
+ * @brief Outcome of an HttpRequest
+ */
+struct HttpResponse {
+    long status = 0;                    ///< HTTP status, 0 when no response arrived
+    std::string body;
+    std::string error;                  ///< Transport failure, empty when a response arrived
+    std::string retry_after;            ///< Retry-After header, if sent
+    std::string retry_after_ms;         ///< retry-after-ms header (OpenAI), if sent
+
+    bool ok() const { return error.empty() && status >= 200 && status < 300; }
+};
+
+/**
+ * @brief HTTP client running any number of requests on one event-loop thread
+ *
+ * Built on a curl multi handle: connections stay open in its cache and are
+ * reused by later requests to the same host, and HTTPS requests negotiate
+ * HTTP/2 so concurrent requests to a host share one connection instead of
+ * each paying a TCP and TLS handshake. Finished easy handles are reset and
+ * reused.
+ *
+ * Completion callbacks and scheduled tasks run on the loop thread, so they
+ * must be short and must not wait on other requests of the same transport.
+ * All methods are thread-safe. Destroying the transport fails the requests
+ * still pending with an error and runs the scheduled tasks still waiting
+ * with cancelled set.
+ */
+class HttpTransport {
+public:
+    using Clock = std::chrono::steady_clock;
+    using Callback = std::function<void(HttpResponse)>;
+    using Task = std::function<void(bool cancelled)>;
+
+    struct Options {
+        long max_host_connections = 8;  ///< Connections per host (HTTP/2 multiplexes over them)
+        long max_cached_connections = 32; ///< Idle connections kept for reuse
+        bool http2 = true;              ///< Negotiate HTTP/2 over TLS
+    };
+
+    explicit HttpTransport(const Options& options);
+    HttpTransport();
+    ~HttpTransport();
+
+    HttpTransport(const HttpTransport&) = delete;
+    HttpTransport& operator=(const HttpTransport&) = delete;
+
+    /**
+     * @brief Start a POST; on_done runs on the loop thread when it finishes
+     */
+    void post(HttpRequest request, Callback on_done);
+
+    /**
+     * @brief Start a POST and return its eventual response
+     */
+    std::future<HttpResponse> post(HttpRequest request);
+
+    /**
+     * @brief Run task(false) on the loop thread at (or shortly after) when
+     *
+     * If the transport shuts down first, or already has, task(true) runs
+     * instead, so work waiting on a timer can still report its failure.
+     */
+    void schedule(Clock::time_point when, Task task);
+
+    /**
+     * @brief Requests submitted and not yet completed
+     */
+    size_t pending() const;
+
+    /**
+     * @brief Whether the caller is this transport's loop thread
+     *
+     * Code that may run in a callback checks this before blocking on a
+     * request, which could never complete while the loop waits for it.
+     */
+    bool on_loop_thread() const;
+
+    /**
+     * @brief Process-wide transport used by the LLM providers
+     */
+    static HttpTransport& shared();
+
+private:
+    struct Transfer;
+
+    Options options_;
+    void* multi_ = nullptr;             ///< CURLM*, kept out of this header
+
+    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<Transfer>> submitted_;
+    std::multimap<Clock::time_point, Task> timers_;
+    size_t pending_ = 0;
+    bool stopping_ = false;
+
+    // Loop thread only
+    std::map<void*, std::unique_ptr<Transfer>> running_;
+    std::vector<void*> idle_handles_;
+
+    std::thread loop_;
+
+    void run();
+    void start_transfer(std::unique_ptr<Transfer> transfer);
+    void finish_transfer(void* handle, int result);
+    void wake();
+};
+
+} // namespace kg
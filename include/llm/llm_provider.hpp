@@ -1,11 +1,15 @@
 #pragma once
 
+#include "llm/rate_limiter.hpp"
+#include "llm/http_transport.hpp"
+#include "llm/response_cache.hpp"
 #include <string>
 #include <vector>
 #include <map>
 #include <memory>
 #include <optional>
 #include <functional>
+#include <future>
 
 namespace kg {
 
@@ -24,6 +28,9 @@ struct LLMConfig {
     int max_tokens = 2000;                  ///< Maximum tokens in response
     int timeout_seconds = 60;               ///< Request timeout
     int max_retries = 3;                    ///< Max retry attempts on failure
+    int requests_per_minute = 0;            ///< Shared request budget (0 = unlimited)
+    int tokens_per_minute = 0;              ///< Shared token budget (0 = unlimited)
+    std::string cache_directory;            ///< On-disk response cache (empty = none)
     bool verbose = false;                   ///< Enable verbose logging
 
     // Additional parameters
@@ -120,14 +127,39 @@ public:
     /**
      * @brief Chat completion with message history
      *
+     * Blocks until the reply arrives. OpenAI and Gemini fail at once when
+     * called from an on_done callback, since the reply could never arrive
+     * while the transport's loop thread waits for it.
+     *
      * @param messages Conversation messages
      * @return LLM response
      */
     virtual LLMResponse chat(const std::vector<Message>& messages) = 0;
 
+    /**
+     * @brief Start a chat completion; on_done receives the response
+     *
+     * OpenAI and Gemini send through HttpTransport::shared(), so any number
+     * of calls can be in flight while on_done runs on its loop thread (keep
+     * it short). The default completes chat() before returning. The provider
+     * must outlive its pending calls.
+     */
+    virtual void chat_async(
+        const std::vector<Message>& messages,
+        std::function<void(LLMResponse)> on_done
+    );
+
+    /**
+     * @brief Start a chat completion and return its eventual response
+     */
+    std::future<LLMResponse> chat_async(const std::vector<Message>& messages);
+
     /**
      * @brief Extract relations from text
      *
+     * Safe to call from several threads at once: calls share the HTTP
+     * transport and only read the configuration.
+     *
      * @param text Input text to extract from
      * @param chunk_id Identifier for the text chunk
      * @param system_prompt Optional system prompt override
@@ -139,6 +171,31 @@ public:
         const std::string& system_prompt = ""
     ) = 0;
 
+    /**
+     * @brief Start relation extraction with the default prompts over chat_async()
+     *
+     * @param text Input text to extract from
+     * @param chunk_id Identifier for the text chunk
+     * @param system_prompt Optional system prompt override
+     * @return Eventual extraction result
+     */
+    std::future<ExtractionResult> extract_relations_async(
+        const std::string& text,
+        const std::string& chunk_id = "",
+        const std::string& system_prompt = ""
+    );
+
+    /**
+     * @brief Key of the extraction request for text
+     *
+     * Hashes the provider, model, generation parameters and both prompts
+     * with ResponseCache::make_key, so it changes whenever the reply could.
+     */
+    std::string extraction_key(
+        const std::string& text,
+        const std::string& system_prompt = ""
+    ) const;
+
     /**
      * @brief Batch extraction from multiple texts
      *
@@ -178,8 +235,32 @@ public:
      */
     virtual LLMConfig get_config() const = 0;
 
+    /**
+     * @brief Draw this provider's calls from a (possibly shared) budget
+     *
+     * Providers made by LLMProviderFactory share RateLimiter::shared() for
+     * their provider and model; without a limiter calls are unthrottled and
+     * only back off after failures.
+     */
+    void set_rate_limiter(std::shared_ptr<RateLimiter> limiter) { rate_limiter_ = std::move(limiter); }
+
+    std::shared_ptr<RateLimiter> get_rate_limiter() const { return rate_limiter_; }
+
+    /**
+     * @brief Answer repeated requests from a response cache
+     *
+     * A cached response is returned without a request or rate-limit budget
+     * and carries metadata["cache"] = "hit"; with a cache set, every other
+     * response carries "miss" and successful ones are stored.
+     */
+    void set_response_cache(std::shared_ptr<ResponseCache> cache) { response_cache_ = std::move(cache); }
+
+    std::shared_ptr<ResponseCache> get_response_cache() const { return response_cache_; }
+
 protected:
     LLMConfig config_;
+    std::shared_ptr<RateLimiter> rate_limiter_;
+    std::shared_ptr<ResponseCache> response_cache_;
 
     /**
      * @brief Parse JSON response into extracted relations
@@ -189,10 +270,39 @@ protected:
     ) const;
 
     /**
-     * @brief Retry logic for API calls
+     * @brief Messages for relation extraction (system prompt, then the text)
+     */
+    std::vector<Message> extraction_messages(
+        const std::string& text,
+        const std::string& system_prompt
+    ) const;
+
+    /**
+     * @brief Store the LLM response in result and parse its relations
+     *
+     * A reply whose relations do not parse is erased from the response
+     * cache, so the next attempt asks the LLM again.
      */
-    template<typename Func>
-    LLMResponse retry_call(Func&& func, const std::string& operation_name);
+    void finish_extraction(ExtractionResult& result, LLMResponse llm_response) const;
+
+    /**
+     * @brief Send a request through the shared transport with rate limiting and retries
+     *
+     * The response cache, if any, is consulted first, keyed by provider,
+     * model and request body; the key is passed on in the response's
+     * "cache_key" metadata. Each attempt first takes the estimated tokens
+     * from the rate limiter. Throttled and server errors are retried after
+     * the server's Retry-After (a 429 pauses every caller of the limiter)
+     * or a jittered exponential backoff; other client errors fail at once.
+     * parse turns a successful body into the response passed to on_done.
+     */
+    void send_async(
+        HttpRequest request,
+        int estimated_tokens,
+        const std::string& operation_name,
+        std::function<LLMResponse(const std::string&)> parse,
+        std::function<void(LLMResponse)> on_done
+    );
 };
 
 // ============================================================================
@@ -218,6 +328,12 @@ public:
     LLMResponse complete(const std::string& prompt) override;
     LLMResponse chat(const std::vector<Message>& messages) override;
 
+    using LLMProvider::chat_async;
+    void chat_async(
+        const std::vector<Message>& messages,
+        std::function<void(LLMResponse)> on_done
+    ) override;
+
     ExtractionResult extract_relations(
         const std::string& text,
         const std::string& chunk_id = "",
@@ -232,12 +348,12 @@ public:
 
 private:
     /**
-     * @brief Make HTTP POST request to OpenAI API
+     * @brief Build the HTTP POST request for an OpenAI API endpoint
      */
-    std::string make_request(
+    HttpRequest make_request(
         const std::string& endpoint,
         const std::string& json_payload
-    );
+    ) const;
 
     /**
      * @brief Build JSON payload for chat completion
@@ -273,6 +389,12 @@ public:
     LLMResponse complete(const std::string& prompt) override;
     LLMResponse chat(const std::vector<Message>& messages) override;
 
+    using LLMProvider::chat_async;
+    void chat_async(
+        const std::vector<Message>& messages,
+        std::function<void(LLMResponse)> on_done
+    ) override;
+
     ExtractionResult extract_relations(
         const std::string& text,
         const std::string& chunk_id = "",
@@ -287,12 +409,12 @@ public:
 
 private:
     /**
-     * @brief Make HTTP POST request to Gemini API
+     * @brief Build the HTTP POST request for a Gemini API endpoint
      */
-    std::string make_request(
+    HttpRequest make_request(
         const std::string& endpoint,
         const std::string& json_payload
-    );
+    ) const;
 
     /**
      * @brief Build JSON payload for Gemini API
@@ -322,6 +444,11 @@ public:
     /**
      * @brief Create LLM provider from type
      *
+     * The provider takes the whole config (keeping its default API base URL
+     * when none is given) and the shared rate limiter for its provider and
+     * model. Nonzero budgets in the config replace that limiter's budgets.
+     * A cache_directory attaches a ResponseCache there.
+     *
      * @param type Provider type
      * @param config Configuration
      * @return Unique pointer to provider
@@ -372,7 +499,10 @@ public:
      *   "api_key": "your-key",
      *   "model": "gpt-4" or "gemini-1.5-flash",
      *   "temperature": 0.0,
-     *   "max_tokens": 2000
+     *   "max_tokens": 2000,
+     *   "requests_per_minute": 500,   (optional, shared budget)
+     *   "tokens_per_minute": 30000,   (optional, shared budget)
+     *   "cache_directory": ".kg_cache/llm"  (optional response cache)
      * }
      *
      * @param config_path Optional path to config file
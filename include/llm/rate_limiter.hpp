@@ -0,0 +1,115 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace kg {
+
+struct Message;
+
+// ============================================================================
+// Rate Limiter
+// ============================================================================
+
+/**
+ * @brief Requests-per-minute and tokens-per-minute budget shared by LLM calls
+ *
+ * Two token buckets, each holding up to one minute of budget and refilling
+ * continuously. A call takes one request and its estimated tokens before it
+ * is sent, and reconcile() corrects the token bucket with the usage the
+ * provider reports, so underestimates show up as debt that later calls wait
+ * out. A zero budget is unlimited. A newly limited bucket starts with one
+ * second of budget rather than a full minute, so the first calls are spaced
+ * at the refill rate instead of arriving as one burst.
+ *
+ * A throttled response pauses every caller (pause_for()) and empties both
+ * buckets, so work resumes at the refill rate instead of in a burst.
+ * All methods are thread-safe.
+ */
+class RateLimiter {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit RateLimiter(int requests_per_minute = 0, int tokens_per_minute = 0);
+
+    /**
+     * @brief Change the budgets; limited buckets keep their current fill
+     */
+    void set_limits(int requests_per_minute, int tokens_per_minute);
+
+    int requests_per_minute() const;
+    int tokens_per_minute() const;
+
+    /**
+     * @brief Block until one request and the estimated tokens are available, then take them
+     *
+     * Estimates above the whole token budget wait for a full bucket instead of forever.
+     */
+    void acquire(int estimated_tokens);
+
+    /**
+     * @brief Non-blocking acquire(): take the budget and return zero, or return how long to wait
+     *
+     * Nothing is taken when the returned wait is nonzero; try again after it.
+     */
+    Clock::duration try_acquire(int estimated_tokens);
+
+    /**
+     * @brief Charge the difference between a call's actual and estimated tokens
+     *
+     * Calls that report no usage (actual_tokens <= 0) keep their estimate.
+     */
+    void reconcile(int estimated_tokens, int actual_tokens);
+
+    /**
+     * @brief Hold every caller for at least delay from now and empty the buckets
+     */
+    void pause_for(std::chrono::milliseconds delay);
+
+    /**
+     * @brief Rough token count of a request: prompt characters / 4 plus the completion limit
+     *
+     * Providers charge the completion limit against the budget when the
+     * request is admitted, so it is part of the estimate.
+     */
+    static int estimate_tokens(const std::vector<Message>& messages, int max_completion_tokens);
+
+    /**
+     * @brief Exponential backoff with full jitter: uniform in [0, min(cap, base * 2^(attempt-1))]
+     */
+    static std::chrono::milliseconds backoff_delay(
+        int attempt,
+        std::chrono::milliseconds base = std::chrono::milliseconds(1000),
+        std::chrono::milliseconds cap = std::chrono::milliseconds(60000)
+    );
+
+    /**
+     * @brief Add up to 10% (at most one second) of random delay so paused callers do not retry in step
+     */
+    static std::chrono::milliseconds with_jitter(std::chrono::milliseconds delay);
+
+    /**
+     * @brief Process-wide limiter for a key (e.g. "openai/gpt-4"), created unlimited on first use
+     */
+    static std::shared_ptr<RateLimiter> shared(const std::string& key);
+
+private:
+    mutable std::mutex mutex_;
+    std::condition_variable changed_;
+
+    int requests_per_minute_ = 0;
+    int tokens_per_minute_ = 0;
+    double requests_available_ = 0.0;
+    double tokens_available_ = 0.0;
+    Clock::time_point last_refill_;
+    Clock::time_point paused_until_;
+
+    void refill(Clock::time_point now);
+    Clock::duration take_or_wait(int estimated_tokens, Clock::time_point now);
+};
+
+} // namespace kg
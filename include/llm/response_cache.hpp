@@ -0,0 +1,111 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+namespace kg {
+
+struct LLMResponse;
+
+// ============================================================================
+// Response Cache
+// ============================================================================
+
+/**
+ * @brief Persistent, content-addressed store of successful LLM responses
+ *
+ * Entries are keyed by the SHA-256 of the provider, model and request
+ * payload, which holds the system and user prompts and the generation
+ * parameters, so any change to them is a different entry. Each entry is a
+ * small JSON file under a two-hex-digit shard directory
+ * (<directory>/ab/abcd...json), written to a temporary file and renamed, so
+ * several processes can share a directory and a crash never leaves a
+ * partial entry. Unreadable entries count as misses.
+ *
+ * put() only queues the entry: a writer thread owned by the cache does the
+ * file I/O, so callers such as the HTTP event loop never block on disk.
+ * Queued entries are served from memory until written. Destruction (or
+ * flush()) waits for the queue to drain.
+ *
+ * Thread-safe.
+ */
+class ResponseCache {
+public:
+    /**
+     * @throws std::runtime_error if the directory cannot be created
+     */
+    explicit ResponseCache(const std::string& directory);
+    ~ResponseCache();
+
+    ResponseCache(const ResponseCache&) = delete;
+    ResponseCache& operator=(const ResponseCache&) = delete;
+
+    /**
+     * @brief Hex SHA-256 key of a request
+     */
+    static std::string make_key(
+        const std::string& provider,
+        const std::string& model,
+        const std::string& payload
+    );
+
+    /**
+     * @brief Cached response for key, counting a hit or a miss
+     */
+    std::optional<LLMResponse> get(const std::string& key);
+
+    /**
+     * @brief Queue a successful response for writing; failed responses are ignored
+     */
+    void put(const std::string& key, const LLMResponse& response);
+
+    /**
+     * @brief Drop the entry for key, e.g. a reply its caller could not use
+     *
+     * Later get() calls miss at once; the file is removed by the writer.
+     */
+    void erase(const std::string& key);
+
+    /**
+     * @brief Wait until every queued entry is on disk
+     */
+    void flush();
+
+    const std::string& directory() const { return directory_; }
+    size_t hits() const { return hits_; }
+    size_t misses() const { return misses_; }
+
+private:
+    std::string directory_;
+    std::atomic<size_t> hits_{0};
+    std::atomic<size_t> misses_{0};
+
+    struct PendingEntry {
+        uint64_t version = 0;           ///< Bumped when the key is put again before it is written
+        std::string serialized;
+        bool erased = false;            ///< Remove the file instead of writing it
+    };
+
+    std::mutex mutex_;
+    std::condition_variable changed_;
+    std::unordered_map<std::string, PendingEntry> pending_;
+    std::deque<std::string> queue_;
+    uint64_t next_version_ = 0;
+    bool writing_ = false;
+    bool stopping_ = false;
+    std::thread writer_;                ///< Started by the first put()
+
+    std::string entry_path(const std::string& key) const;
+    void enqueue(const std::string& key, std::string serialized, bool erased);
+    void write_entry(const std::string& key, const std::string& serialized);
+    void run_writer();
+};
+
+} // namespace kg
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "llm/llm_provider.hpp"
+#include <chrono>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace kg {
+
+// ============================================================================
+// Extraction Journal
+// ============================================================================
+
+/**
+ * @brief Append-only record of completed chunk extractions, for resuming runs
+ *
+ * Each successful ExtractionResult is appended as one JSON line
+ * (document_id, chunk_id, the request key, relations and token usage) as
+ * soon as it is collected. Lines reach the kernel on every append, so a
+ * crashed process loses nothing; fsync runs every sync_every records or
+ * sync_interval, whichever comes first, and on sync() and destruction,
+ * bounding what a power loss can take.
+ *
+ * Opening an existing journal loads its records, so a restarted run
+ * answers those chunks from lookup() instead of the LLM. Records appended
+ * afterwards are only written, not kept in memory, so a long run does not
+ * grow with its output; lookup() does not see them until the journal is
+ * reopened. A torn last line is cut off and other unreadable lines are
+ * skipped. A chunk is only found under the request key it was journalled
+ * with (see LLMProvider::extraction_key), so changing its text, the
+ * provider, model, prompts or generation parameters extracts it again.
+ * Failed extractions are not journalled, so a resumed run retries them.
+ *
+ * Thread-safe.
+ */
+class ExtractionJournal {
+public:
+    struct Options {
+        size_t sync_every = 64;                                 ///< fsync after this many appends (0 = no count limit)
+        std::chrono::milliseconds sync_interval{1000};          ///< fsync when the oldest unsynced append is this old
+        bool resume = true;                                     ///< Load existing records (false = truncate the file)
+    };
+
+    /**
+     * @throws std::runtime_error if the file cannot be opened for appending
+     */
+    explicit ExtractionJournal(const std::string& path);
+    ExtractionJournal(const std::string& path, const Options& options);
+    ~ExtractionJournal();
+
+    ExtractionJournal(const ExtractionJournal&) = delete;
+    ExtractionJournal& operator=(const ExtractionJournal&) = delete;
+
+    /**
+     * @brief Journalled result for a chunk, if it was sent with the same request key
+     */
+    std::optional<ExtractionResult> lookup(
+        const std::string& document_id,
+        const std::string& chunk_id,
+        const std::string& request_key
+    ) const;
+
+    /**
+     * @brief Record a chunk's result; failed results are ignored
+     *
+     * @throws std::runtime_error if the write fails
+     */
+    void append(
+        const std::string& document_id,
+        const std::string& request_key,
+        const ExtractionResult& result
+    );
+
+    /**
+     * @brief Flush appended records to stable storage
+     */
+    void sync();
+
+    const std::string& path() const { return path_; }
+
+    /**
+     * @brief Records in the journal: recovered plus appended since opening
+     */
+    size_t size() const;
+
+    /**
+     * @brief Chunks loaded from an earlier run when the journal was opened
+     */
+    size_t recovered() const { return recovered_; }
+
+private:
+    struct Entry {
+        std::string request_key;
+        ExtractionResult result;
+    };
+
+    std::string path_;
+    Options options_;
+    int fd_ = -1;
+    size_t recovered_ = 0;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, Entry> entries_;    ///< Recovered records, keyed by document_id + '\n' + chunk_id
+    size_t appended_ = 0;
+    size_t unsynced_ = 0;
+    std::chrono::steady_clock::time_point first_unsynced_;
+
+    void load();
+    void sync_locked();
+};
+
+} // namespace kg
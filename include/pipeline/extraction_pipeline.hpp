@@ -3,11 +3,14 @@
 #include "graph/hypergraph.hpp"
 #include "pdf/pdf_processor.hpp"
 #include "llm/llm_provider.hpp"
+#include "pipeline/extraction_journal.hpp"
 #include <string>
 #include <vector>
 #include <memory>
 #include <functional>
 #include <map>
+#include <mutex>
+#include <chrono>
 
 namespace kg {
 
@@ -27,6 +30,10 @@ struct PipelineConfig {
     int llm_max_tokens = 2000;              ///< Max completion tokens
     int llm_max_retries = 3;                ///< Retry attempts
     int llm_timeout_seconds = 60;           ///< Request timeout
+    int llm_requests_per_minute = 0;        ///< Request budget shared with discovery/report calls (0 = from rate_limit_delay_ms)
+    int llm_tokens_per_minute = 0;          ///< Token budget shared with discovery/report calls (0 = unlimited)
+    bool enable_llm_cache = true;           ///< Answer repeated LLM requests from the on-disk cache
+    std::string llm_cache_directory = ".kg_cache/llm";  ///< Response cache location, shared across runs
 
     // Chunking Configuration
     std::string chunking_strategy = "page";  ///< "fixed", "page", "paragraph", "sentence"
@@ -38,12 +45,14 @@ struct PipelineConfig {
 
     // Processing Configuration
     int batch_size = 10;                    ///< Process N documents at a time
-    int rate_limit_delay_ms = 1000;         ///< Delay between LLM calls
-    bool parallel_processing = false;       ///< Enable parallel processing (future)
+    int rate_limit_delay_ms = 1000;         ///< Legacy spacing, used as 60000 / delay requests per minute when llm_requests_per_minute is 0
+    bool parallel_processing = false;       ///< Extract a document's chunks concurrently
+    int max_concurrent_requests = 64;       ///< LLM calls in flight when parallel_processing is set
 
     // Deduplication Configuration
     bool enable_deduplication = true;       ///< Enable node deduplication
     double similarity_threshold = 0.85;     ///< Similarity threshold for merging
+    std::string dedup_index = "hnsw";       ///< Embedding neighbour search: "hnsw" or "exact"
 
     // Output Configuration
     std::string output_directory = "output_json";  ///< Output directory
@@ -51,6 +60,13 @@ struct PipelineConfig {
     bool save_extractions = true;           ///< Save raw extraction results
     bool verbose = true;                    ///< Verbose logging
 
+    // Resume Configuration
+    bool enable_journal = true;             ///< Journal each chunk's extraction and skip journalled chunks on restart
+    std::string journal_path;               ///< Journal file (empty = <output_directory>/extraction_journal.jsonl)
+    bool journal_resume = true;             ///< Reuse an existing journal's chunks (false = start a fresh journal)
+    int journal_sync_every = 64;            ///< fsync the journal after this many chunks
+    int journal_sync_interval_ms = 1000;    ///< ... or when the oldest unsynced chunk is this old
+
     // Extraction Prompt (optional override)
     std::string custom_system_prompt;       ///< Override default system prompt
 
@@ -94,8 +110,11 @@ struct PipelineStatistics {
     int extraction_successes = 0;
     int extraction_failures = 0;
     int total_relations_extracted = 0;
+    int llm_cache_hits = 0;                 ///< Extractions answered from the response cache
+    int llm_cache_misses = 0;               ///< Extractions sent to the LLM with the cache enabled
+    int chunks_resumed = 0;                 ///< Chunks answered from the extraction journal of an earlier run
 
-    // Token usage
+    // Token usage (cache hits cost none and are not counted)
     int total_prompt_tokens = 0;
     int total_completion_tokens = 0;
     int total_tokens = 0;
@@ -111,6 +130,8 @@ struct PipelineStatistics {
     int final_edges = 0;
     int nodes_before_dedup = 0;
     int nodes_merged = 0;
+    int duplicate_edges_removed = 0;
+    int self_loops_removed = 0;
 
     /**
      * @brief Print summary to stdout
@@ -194,15 +215,34 @@ public:
         const std::string& document_id = "text_input"
     );
 
+    /**
+     * @brief Extract relations from already chunked text
+     *
+     * With parallel_processing, up to max_concurrent_requests chunks are
+     * in flight at once on the provider's async transport, from this one
+     * thread; results are returned in chunk order either way. Chunks
+     * already in the journal are not sent, and new results are journalled
+     * as they are collected.
+     */
+    std::vector<ExtractionResult> extract_from_chunks(
+        const std::vector<TextChunk>& chunks,
+        const std::string& document_id
+    );
+
+    /**
+     * @brief Replace the LLM provider built from the configuration
+     */
+    void set_llm_provider(std::unique_ptr<LLMProvider> provider);
+
     /**
      * @brief Set progress callback
      */
     void set_progress_callback(ProgressCallback callback);
 
     /**
-     * @brief Get pipeline statistics
+     * @brief Get pipeline statistics (safe to call from a progress callback)
      */
-    PipelineStatistics get_statistics() const { return stats_; }
+    PipelineStatistics get_statistics() const;
 
     /**
      * @brief Reset statistics
@@ -224,9 +264,13 @@ private:
     PipelineStatistics stats_;
     ProgressCallback progress_callback_;
 
+    // get_statistics() may be called while a run updates stats_
+    mutable std::mutex stats_mutex_;
+
     std::unique_ptr<PDFProcessor> pdf_processor_;
     std::unique_ptr<LLMProvider> llm_provider_;
     std::unique_ptr<ChunkingStrategy> chunking_strategy_;
+    std::unique_ptr<ExtractionJournal> journal_;
 
     /**
      * @brief Initialize components based on config
@@ -243,14 +287,6 @@ private:
      */
     Hypergraph process_document(const PDFDocument& doc);
 
-    /**
-     * @brief Extract relations from chunks
-     */
-    std::vector<ExtractionResult> extract_from_chunks(
-        const std::vector<TextChunk>& chunks,
-        const std::string& document_id
-    );
-
     /**
      * @brief Build hypergraph from extraction results
      */
@@ -291,9 +327,9 @@ private:
     );
 
     /**
-     * @brief Apply rate limiting
+     * @brief Update statistics with one chunk's extraction
      */
-    void apply_rate_limit();
+    void record_extraction(const ExtractionResult& result, const TextChunk& chunk, double seconds);
 };
 
 // ============================================================================
@@ -0,0 +1,179 @@
+#pragma once
+
+#include <nlohmann/json.hpp>
+#include <cstdint>
+#include <istream>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace kg {
+
+/**
+ * @brief Output settings shared by every JSON export
+ */
+struct JsonWriteOptions {
+    bool compact = false;                              // No indentation or spaces (dump() instead of dump(2))
+    bool gzip = false;                                 // Gzip framing; implied by a ".gz" file name
+    int gzip_level = 6;                                // 1 (fastest) .. 9 (smallest)
+};
+
+/**
+ * @brief Incremental JSON serializer writing straight to a stream
+ *
+ * Values are emitted as they are passed in, so exporting a collection
+ * needs no DOM beyond the element currently being written. Pretty output
+ * uses the same layout as nlohmann::json::dump(2); compact output matches
+ * dump(). Doubles are written in shortest round-trip form and floats at
+ * float precision; non-finite numbers become null, as nlohmann does.
+ *
+ * Misuse (a value where a key is expected, unbalanced end_*) throws
+ * std::logic_error.
+ */
+class JsonWriter {
+public:
+    explicit JsonWriter(std::ostream& out, bool compact = false);
+
+    JsonWriter& begin_object();
+    JsonWriter& end_object();
+    JsonWriter& begin_array();
+    JsonWriter& end_array();
+
+    /**
+     * @brief Key of the next member; only valid directly inside an object
+     */
+    JsonWriter& key(std::string_view name);
+
+    JsonWriter& value(std::string_view text);
+    JsonWriter& value(const char* text) { return value(std::string_view(text)); }
+    JsonWriter& value(const std::string& text) { return value(std::string_view(text)); }
+    JsonWriter& value(bool flag);
+    JsonWriter& value(double number);
+    JsonWriter& value(float number);
+    JsonWriter& null();
+
+    template <typename T, std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>, int> = 0>
+    JsonWriter& value(T number) {
+        if constexpr (std::is_signed_v<T>) {
+            return write_integer(static_cast<int64_t>(number));
+        } else {
+            return write_unsigned(static_cast<uint64_t>(number));
+        }
+    }
+
+    template <typename T>
+    JsonWriter& value(const std::vector<T>& values) { return array(values); }
+    template <typename V>
+    JsonWriter& value(const std::map<std::string, V>& entries) { return object(entries); }
+    template <typename V>
+    JsonWriter& value(const std::unordered_map<std::string, V>& entries) { return object(entries); }
+
+    /**
+     * @brief Write a DOM subtree in the writer's layout
+     */
+    JsonWriter& value(const nlohmann::json& j);
+
+    /**
+     * @brief Write any range of values as an array
+     */
+    template <typename Range>
+    JsonWriter& array(const Range& values) {
+        begin_array();
+        for (const auto& v : values) value(v);
+        return end_array();
+    }
+
+    /**
+     * @brief Write a string-keyed map as an object
+     */
+    template <typename Map>
+    JsonWriter& object(const Map& entries) {
+        begin_object();
+        for (const auto& [k, v] : entries) {
+            key(k);
+            value(v);
+        }
+        return end_object();
+    }
+
+    /**
+     * @brief key(name) followed by value(v)
+     */
+    template <typename T>
+    JsonWriter& member(std::string_view name, const T& v) {
+        key(name);
+        return value(v);
+    }
+
+    /**
+     * @brief True once the single top-level value is complete
+     */
+    bool done() const { return stack_.empty() && wrote_root_; }
+
+private:
+    struct Scope {
+        bool is_object;
+        size_t count = 0;
+    };
+
+    void before_value();
+    void newline_indent(size_t depth);
+    void write_string(std::string_view text);
+    JsonWriter& write_integer(int64_t number);
+    JsonWriter& write_unsigned(uint64_t number);
+    JsonWriter& write_raw(const char* data, size_t size);
+
+    std::ostream& out_;
+    bool compact_;
+    std::vector<Scope> stack_;
+    bool expecting_value_ = false;                     // Inside an object, after key()
+    bool wrote_root_ = false;
+};
+
+/**
+ * @brief Output file stream honouring JsonWriteOptions framing
+ *
+ * Plain files go through an ofstream; gzip output is compressed as it
+ * is written. close() flushes and reports write errors, which the
+ * destructor cannot.
+ */
+class JsonOutputFile {
+public:
+    /**
+     * @throws std::runtime_error if the file cannot be opened, or gzip is
+     *         requested in a build without zlib
+     */
+    JsonOutputFile(const std::string& path, const JsonWriteOptions& options);
+    ~JsonOutputFile();
+
+    std::ostream& stream() { return *stream_; }
+
+    /**
+     * @brief Flush and close
+     * @throws std::runtime_error on a write error
+     */
+    void close();
+
+private:
+    std::string path_;
+    std::unique_ptr<std::streambuf> buffer_;
+    std::unique_ptr<std::ostream> stream_;
+};
+
+/**
+ * @brief Open a JSON file for reading, transparently inflating gzip input
+ * @throws std::runtime_error if the file cannot be opened
+ */
+std::unique_ptr<std::istream> open_json_input(const std::string& path);
+
+/**
+ * @brief Whether a file starts with the gzip magic bytes
+ */
+bool is_gzip_file(const std::string& path);
+
+} // namespace kg
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace kg {
+
+/**
+ * @brief Worker count used when a caller asks for "default" parallelism
+ */
+inline size_t default_thread_count() {
+    size_t hw = std::thread::hardware_concurrency();
+    return hw == 0 ? 1 : hw;
+}
+
+/**
+ * @brief Split [0, count) into contiguous shards and process them in parallel
+ * @param count Number of items to process
+ * @param num_threads Requested workers (0 = default_thread_count())
+ * @param fn Callable invoked as fn(shard, begin, end)
+ * @return Number of shards used; shard indices are dense in [0, return)
+ *
+ * Shard 0 runs on the calling thread, so a single-shard call never spawns.
+ * The first exception thrown by any shard is rethrown after all shards join.
+ */
+template <typename Fn>
+size_t parallel_for_shards(size_t count, size_t num_threads, Fn&& fn) {
+    if (count == 0) return 0;
+    if (num_threads == 0) num_threads = default_thread_count();
+    size_t shards = std::min(num_threads, count);
+
+    std::exception_ptr error;
+    std::mutex error_mutex;
+    auto run = [&](size_t shard) {
+        size_t begin = count * shard / shards;
+        size_t end = count * (shard + 1) / shards;
+        try {
+            fn(shard, begin, end);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(error_mutex);
+            if (!error) error = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(shards - 1);
+    for (size_t shard = 1; shard < shards; ++shard) {
+        workers.emplace_back(run, shard);
+    }
+    run(0);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    if (error) std::rethrow_exception(error);
+    return shards;
+}
+
+/**
+ * @brief Process [0, count) in parallel, handing out one item at a time
+ * @param count Number of items to process
+ * @param num_threads Requested workers (0 = default_thread_count())
+ * @param fn Callable invoked as fn(item)
+ *
+ * For items of very uneven cost, where contiguous shards would leave most
+ * workers idle behind the slowest one. Items start in index order.
+ */
+template <typename Fn>
+void parallel_for_dynamic(size_t count, size_t num_threads, Fn&& fn) {
+    if (num_threads == 0) num_threads = default_thread_count();
+    std::atomic<size_t> next{0};
+    parallel_for_shards(std::min(num_threads, count), num_threads, [&](size_t, size_t, size_t) {
+        for (size_t item = next++; item < count; item = next++) {
+            fn(item);
+        }
+    });
+}
+
+} // namespace kg
@@ -0,0 +1,196 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace kg {
+
+/**
+ * @brief Read-only view of a typed array inside a mapped file
+ */
+template <typename T>
+struct ArrayView {
+    const T* data = nullptr;
+    size_t size = 0;
+
+    const T& operator[](size_t i) const { return data[i]; }
+    const T* begin() const { return data; }
+    const T* end() const { return data + size; }
+    bool empty() const { return size == 0; }
+};
+
+/**
+ * @brief Whole-file read-only memory mapping (PROT_READ, MAP_SHARED)
+ */
+class MappedFile {
+public:
+    /**
+     * @throws std::runtime_error if the file cannot be opened or mapped
+     */
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+
+private:
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+/**
+ * @brief Container format shared by the binary graph snapshot and index
+ *
+ * Layout (native little-endian):
+ * - header: 8 magic bytes, format version, byte-order mark, section count
+ * - table of contents: (id, offset, size) per section
+ * - section payloads, each 8-byte aligned so arrays can be read in place
+ *
+ * Readers look sections up by id, so formats can add sections without
+ * breaking older readers.
+ */
+class SectionFile {
+public:
+    using Magic = char[8];
+
+    /**
+     * @brief Map a file and validate its header and table of contents
+     * @param kind Human-readable format name used in error messages
+     * @throws std::runtime_error on a foreign, truncated or incompatible file
+     */
+    SectionFile(const std::string& path, const Magic& magic, uint32_t version, const char* kind);
+
+    /**
+     * @brief Check the magic bytes without mapping the file
+     */
+    static bool has_magic(const std::string& path, const Magic& magic);
+
+    bool has_section(uint32_t id) const;
+
+    /**
+     * @brief Section id as an array of T
+     * @throws std::runtime_error if missing, misaligned or not a whole number of T
+     */
+    template <typename T>
+    ArrayView<T> section(uint32_t id) const {
+        auto [data, size] = raw_section(id, alignof(T), sizeof(T));
+        return {reinterpret_cast<const T*>(data), size / sizeof(T)};
+    }
+
+    /**
+     * @brief As section(id), additionally requiring exactly expected_count entries
+     */
+    template <typename T>
+    ArrayView<T> section(uint32_t id, size_t expected_count) const {
+        auto view = section<T>(id);
+        if (view.size != expected_count) count_mismatch(id, view.size, expected_count);
+        return view;
+    }
+
+    /**
+     * @brief Throw a std::runtime_error naming the file kind
+     */
+    [[noreturn]] void corrupt(const std::string& what) const;
+
+private:
+    std::pair<const char*, size_t> raw_section(uint32_t id, size_t alignment, size_t element_size) const;
+    [[noreturn]] void count_mismatch(uint32_t id, size_t actual, size_t expected) const;
+
+    struct Entry {
+        uint64_t offset;
+        uint64_t size;
+    };
+
+    std::shared_ptr<MappedFile> mapping_;
+    std::string kind_;
+    std::unordered_map<uint32_t, Entry> sections_;
+};
+
+/**
+ * @brief Collects sections and writes them as a SectionFile
+ *
+ * Sections reference the caller's buffers, which must stay alive until
+ * write() returns.
+ */
+class SectionFileWriter {
+public:
+    template <typename T>
+    void add(uint32_t id, const std::vector<T>& values) {
+        add_bytes(id, values.data(), values.size() * sizeof(T));
+    }
+
+    void add_bytes(uint32_t id, const void* data, size_t size);
+
+    /**
+     * @throws std::runtime_error if the file cannot be written
+     */
+    void write(const std::string& path, const SectionFile::Magic& magic, uint32_t version) const;
+
+private:
+    struct Pending {
+        uint32_t id;
+        const char* data;
+        size_t size;
+    };
+    std::vector<Pending> sections_;
+};
+
+/**
+ * @brief Deduplicating string table builder; index 0 is always ""
+ */
+class StringTableBuilder {
+public:
+    StringTableBuilder();
+
+    uint32_t intern(const std::string& value);
+
+    /**
+     * @brief Reorder the table lexicographically so readers can binary-search it
+     * @return remap[old_index] = new_index
+     */
+    std::vector<uint32_t> sort();
+
+    size_t size() const { return offsets_.size() - 1; }
+    const std::vector<uint64_t>& offsets() const { return offsets_; }
+    const std::vector<char>& data() const { return data_; }
+
+private:
+    std::unordered_map<std::string, uint32_t> index_;
+    std::vector<uint64_t> offsets_{0};                 // size() + 1 entries
+    std::vector<char> data_;
+};
+
+/**
+ * @brief Reader side of StringTableBuilder
+ */
+struct StringTableView {
+    ArrayView<uint64_t> offsets;                       // size() + 1 entries
+    ArrayView<char> data;
+
+    size_t size() const { return offsets.size == 0 ? 0 : offsets.size - 1; }
+
+    std::string_view operator[](uint32_t index) const {
+        return {data.data + offsets[index], static_cast<size_t>(offsets[index + 1] - offsets[index])};
+    }
+
+    /**
+     * @brief Index of value in a sorted table, or size() if absent
+     */
+    uint32_t find(std::string_view value) const;
+
+    /**
+     * @brief Check offsets are monotonic and end at the data size
+     * @throws std::runtime_error via file.corrupt()
+     */
+    void validate(const SectionFile& file) const;
+};
+
+} // namespace kg
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace kg {
+namespace vec {
+
+/**
+ * @brief Instruction set used by the vector kernels
+ *
+ * The best level supported by the CPU is picked at first use; all levels
+ * compute the same quantities and differ only in float rounding order.
+ */
+enum class Isa {
+    Scalar,     // Portable C++ fallback
+    SSE,        // SSE2, 4 lanes
+    AVX2,       // AVX2 + FMA, 8 lanes
+    AVX512      // AVX-512F, 16 lanes
+};
+
+std::string isa_name(Isa isa);
+
+/**
+ * @brief Best instruction set this CPU (and build) supports
+ */
+Isa detected_isa();
+
+/**
+ * @brief Instruction set currently dispatched to
+ */
+Isa active_isa();
+
+/**
+ * @brief Force a dispatch level (for testing and benchmarking)
+ * @throws std::invalid_argument if the CPU does not support it
+ *
+ * The KG_SIMD environment variable ("scalar", "sse", "avx2", "avx512")
+ * selects the initial level the same way.
+ */
+void set_isa(Isa isa);
+
+// ==========================================
+// One-vs-one
+// ==========================================
+
+float dot(const float* a, const float* b, size_t n);
+
+/**
+ * @brief Cosine similarity; 0 when either vector has zero norm
+ */
+float cosine(const float* a, const float* b, size_t n);
+
+float l1_distance(const float* a, const float* b, size_t n);
+float l2_squared(const float* a, const float* b, size_t n);
+float l2_distance(const float* a, const float* b, size_t n);
+float norm(const float* a, size_t n);
+
+/**
+ * @brief y += alpha * x
+ */
+void axpy(float alpha, const float* x, float* y, size_t n);
+
+/**
+ * @brief Scale a to unit length in place; returns the original norm
+ *
+ * Vectors with norm below min_norm are left untouched.
+ */
+float normalize(float* a, size_t n, float min_norm = 0.0f);
+
+// ==========================================
+// One-vs-many (rows are count x n, row-major)
+// ==========================================
+
+void dot_many(const float* query, const float* rows, size_t count, size_t n, float* out);
+void cosine_many(const float* query, const float* rows, size_t count, size_t n, float* out);
+void l1_distance_many(const float* query, const float* rows, size_t count, size_t n, float* out);
+void l2_squared_many(const float* query, const float* rows, size_t count, size_t n, float* out);
+
+// ==========================================
+// Many-vs-many (out is a_count x b_count, row-major)
+// ==========================================
+
+void dot_matrix(const float* a, size_t a_count, const float* b, size_t b_count,
+                size_t n, float* out);
+void cosine_matrix(const float* a, size_t a_count, const float* b, size_t b_count,
+                   size_t n, float* out);
+void l2_squared_matrix(const float* a, size_t a_count, const float* b, size_t b_count,
+                       size_t n, float* out);
+
+} // namespace vec
+} // namespace kg
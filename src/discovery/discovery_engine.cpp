@@ -1,5 +1,7 @@
 #include "discovery/discovery_engine.hpp"
 #include "llm/llm_provider.hpp"
+#include "util/parallel.hpp"
+#include "util/vector_math.hpp"
 #include <algorithm>
 #include <unordered_set>
 #include <unordered_map>
@@ -101,35 +103,50 @@ std::string join_labels(const Hypergraph& graph, const std::vector<std::string>&
     return ss.str();
 }
 
+// Pointers into the graph's storage, for operators that need random access
+std::vector<const HyperNode*> node_refs(const Hypergraph& graph) {
+    std::vector<const HyperNode*> refs;
+    refs.reserve(graph.num_nodes());
+    for (const auto& node : graph.nodes_view()) refs.push_back(&node);
+    return refs;
+}
+
+std::vector<const HyperEdge*> edge_refs(const Hypergraph& graph) {
+    std::vector<const HyperEdge*> refs;
+    refs.reserve(graph.num_edges());
+    for (const auto& edge : graph.edges_view()) refs.push_back(&edge);
+    return refs;
+}
+
 struct ProjectionGraph {
     std::vector<std::string> node_ids;
-    std::unordered_map<std::string, size_t> node_index;
     std::vector<std::unordered_map<size_t, double>> adj;
 };
 
-ProjectionGraph build_projection_graph(const Hypergraph& graph) {
-    ProjectionGraph proj;
-    auto nodes = graph.get_all_nodes();
-    proj.node_ids.reserve(nodes.size());
-    for (size_t i = 0; i < nodes.size(); ++i) {
-        proj.node_ids.push_back(nodes[i].id);
-        proj.node_index[nodes[i].id] = i;
+// Dense position of every live node handle; dead handles map to SIZE_MAX
+std::vector<size_t> live_node_positions(const Hypergraph& graph, std::vector<std::string>& ids) {
+    std::vector<size_t> position(graph.node_id_bound(), SIZE_MAX);
+    ids.reserve(graph.num_nodes());
+    for (NodeId id = 0; id < graph.node_id_bound(); ++id) {
+        if (!graph.is_live_node(id)) continue;
+        position[id] = ids.size();
+        ids.push_back(graph.node_at(id).id);
     }
-    proj.adj.resize(nodes.size());
+    return position;
+}
 
-    auto edges = graph.get_all_edges();
-    for (const auto& edge : edges) {
-        std::vector<std::string> edge_nodes;
-        edge_nodes.reserve(edge.size());
-        for (const auto& nid : edge.get_all_nodes()) {
-            if (proj.node_index.find(nid) != proj.node_index.end()) {
-                edge_nodes.push_back(nid);
-            }
-        }
-        for (size_t i = 0; i < edge_nodes.size(); ++i) {
-            size_t a = proj.node_index[edge_nodes[i]];
-            for (size_t j = i + 1; j < edge_nodes.size(); ++j) {
-                size_t b = proj.node_index[edge_nodes[j]];
+ProjectionGraph build_projection_graph(const Hypergraph& graph) {
+    ProjectionGraph proj;
+    auto csr = graph.incidence();
+    auto position = live_node_positions(graph, proj.node_ids);
+    proj.adj.resize(proj.node_ids.size());
+
+    for (EdgeId e = 0; e < csr->num_edge_rows(); ++e) {
+        auto members = csr->nodes_of(e);
+        for (size_t i = 0; i < members.size(); ++i) {
+            size_t a = position[members[i]];
+            for (size_t j = i + 1; j < members.size(); ++j) {
+                size_t b = position[members[j]];
                 proj.adj[a][b] += 1.0;
                 proj.adj[b][a] += 1.0;
             }
@@ -143,34 +160,30 @@ struct BipartiteGraph {
     size_t num_entities = 0;
     std::vector<std::string> entity_ids;
     std::vector<std::string> edge_ids;
-    std::unordered_map<std::string, size_t> entity_index;
     std::vector<std::vector<size_t>> adj;
 };
 
 BipartiteGraph build_bipartite_graph(const Hypergraph& graph) {
     BipartiteGraph bi;
-    auto nodes = graph.get_all_nodes();
-    auto edges = graph.get_all_edges();
-    bi.num_entities = nodes.size();
-    bi.entity_ids.reserve(nodes.size());
-    for (size_t i = 0; i < nodes.size(); ++i) {
-        bi.entity_ids.push_back(nodes[i].id);
-        bi.entity_index[nodes[i].id] = i;
-    }
-    bi.edge_ids.reserve(edges.size());
-    for (const auto& edge : edges) {
-        bi.edge_ids.push_back(edge.id);
-    }
-    size_t total = nodes.size() + edges.size();
+    auto csr = graph.incidence();
+    auto position = live_node_positions(graph, bi.entity_ids);
+    bi.num_entities = bi.entity_ids.size();
+
+    std::vector<EdgeId> live_edges;
+    live_edges.reserve(graph.num_edges());
+    bi.edge_ids.reserve(graph.num_edges());
+    for (EdgeId e = 0; e < graph.edge_id_bound(); ++e) {
+        if (!graph.is_live_edge(e)) continue;
+        live_edges.push_back(e);
+        bi.edge_ids.push_back(graph.edge_at(e).id);
+    }
+    size_t total = bi.num_entities + live_edges.size();
     bi.adj.resize(total);
 
-    for (size_t eidx = 0; eidx < edges.size(); ++eidx) {
-        const auto& edge = edges[eidx];
-        size_t edge_node_idx = nodes.size() + eidx;
-        for (const auto& nid : edge.get_all_nodes()) {
-            auto it = bi.entity_index.find(nid);
-            if (it == bi.entity_index.end()) continue;
-            size_t nidx = it->second;
+    for (size_t eidx = 0; eidx < live_edges.size(); ++eidx) {
+        size_t edge_node_idx = bi.num_entities + eidx;
+        for (NodeId n : csr->nodes_of(live_edges[eidx])) {
+            size_t nidx = position[n];
             bi.adj[nidx].push_back(edge_node_idx);
             bi.adj[edge_node_idx].push_back(nidx);
         }
@@ -482,8 +495,8 @@ std::vector<Insight> DiscoveryEngine::find_bridges() {
     report_progress("Finding bridges", 0, 100);
 
     int s = config_.bridge_s_threshold;
-    auto it = index_.s_components.find(s);
-    if (it == index_.s_components.end() || it->second.size() < 2) {
+    auto it = index_.s_components().find(s);
+    if (it == index_.s_components().end() || it->second.size() < 2) {
         return results;
     }
 
@@ -498,7 +511,7 @@ std::vector<Insight> DiscoveryEngine::find_bridges() {
     }
 
     std::unordered_map<std::string, std::set<int>> node_components;
-    auto all_nodes = graph_.get_all_nodes();
+    auto all_nodes = graph_.nodes_view();
     for (const auto& node : all_nodes) {
         std::set<int> comps;
         for (const auto& eid : node.incident_edges) {
@@ -572,7 +585,7 @@ std::vector<Insight> DiscoveryEngine::find_completions() {
     std::vector<Insight> results;
     report_progress("Finding completions", 0, 100);
 
-    auto all_edges = graph_.get_all_edges();
+    auto all_edges = graph_.edges_view();
 
     std::map<std::pair<std::string, std::string>, std::vector<std::string>> pair_edges;
 
@@ -664,7 +677,7 @@ std::vector<Insight> DiscoveryEngine::find_motifs() {
     std::vector<Insight> results;
     report_progress("Finding motifs", 0, 100);
 
-    auto all_edges = graph_.get_all_edges();
+    auto all_edges = graph_.edges_view();
 
     std::map<std::set<std::string>, int> pattern_counts;
 
@@ -755,14 +768,14 @@ std::vector<Insight> DiscoveryEngine::find_substitutions() {
     std::vector<Insight> results;
     report_progress("Finding substitutions", 0, 100);
 
-    auto all_edges = graph_.get_all_edges();
+    auto all_edges = edge_refs(graph_);
 
     std::vector<std::tuple<std::string, std::string, std::string, std::string, double>> candidates;
 
     report_progress("Finding substitutions", 20, 100);
 
     size_t sample_limit = std::min(size_t(1000), all_edges.size());
-    std::vector<HyperEdge> sampled_edges;
+    std::vector<const HyperEdge*> sampled_edges;
     if (all_edges.size() > sample_limit) {
         std::random_device rd;
         std::mt19937 gen(rd());
@@ -777,13 +790,13 @@ std::vector<Insight> DiscoveryEngine::find_substitutions() {
             report_progress("Finding substitutions", 20 + (60 * i / sampled_edges.size()), 100);
         }
 
-        const auto& e1 = sampled_edges[i];
+        const auto& e1 = *sampled_edges[i];
         std::set<std::string> e1_nodes;
         for (const auto& n : e1.sources) e1_nodes.insert(n);
         for (const auto& n : e1.targets) e1_nodes.insert(n);
 
         for (size_t j = i + 1; j < sampled_edges.size(); ++j) {
-            const auto& e2 = sampled_edges[j];
+            const auto& e2 = *sampled_edges[j];
 
             if (e1.relation != e2.relation) continue;
 
@@ -882,7 +895,7 @@ std::vector<Insight> DiscoveryEngine::find_contradictions() {
     };
 
     std::unordered_map<std::string, ContradictionGroup> groups;
-    auto all_edges = graph_.get_all_edges();
+    auto all_edges = graph_.edges_view();
 
     for (const auto& edge : all_edges) {
         bool is_negated = false;
@@ -989,7 +1002,7 @@ std::vector<Insight> DiscoveryEngine::find_entity_resolutions() {
         std::vector<std::string> tokens;
     };
 
-    auto all_nodes = graph_.get_all_nodes();
+    auto all_nodes = node_refs(graph_);
     std::vector<NodeInfo> nodes;
     nodes.reserve(all_nodes.size());
 
@@ -997,7 +1010,7 @@ std::vector<Insight> DiscoveryEngine::find_entity_resolutions() {
     std::unordered_map<std::string, std::vector<size_t>> token_to_indices;
 
     for (size_t i = 0; i < all_nodes.size(); ++i) {
-        const auto& node = all_nodes[i];
+        const auto& node = *all_nodes[i];
         NodeInfo info;
         info.id = node.id;
         info.label = node.label;
@@ -1210,8 +1223,8 @@ std::vector<Insight> DiscoveryEngine::find_core_periphery() {
         double periphery_score = 0.0;
     };
 
-    auto nodes = graph_.get_all_nodes();
-    auto edges = graph_.get_all_edges();
+    auto nodes = graph_.nodes_view();
+    auto edges = graph_.edges_view();
 
     std::unordered_map<std::string, int> in_counts;
     std::unordered_map<std::string, int> out_counts;
@@ -1356,15 +1369,15 @@ std::vector<Insight> DiscoveryEngine::find_text_similarity_links() {
         double norm = 1.0;
     };
 
-    auto nodes = graph_.get_all_nodes();
+    auto nodes = node_refs(graph_);
     if (nodes.size() < 2) return results;
 
     std::unordered_map<std::string, int> doc_freq;
     std::vector<std::vector<std::string>> tokens_by_node;
     tokens_by_node.reserve(nodes.size());
 
-    for (const auto& node : nodes) {
-        auto tokens = tokenize_simple(node.label);
+    for (const auto* node : nodes) {
+        auto tokens = tokenize_simple(node->label);
         std::unordered_set<std::string> unique(tokens.begin(), tokens.end());
         for (const auto& token : unique) {
             doc_freq[token]++;
@@ -1376,7 +1389,7 @@ std::vector<Insight> DiscoveryEngine::find_text_similarity_links() {
     vectors.reserve(nodes.size());
 
     for (size_t i = 0; i < nodes.size(); ++i) {
-        const auto& node = nodes[i];
+        const auto& node = *nodes[i];
         const auto& tokens = tokens_by_node[i];
         if (tokens.empty()) {
             vectors.push_back({node.id, node.label, {}, 1.0});
@@ -1534,7 +1547,7 @@ std::vector<Insight> DiscoveryEngine::find_argument_support_relations() {
     auto hubs = index_.get_top_hubs(25);
     std::vector<std::string> seeds = hubs;
     if (seeds.empty()) {
-        for (const auto& node : graph_.get_all_nodes()) {
+        for (const auto& node : graph_.nodes_view()) {
             seeds.push_back(node.id);
             if (seeds.size() >= 25) break;
         }
@@ -1664,7 +1677,7 @@ std::vector<Insight> DiscoveryEngine::find_active_learning_queries() {
     };
 
     std::vector<QueryCandidate> candidates;
-    auto all_edges = graph_.get_all_edges();
+    auto all_edges = graph_.edges_view();
 
     for (const auto& edge : all_edges) {
         if (edge.confidence >= config_.active_learning_confidence_threshold) continue;
@@ -1760,7 +1773,7 @@ std::vector<Insight> DiscoveryEngine::find_method_outcome_nodes() {
     };
 
     std::vector<Candidate> candidates;
-    for (const auto& node : graph_.get_all_nodes()) {
+    for (const auto& node : graph_.nodes_view()) {
         std::string lower = to_lower_copy(node.label);
         bool method_hint = false;
         bool outcome_hint = false;
@@ -1937,7 +1950,7 @@ std::vector<Insight> DiscoveryEngine::find_centrality_nodes() {
         ins.seed_nodes = {node_id};
         ins.seed_labels = {get_node_label(node_id)};
 
-        auto incident = graph_.get_incident_edges(node_id);
+        auto incident = graph_.incident_view(node_id);
         for (size_t j = 0; j < incident.size() && j < config_.centrality_max_evidence_edges; ++j) {
             ins.witness_edges.push_back(incident[j].id);
         }
@@ -2095,7 +2108,7 @@ std::vector<Insight> DiscoveryEngine::find_community_structures() {
 
         std::unordered_set<std::string> witness_edges;
         for (const auto& seed : ins.seed_nodes) {
-            auto incident = graph_.get_incident_edges(seed);
+            auto incident = graph_.incident_view(seed);
             for (const auto& edge : incident) {
                 witness_edges.insert(edge.id);
                 if (witness_edges.size() >= config_.community_detection_max_evidence_edges) break;
@@ -2180,7 +2193,7 @@ std::vector<Insight> DiscoveryEngine::find_k_core_nodes() {
         ins.seed_nodes = {node_id};
         ins.seed_labels = {get_node_label(node_id)};
 
-        auto incident = graph_.get_incident_edges(node_id);
+        auto incident = graph_.incident_view(node_id);
         for (size_t j = 0; j < incident.size() && j < config_.centrality_max_evidence_edges; ++j) {
             ins.witness_edges.push_back(incident[j].id);
         }
@@ -2351,10 +2364,10 @@ std::vector<Insight> DiscoveryEngine::find_claim_stances() {
         return results;
     }
 
-    auto edges = graph_.get_all_edges();
+    auto edges = edge_refs(graph_);
     size_t limit = std::min(edges.size(), config_.claim_stance_max_candidates);
     for (size_t i = 0; i < limit; ++i) {
-        const auto& edge = edges[i];
+        const auto& edge = *edges[i];
         if (edge.sources.empty() || edge.targets.empty()) continue;
 
         std::stringstream prompt;
@@ -2423,7 +2436,7 @@ std::vector<Insight> DiscoveryEngine::find_relation_induction() {
         return results;
     }
 
-    auto edges = graph_.get_all_edges();
+    auto edges = graph_.edges_view();
     std::unordered_map<std::string, std::vector<const HyperEdge*>> by_relation;
     for (const auto& edge : edges) {
         if (edge.relation.empty()) continue;
@@ -2509,7 +2522,7 @@ std::vector<Insight> DiscoveryEngine::find_analogical_transfers() {
     std::vector<Insight> results;
     report_progress("Analogical transfer", 0, 100);
 
-    auto edges = graph_.get_all_edges();
+    auto edges = graph_.edges_view();
     std::unordered_map<std::string, std::vector<const HyperEdge*>> by_relation;
     for (const auto& edge : edges) {
         if (edge.sources.empty() || edge.targets.empty()) continue;
@@ -2617,7 +2630,7 @@ std::vector<Insight> DiscoveryEngine::find_uncertainty_samples() {
     std::vector<Insight> results;
     report_progress("Uncertainty sampling", 0, 100);
 
-    auto edges = graph_.get_all_edges();
+    auto edges = graph_.edges_view();
     struct Candidate {
         std::string edge_id;
         std::string src;
@@ -2669,10 +2682,10 @@ std::vector<Insight> DiscoveryEngine::find_counterfactual_probes() {
     std::vector<Insight> results;
     report_progress("Counterfactual probing", 0, 100);
 
-    auto edges = graph_.get_all_edges();
+    auto edges = edge_refs(graph_);
     size_t limit = std::min(edges.size(), config_.counterfactual_max_candidates);
     for (size_t i = 0; i < limit; ++i) {
-        const auto& edge = edges[i];
+        const auto& edge = *edges[i];
         if (edge.sources.empty() || edge.targets.empty()) continue;
         const std::string& src = edge.sources[0];
         const std::string& tgt = edge.targets[0];
@@ -2723,7 +2736,7 @@ std::vector<Insight> DiscoveryEngine::find_hyperedge_predictions() {
     std::vector<Insight> results;
     report_progress("Hyperedge prediction", 0, 100);
 
-    auto edges = graph_.get_all_edges();
+    auto edges = graph_.edges_view();
     std::unordered_map<std::string, std::unordered_map<std::string, std::unordered_set<std::string>>> rel_src_targets;
     for (const auto& edge : edges) {
         if (edge.sources.empty() || edge.targets.empty()) continue;
@@ -2797,7 +2810,7 @@ std::vector<Insight> DiscoveryEngine::find_constrained_rules() {
     std::vector<Insight> results;
     report_progress("Constrained rule mining", 0, 100);
 
-    auto edges = graph_.get_all_edges();
+    auto edges = graph_.edges_view();
     double total_edges = static_cast<double>(graph_.num_edges());
     if (total_edges == 0) return results;
 
@@ -2920,7 +2933,7 @@ std::vector<Insight> DiscoveryEngine::compute_diffusion_relevance(const std::str
     double damping = config_.diffusion_damping;
     int iterations = config_.diffusion_iterations;
 
-    auto all_nodes = graph_.get_all_nodes();
+    auto all_nodes = graph_.nodes_view();
     std::unordered_map<std::string, std::vector<std::string>> node_neighbors;
 
     for (const auto& node : all_nodes) {
@@ -3004,9 +3017,10 @@ std::vector<Insight> DiscoveryEngine::find_diffusions() {
     report_progress("Diffusion analysis", 0, 100);
 
     // Use top-degree nodes as seeds for diffusion relevance
-    size_t seed_count = std::min<size_t>(config_.diffusion_top_k, index_.degree_ranked_nodes.size());
+    auto seeds = index_.get_top_hubs(config_.diffusion_top_k);
+    size_t seed_count = seeds.size();
     for (size_t i = 0; i < seed_count; ++i) {
-        const std::string& seed = index_.degree_ranked_nodes[i].first;
+        const std::string& seed = seeds[i];
         auto rel = compute_diffusion_relevance(seed);
         for (auto& ins : rel) {
             results.push_back(std::move(ins));
@@ -3038,7 +3052,7 @@ std::vector<Insight> DiscoveryEngine::find_surprise_edges() {
     report_progress("Finding surprise edges", 0, 100);
 
     double total_edges = static_cast<double>(graph_.num_edges());
-    auto all_edges = graph_.get_all_edges();
+    auto all_edges = graph_.edges_view();
 
     std::vector<std::tuple<std::string, std::set<std::string>, double>> candidates;
 
@@ -3118,7 +3132,7 @@ std::vector<Insight> DiscoveryEngine::find_rules() {
     std::vector<Insight> results;
     report_progress("Mining association rules", 0, 100);
 
-    auto all_edges = graph_.get_all_edges();
+    auto all_edges = graph_.edges_view();
     double total_edges = static_cast<double>(graph_.num_edges());
 
     // Step 1: Build relation -> entity pairs index
@@ -3314,18 +3328,14 @@ std::vector<Insight> DiscoveryEngine::find_path_rankings() {
     std::vector<Insight> results;
     report_progress("Path ranking", 0, 100);
 
-    std::vector<std::string> candidates;
-    if (!index_.degree_ranked_nodes.empty()) {
-        for (size_t i = 0; i < std::min(config_.path_rank_max_seed_nodes, index_.degree_ranked_nodes.size()); ++i) {
-            candidates.push_back(index_.degree_ranked_nodes[i].first);
-        }
-    } else {
-        auto nodes = graph_.get_all_nodes();
-        std::sort(nodes.begin(), nodes.end(), [](const auto& a, const auto& b) {
-            return a.degree > b.degree;
+    std::vector<std::string> candidates = index_.get_top_hubs(config_.path_rank_max_seed_nodes);
+    if (candidates.empty()) {
+        auto nodes = node_refs(graph_);
+        std::sort(nodes.begin(), nodes.end(), [](const auto* a, const auto* b) {
+            return a->degree > b->degree;
         });
         for (size_t i = 0; i < std::min(config_.path_rank_max_seed_nodes, nodes.size()); ++i) {
-            candidates.push_back(nodes[i].id);
+            candidates.push_back(nodes[i]->id);
         }
     }
 
@@ -3335,91 +3345,136 @@ std::vector<Insight> DiscoveryEngine::find_path_rankings() {
 
     size_t total_pairs = candidates.size() * (candidates.size() - 1) / 2;
     size_t max_pairs = std::min(config_.path_rank_max_pairs, total_pairs);
-    size_t checked = 0;
-
-    for (size_t i = 0; i < candidates.size(); ++i) {
-        for (size_t j = i + 1; j < candidates.size(); ++j) {
-            if (checked >= max_pairs) break;
-            checked++;
 
-            if (checked % 50 == 0 || checked == max_pairs) {
-                int pct = 5 + static_cast<int>(90.0 * checked / std::max<size_t>(1, max_pairs));
-                report_progress("Path ranking", pct, 100);
+    // Pairs (i, j > i) in scan order, capped at max_pairs. Insights are built
+    // in this order afterwards, so IDs and ranking ties do not depend on
+    // how the searches were scheduled.
+    std::vector<std::pair<size_t, size_t>> pairs;
+    pairs.reserve(max_pairs);
+    for (size_t i = 0; i < candidates.size() && pairs.size() < max_pairs; ++i) {
+        for (size_t j = i + 1; j < candidates.size() && pairs.size() < max_pairs; ++j) {
+            pairs.emplace_back(i, j);
+        }
+    }
+
+    // Co-occurrence handles resolved once; the pair filter is then an
+    // allocation-free lookup
+    const auto& cooccurrence = index_.cooccurrence();
+    std::vector<CooccurrenceIndex::Entity> candidate_entities;
+    candidate_entities.reserve(candidates.size());
+    for (const auto& id : candidates) {
+        candidate_entities.push_back(index_.cooccurrence_entity(id));
+    }
+
+    std::vector<size_t> seed_begin;
+    for (size_t p = 0; p < pairs.size(); ++p) {
+        if (p == 0 || pairs[p].first != pairs[p - 1].first) {
+            seed_begin.push_back(p);
+        }
+    }
+    seed_begin.push_back(pairs.size());
+
+    // One bounded sweep per seed yields the shortest path to every partner
+    // within path_rank_max_hops, and Yen's algorithm continues from those
+    // paths. Work per seed is very uneven (early seeds have the most
+    // partners, hubs the widest sweeps), so seeds are handed out one at a
+    // time; each writes only its own pairs' slots.
+    const size_t max_hops = static_cast<size_t>(std::max(0, config_.path_rank_max_hops));
+    std::vector<PathSearchResult> pair_paths(pairs.size());
+    parallel_for_dynamic(seed_begin.size() - 1, config_.num_threads, [&](size_t seed) {
+        const std::string& a = candidates[pairs[seed_begin[seed]].first];
+        std::vector<size_t> partner_pairs;
+        std::vector<std::string> partners;
+        for (size_t p = seed_begin[seed]; p < seed_begin[seed + 1]; ++p) {
+            if (cooccurrence.count(candidate_entities[pairs[p].first],
+                                   candidate_entities[pairs[p].second]) > 0) {
+                continue;
             }
+            partner_pairs.push_back(p);
+            partners.push_back(candidates[pairs[p].second]);
+        }
+        if (partners.empty()) return;
 
-            const std::string& a = candidates[i];
-            const std::string& b = candidates[j];
+        auto ranked = graph_.find_k_shortest_paths_to(
+            a, partners, config_.path_rank_k, config_.path_rank_min_intersection, max_hops);
+        for (size_t t = 0; t < partners.size(); ++t) {
+            pair_paths[partner_pairs[t]] = std::move(ranked[t]);
+        }
+    });
 
-            if (index_.get_cooccurrence(a, b) > 0) {
-                continue;
-            }
+    for (size_t p = 0; p < pairs.size(); ++p) {
+        size_t checked = p + 1;
+        if (checked % 50 == 0 || checked == max_pairs) {
+            int pct = 5 + static_cast<int>(90.0 * checked / std::max<size_t>(1, max_pairs));
+            report_progress("Path ranking", pct, 100);
+        }
+
+        const std::string& a = candidates[pairs[p].first];
+        const std::string& b = candidates[pairs[p].second];
+
+        const auto& paths = pair_paths[p];
+        if (!paths.found || paths.paths.empty()) {
+            continue;
+        }
+
+        int min_len = std::numeric_limits<int>::max();
+        double score_sum = 0.0;
+        std::set<std::string> edge_ids;
+        std::set<std::string> node_ids;
+        int path_count = 0;
 
-            auto paths = graph_.find_k_shortest_paths(
-                a, b, config_.path_rank_k, config_.path_rank_min_intersection);
-            if (!paths.found || paths.paths.empty()) {
+        for (const auto& path : paths.paths) {
+            if (path.empty() || static_cast<int>(path.size()) > config_.path_rank_max_hops) {
                 continue;
             }
+            path_count++;
+            min_len = std::min(min_len, static_cast<int>(path.size()));
+            score_sum += 1.0 / static_cast<double>(path.size());
 
-            int min_len = std::numeric_limits<int>::max();
-            double score_sum = 0.0;
-            std::set<std::string> edge_ids;
-            std::set<std::string> node_ids;
-            int path_count = 0;
-
-            for (const auto& path : paths.paths) {
-                if (path.empty() || static_cast<int>(path.size()) > config_.path_rank_max_hops) {
-                    continue;
+            for (const auto& edge : path) {
+                if (edge_ids.size() >= config_.path_rank_max_witness_edges) {
+                    break;
                 }
-                path_count++;
-                min_len = std::min(min_len, static_cast<int>(path.size()));
-                score_sum += 1.0 / static_cast<double>(path.size());
-
-                for (const auto& edge : path) {
-                    if (edge_ids.size() >= config_.path_rank_max_witness_edges) {
-                        break;
-                    }
-                    if (edge_ids.insert(edge.id).second) {
-                        const auto* e = graph_.get_hyperedge(edge.id);
-                        if (e) {
-                            for (const auto& src : e->sources) node_ids.insert(src);
-                            for (const auto& tgt : e->targets) node_ids.insert(tgt);
-                        }
+                if (edge_ids.insert(edge.id).second) {
+                    const auto* e = graph_.get_hyperedge(edge.id);
+                    if (e) {
+                        for (const auto& src : e->sources) node_ids.insert(src);
+                        for (const auto& tgt : e->targets) node_ids.insert(tgt);
                     }
                 }
             }
+        }
 
-            if (path_count == 0 || score_sum < config_.path_rank_min_score) {
-                continue;
-            }
+        if (path_count == 0 || score_sum < config_.path_rank_min_score) {
+            continue;
+        }
 
-            Insight ins;
-            ins.insight_id = make_insight_id(InsightType::PATH_RANK);
-            ins.type = InsightType::PATH_RANK;
-            ins.seed_nodes = {a, b};
-            std::string label_a = get_node_label(a);
-            std::string label_b = get_node_label(b);
-            ins.seed_labels = {label_a.empty() ? a : label_a, label_b.empty() ? b : label_b};
-            ins.witness_edges.assign(edge_ids.begin(), edge_ids.end());
-            if (ins.witness_edges.size() < config_.path_rank_min_evidence_edges) {
-                continue;
-            }
-            ins.witness_nodes.assign(node_ids.begin(), node_ids.end());
-            ins.evidence_chunk_ids = get_chunk_ids(ins.witness_edges);
-            ins.novelty_tags = {"path_rank", "paths=" + std::to_string(path_count)};
+        Insight ins;
+        ins.insight_id = make_insight_id(InsightType::PATH_RANK);
+        ins.type = InsightType::PATH_RANK;
+        ins.seed_nodes = {a, b};
+        std::string label_a = get_node_label(a);
+        std::string label_b = get_node_label(b);
+        ins.seed_labels = {label_a.empty() ? a : label_a, label_b.empty() ? b : label_b};
+        ins.witness_edges.assign(edge_ids.begin(), edge_ids.end());
+        if (ins.witness_edges.size() < config_.path_rank_min_evidence_edges) {
+            continue;
+        }
+        ins.witness_nodes.assign(node_ids.begin(), node_ids.end());
+        ins.evidence_chunk_ids = get_chunk_ids(ins.witness_edges);
+        ins.novelty_tags = {"path_rank", "paths=" + std::to_string(path_count)};
 
-            std::stringstream desc;
-            desc << "PathRank: " << ins.seed_labels[0] << " <-> " << ins.seed_labels[1]
-                 << " via " << path_count << " paths (min_len=" << min_len << ")";
-            ins.description = desc.str();
+        std::stringstream desc;
+        desc << "PathRank: " << ins.seed_labels[0] << " <-> " << ins.seed_labels[1]
+             << " via " << path_count << " paths (min_len=" << min_len << ")";
+        ins.description = desc.str();
 
-            ins.score_breakdown["support"] = static_cast<double>(path_count);
-            ins.score_breakdown["novelty"] = min_len > 0 ? (1.0 / min_len) : 0.0;
-            ins.score_breakdown["specificity"] = score_sum;
-            ins.score = compute_score(ins);
+        ins.score_breakdown["support"] = static_cast<double>(path_count);
+        ins.score_breakdown["novelty"] = min_len > 0 ? (1.0 / min_len) : 0.0;
+        ins.score_breakdown["specificity"] = score_sum;
+        ins.score = compute_score(ins);
 
-            results.push_back(std::move(ins));
-        }
-        if (checked >= max_pairs) break;
+        results.push_back(std::move(ins));
     }
 
     std::sort(results.begin(), results.end(), [](const Insight& a, const Insight& b) {
@@ -3459,7 +3514,7 @@ std::vector<Insight> DiscoveryEngine::find_hypotheses(const InsightCollection& c
     std::unordered_map<std::string, double> core_scores;
     std::unordered_map<std::string, double> degree_norm;
     int max_degree = 1;
-    auto all_nodes = graph_.get_all_nodes();
+    auto all_nodes = graph_.nodes_view();
     for (const auto& node : all_nodes) {
         max_degree = std::max(max_degree, node.degree);
     }
@@ -3685,16 +3740,6 @@ std::vector<Insight> DiscoveryEngine::find_hypotheses(const InsightCollection& c
 
 // ============== EMBEDDING LINK PREDICTION (TransE) ==============
 
-// L2 normalize a vector
-void DiscoveryEngine::normalize_vector(std::vector<double>& vec) const {
-    double norm = 0.0;
-    for (double v : vec) norm += v * v;
-    norm = std::sqrt(norm);
-    if (norm > 1e-10) {
-        for (double& v : vec) v /= norm;
-    }
-}
-
 // Extract triples from hypergraph - convert hyperedges to binary relations
 std::vector<DiscoveryEngine::Triple> DiscoveryEngine::extract_triples(EmbeddingModel& model) const {
     std::vector<Triple> triples;
@@ -3704,12 +3749,12 @@ std::vector<DiscoveryEngine::Triple> DiscoveryEngine::extract_triples(EmbeddingM
     std::set<std::string> relations;
 
     // Collect all entities (nodes) and relations (edge labels/types)
-    auto all_nodes = graph_.get_all_nodes();
+    auto all_nodes = graph_.nodes_view();
     for (const auto& node : all_nodes) {
         entities.insert(node.id);
     }
 
-    auto all_edges = graph_.get_all_edges();
+    auto all_edges = graph_.edges_view();
     for (const auto& edge : all_edges) {
         // Use edge relation as relation type
         std::string rel = edge.relation.empty() ? "related_to" : edge.relation;
@@ -3774,38 +3819,34 @@ void DiscoveryEngine::init_embeddings(EmbeddingModel& model, size_t num_entities
     double bound = std::sqrt(6.0 / config_.embedding_dim);
     std::uniform_real_distribution<double> dist(-bound, bound);
 
-    model.entity_embeddings.resize(num_entities);
+    model.dim = config_.embedding_dim;
+
+    model.entity_embeddings.resize(num_entities * model.dim);
     for (size_t i = 0; i < num_entities; ++i) {
-        model.entity_embeddings[i].resize(config_.embedding_dim);
-        for (size_t d = 0; d < config_.embedding_dim; ++d) {
-            model.entity_embeddings[i][d] = dist(gen);
+        float* emb = model.entity(i);
+        for (size_t d = 0; d < model.dim; ++d) {
+            emb[d] = static_cast<float>(dist(gen));
         }
-        normalize_vector(model.entity_embeddings[i]);
+        vec::normalize(emb, model.dim, 1e-10f);
     }
 
-    model.relation_embeddings.resize(num_relations);
+    model.relation_embeddings.resize(num_relations * model.dim);
     for (size_t i = 0; i < num_relations; ++i) {
-        model.relation_embeddings[i].resize(config_.embedding_dim);
-        for (size_t d = 0; d < config_.embedding_dim; ++d) {
-            model.relation_embeddings[i][d] = dist(gen);
+        float* emb = model.relation(i);
+        for (size_t d = 0; d < model.dim; ++d) {
+            emb[d] = static_cast<float>(dist(gen));
         }
         // Relations are not normalized in TransE
     }
 }
 
-// TransE scoring function: returns distance ||h + r - t||
+// TransE residual h + r - t; its norm ||h + r - t|| is the triple's score
 // Lower score = more plausible triple
-double DiscoveryEngine::transe_score(const EmbeddingModel& model, const Triple& triple) const {
-    double dist = 0.0;
-    const auto& h = model.entity_embeddings[triple.head];
-    const auto& r = model.relation_embeddings[triple.relation];
-    const auto& t = model.entity_embeddings[triple.tail];
-
-    for (size_t d = 0; d < config_.embedding_dim; ++d) {
-        double diff = h[d] + r[d] - t[d];
-        dist += diff * diff;
-    }
-    return std::sqrt(dist);
+void DiscoveryEngine::transe_residual(const EmbeddingModel& model, const Triple& triple, float* out) const {
+    const float* h = model.entity(triple.head);
+    std::copy(h, h + model.dim, out);
+    vec::axpy(1.0f, model.relation(triple.relation), out, model.dim);
+    vec::axpy(-1.0f, model.entity(triple.tail), out, model.dim);
 }
 
 // Generate corrupted triple (negative sample)
@@ -3836,10 +3877,14 @@ DiscoveryEngine::Triple DiscoveryEngine::corrupt_triple(const Triple& triple, si
 void DiscoveryEngine::train_transe(EmbeddingModel& model, const std::vector<Triple>& triples) {
     if (triples.empty()) return;
 
-    size_t num_entities = model.entity_embeddings.size();
+    size_t num_entities = model.num_entities();
+    size_t dim = model.dim;
     double lr = config_.embedding_learning_rate;
     double margin = config_.embedding_margin;
 
+    std::vector<float> residual_pos(dim);
+    std::vector<float> residual_neg(dim);
+
     std::random_device rd;
     std::mt19937 gen(rd());
 
@@ -3861,42 +3906,34 @@ void DiscoveryEngine::train_transe(EmbeddingModel& model, const std::vector<Trip
                 for (size_t neg = 0; neg < config_.embedding_neg_samples; ++neg) {
                     Triple neg_triple = corrupt_triple(pos_triple, num_entities);
 
-                    double pos_score = transe_score(model, pos_triple);
-                    double neg_score = transe_score(model, neg_triple);
+                    transe_residual(model, pos_triple, residual_pos.data());
+                    transe_residual(model, neg_triple, residual_neg.data());
+                    double pos_score = vec::norm(residual_pos.data(), dim);
+                    double neg_score = vec::norm(residual_neg.data(), dim);
 
                     // Margin-based ranking loss: max(0, margin + pos_score - neg_score)
                     double loss = margin + pos_score - neg_score;
                     if (loss > 0) {
                         total_loss += loss;
 
-                        // Gradient update
-                        auto& h_pos = model.entity_embeddings[pos_triple.head];
-                        auto& t_pos = model.entity_embeddings[pos_triple.tail];
-                        auto& r = model.relation_embeddings[pos_triple.relation];
-                        auto& h_neg = model.entity_embeddings[neg_triple.head];
-                        auto& t_neg = model.entity_embeddings[neg_triple.tail];
-
-                        for (size_t d = 0; d < config_.embedding_dim; ++d) {
-                            // Gradient for positive triple: minimize h + r - t
-                            double grad_pos = 2.0 * (h_pos[d] + r[d] - t_pos[d]);
-                            // Gradient for negative triple: maximize h + r - t (so subtract)
-                            double grad_neg = 2.0 * (h_neg[d] + r[d] - t_neg[d]);
-
-                            // Update embeddings
-                            h_pos[d] -= lr * grad_pos;
-                            t_pos[d] += lr * grad_pos;
-                            r[d] -= lr * (grad_pos - grad_neg);
-                            h_neg[d] += lr * grad_neg;
-                            t_neg[d] -= lr * grad_neg;
-                        }
+                        // Gradient of ||h + r - t||^2 is 2 * residual. Both residuals
+                        // are taken before any update, so shared entities (a corrupted
+                        // triple keeps one side of the positive) see consistent values.
+                        float step = static_cast<float>(2.0 * lr);
+                        vec::axpy(-step, residual_pos.data(), model.entity(pos_triple.head), dim);
+                        vec::axpy(step, residual_pos.data(), model.entity(pos_triple.tail), dim);
+                        vec::axpy(-step, residual_pos.data(), model.relation(pos_triple.relation), dim);
+                        vec::axpy(step, residual_neg.data(), model.relation(pos_triple.relation), dim);
+                        vec::axpy(step, residual_neg.data(), model.entity(neg_triple.head), dim);
+                        vec::axpy(-step, residual_neg.data(), model.entity(neg_triple.tail), dim);
                     }
                 }
             }
         }
 
         // Normalize entity embeddings after each epoch
-        for (auto& emb : model.entity_embeddings) {
-            normalize_vector(emb);
+        for (size_t i = 0; i < num_entities; ++i) {
+            vec::normalize(model.entity(i), dim, 1e-10f);
         }
 
         // Report progress every 10 epochs
@@ -3919,16 +3956,15 @@ std::vector<std::pair<DiscoveryEngine::Triple, double>> DiscoveryEngine::predict
     }
 
     std::vector<std::pair<Triple, double>> predictions;
-    size_t num_entities = model.entity_embeddings.size();
-    size_t num_relations = model.relation_embeddings.size();
+    size_t num_entities = model.num_entities();
+    size_t num_relations = model.idx_to_relation.size();
 
     // For efficiency, only consider high-degree entities as candidates
     // Use the index to get top entities by degree
     std::vector<size_t> candidate_entities;
     size_t max_candidates = std::min(size_t(100), num_entities);
 
-    for (size_t i = 0; i < std::min(index_.degree_ranked_nodes.size(), max_candidates); ++i) {
-        const auto& node_id = index_.degree_ranked_nodes[i].first;
+    for (const auto& node_id : index_.get_top_hubs(max_candidates)) {
         auto it = model.entity_to_idx.find(node_id);
         if (it != model.entity_to_idx.end()) {
             candidate_entities.push_back(it->second);
@@ -3944,9 +3980,30 @@ std::vector<std::pair<DiscoveryEngine::Triple, double>> DiscoveryEngine::predict
         }
     }
 
+    // Gather candidate rows so each (h, r) query scores every tail in one batch
+    size_t dim = model.dim;
+    size_t num_candidates = candidate_entities.size();
+    std::vector<float> candidate_rows(num_candidates * dim);
+    for (size_t c = 0; c < num_candidates; ++c) {
+        const float* row = model.entity(candidate_entities[c]);
+        std::copy(row, row + dim, candidate_rows.begin() + c * dim);
+    }
+
+    std::vector<float> query(dim);
+    std::vector<float> distances(num_relations * num_candidates);
+
     // Score candidate links
     for (size_t h : candidate_entities) {
-        for (size_t t : candidate_entities) {
+        for (size_t r = 0; r < num_relations; ++r) {
+            const float* head = model.entity(h);
+            std::copy(head, head + dim, query.begin());
+            vec::axpy(1.0f, model.relation(r), query.data(), dim);
+            vec::l2_squared_many(query.data(), candidate_rows.data(), num_candidates, dim,
+                                 distances.data() + r * num_candidates);
+        }
+
+        for (size_t c = 0; c < num_candidates; ++c) {
+            size_t t = candidate_entities[c];
             if (h == t) continue;
 
             for (size_t r = 0; r < num_relations; ++r) {
@@ -3954,7 +4011,7 @@ std::vector<std::pair<DiscoveryEngine::Triple, double>> DiscoveryEngine::predict
                 if (existing.count({h, r, t})) continue;
 
                 Triple candidate{h, r, t};
-                double dist = transe_score(model, candidate);
+                double dist = std::sqrt(static_cast<double>(distances[r * num_candidates + c]));
 
                 // Convert distance to plausibility score (lower distance = higher score)
                 // Use sigmoid-like transformation
@@ -3995,8 +4052,8 @@ std::vector<Insight> DiscoveryEngine::find_embedding_links() {
         return results;
     }
 
-    size_t num_entities = model.entity_embeddings.size() > 0 ?
-        model.entity_embeddings.size() : model.idx_to_entity.size();
+    size_t num_entities = model.num_entities() > 0 ?
+        model.num_entities() : model.idx_to_entity.size();
     size_t num_relations = model.idx_to_relation.size();
 
     if (num_entities < 2 || num_relations < 1) {
@@ -4015,8 +4072,8 @@ std::vector<Insight> DiscoveryEngine::find_embedding_links() {
     std::unordered_set<std::string> allowed_relations;
     if (config_.embedding_allowed_relations_top_k > 0) {
         std::vector<std::pair<std::string, size_t>> rel_counts;
-        rel_counts.reserve(index_.relation_to_edges.size());
-        for (const auto& [rel, edges] : index_.relation_to_edges) {
+        rel_counts.reserve(index_.relation_to_edges().size());
+        for (const auto& [rel, edges] : index_.relation_to_edges()) {
             rel_counts.emplace_back(rel, edges.size());
         }
         std::sort(rel_counts.begin(), rel_counts.end(),
@@ -4125,8 +4182,8 @@ std::vector<Insight> DiscoveryEngine::find_community_links() {
     report_progress("Community links", 0, 100);
 
     int s = config_.community_s_threshold;
-    auto it = index_.s_components.find(s);
-    if (it == index_.s_components.end() || it->second.size() < 2) {
+    auto it = index_.s_components().find(s);
+    if (it == index_.s_components().end() || it->second.size() < 2) {
         return results;
     }
 
@@ -4156,6 +4213,16 @@ std::vector<Insight> DiscoveryEngine::find_community_links() {
         component_nodes.push_back(std::move(top_nodes));
     }
 
+    const auto& cooccurrence = index_.cooccurrence();
+    std::vector<std::vector<CooccurrenceIndex::Entity>> component_entities;
+    component_entities.reserve(component_nodes.size());
+    for (const auto& nodes : component_nodes) {
+        std::vector<CooccurrenceIndex::Entity> entities;
+        entities.reserve(nodes.size());
+        for (const auto& id : nodes) entities.push_back(index_.cooccurrence_entity(id));
+        component_entities.push_back(std::move(entities));
+    }
+
     auto relation_signature = [&](const std::string& node_id, const std::set<std::string>& comp_edges) {
         std::unordered_set<std::string> rels;
         const auto* node = graph_.get_node(node_id);
@@ -4184,15 +4251,17 @@ std::vector<Insight> DiscoveryEngine::find_community_links() {
             const auto& comp_edges_a = components[i];
             const auto& comp_edges_b = components[j];
 
-            for (const auto& a : comp_a) {
-                for (const auto& b : comp_b) {
+            for (size_t ai = 0; ai < comp_a.size(); ++ai) {
+                const auto& a = comp_a[ai];
+                for (size_t bi = 0; bi < comp_b.size(); ++bi) {
+                    const auto& b = comp_b[bi];
                     checked++;
                     if (checked % 200 == 0 || checked == total_pairs) {
                         int pct = 5 + static_cast<int>(90.0 * checked / std::max<size_t>(1, total_pairs));
                         report_progress("Community links", pct, 100);
                     }
 
-                    if (index_.get_cooccurrence(a, b) > 0) continue;
+                    if (cooccurrence.count(component_entities[i][ai], component_entities[j][bi]) > 0) continue;
 
                     auto rel_a = relation_signature(a, comp_edges_a);
                     auto rel_b = relation_signature(b, comp_edges_b);
@@ -4255,7 +4324,7 @@ std::vector<Insight> DiscoveryEngine::find_author_reference_chains() {
     std::unordered_map<std::string, std::unordered_set<std::string>> adjacency;
     std::unordered_map<std::string, std::unordered_map<std::string, std::vector<std::string>>> support_edges;
 
-    for (const auto& edge : graph_.get_all_edges()) {
+    for (const auto& edge : graph_.edges_view()) {
         if (!looks_like_reference_relation(edge.relation)) continue;
 
         for (const auto& src : edge.sources) {
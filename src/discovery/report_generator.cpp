@@ -1051,7 +1051,7 @@ std::string ReportGenerator::generate_statistics_section(const InsightCollection
 
     std::stringstream ss;
 
-    auto stats = graph_.compute_statistics();
+    auto stats = graph_.compute_statistics(StatisticsTier::Cheap);
 
     if (config.markdown_format) {
         ss << "## Knowledge Graph Statistics\n\n";
@@ -2701,7 +2701,7 @@ std::string ReportGenerator::generate_html(const InsightCollection& insights, co
         counts[insight.type]++;
     }
 
-    auto stats = graph_.compute_statistics();
+    auto stats = graph_.compute_statistics(StatisticsTier::Cheap);
 
     // HTML Header with styling
     html << R"(<!DOCTYPE html>
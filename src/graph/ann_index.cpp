@@ -0,0 +1,425 @@
+#include "graph/ann_index.hpp"
+#include "util/vector_math.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <queue>
+#include <stdexcept>
+#include <unordered_set>
+
+namespace kg {
+
+namespace {
+
+/**
+ * Per-thread visited marks for graph traversal. Stamping with an epoch
+ * avoids clearing an O(n) array on every query.
+ */
+struct VisitedMarks {
+    std::vector<uint32_t> stamp;
+    uint32_t epoch = 0;
+
+    void prepare(size_t size) {
+        if (stamp.size() < size) stamp.resize(size, 0);
+        if (++epoch == 0) {
+            std::fill(stamp.begin(), stamp.end(), 0);
+            epoch = 1;
+        }
+    }
+
+    bool visit(uint32_t id) {
+        if (stamp[id] == epoch) return false;
+        stamp[id] = epoch;
+        return true;
+    }
+};
+
+VisitedMarks& visited_marks() {
+    thread_local VisitedMarks marks;
+    return marks;
+}
+
+uint64_t splitmix64(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+bool by_similarity_desc(const AnnNeighbor& a, const AnnNeighbor& b) {
+    if (a.similarity != b.similarity) return a.similarity > b.similarity;
+    return a.id < b.id;
+}
+
+double elapsed_ms(std::chrono::steady_clock::time_point since) {
+    return std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - since).count();
+}
+
+} // anonymous namespace
+
+// ==========================================
+// AnnMethod
+// ==========================================
+
+AnnMethod ann_method_from_string(const std::string& name) {
+    if (name == "exact") return AnnMethod::Exact;
+    if (name == "hnsw") return AnnMethod::Hnsw;
+    throw std::invalid_argument("Unknown ANN method: " + name + " (expected 'exact' or 'hnsw')");
+}
+
+std::string ann_method_to_string(AnnMethod method) {
+    switch (method) {
+        case AnnMethod::Exact: return "exact";
+        case AnnMethod::Hnsw: return "hnsw";
+    }
+    return "unknown";
+}
+
+// ==========================================
+// VectorIndex
+// ==========================================
+
+VectorIndex::VectorIndex(size_t dimension) : dimension_(dimension) {
+    if (dimension == 0) {
+        throw std::invalid_argument("Vector index dimension must be positive");
+    }
+}
+
+uint32_t VectorIndex::add(const float* vector) {
+    if (count_ >= std::numeric_limits<uint32_t>::max()) {
+        throw std::length_error("Vector index is full");
+    }
+
+    size_t offset = data_.size();
+    data_.insert(data_.end(), vector, vector + dimension_);
+    vec::normalize(data_.data() + offset, dimension_);
+
+    uint32_t id = static_cast<uint32_t>(count_++);
+    on_add(id);
+    return id;
+}
+
+uint32_t VectorIndex::add(const std::vector<float>& vector) {
+    if (vector.size() != dimension_) {
+        throw std::invalid_argument("Vector dimension " + std::to_string(vector.size()) +
+                                    " does not match index dimension " +
+                                    std::to_string(dimension_));
+    }
+    return add(vector.data());
+}
+
+std::vector<AnnNeighbor> VectorIndex::search_threshold(
+    const float* query, float threshold, size_t k) const {
+    auto hits = search(query, k == 0 ? count_ : k);
+    hits.erase(std::remove_if(hits.begin(), hits.end(),
+                              [threshold](const AnnNeighbor& n) { return n.similarity < threshold; }),
+               hits.end());
+    return hits;
+}
+
+float VectorIndex::similarity(const float* a, const float* b) const {
+    return vec::dot(a, b, dimension_);
+}
+
+// ==========================================
+// ExactVectorIndex
+// ==========================================
+
+std::vector<AnnNeighbor> ExactVectorIndex::search(const float* query, size_t k) const {
+    std::vector<float> sims(count_);
+    vec::dot_many(query, data_.data(), count_, dimension_, sims.data());
+
+    std::vector<AnnNeighbor> hits;
+    hits.reserve(count_);
+    for (uint32_t id = 0; id < count_; ++id) {
+        hits.push_back({id, sims[id]});
+    }
+
+    k = std::min(k, hits.size());
+    std::partial_sort(hits.begin(), hits.begin() + k, hits.end(), by_similarity_desc);
+    hits.resize(k);
+    return hits;
+}
+
+std::vector<AnnNeighbor> ExactVectorIndex::search_threshold(
+    const float* query, float threshold, size_t k) const {
+    std::vector<float> sims(count_);
+    vec::dot_many(query, data_.data(), count_, dimension_, sims.data());
+
+    std::vector<AnnNeighbor> hits;
+    for (uint32_t id = 0; id < count_; ++id) {
+        if (sims[id] >= threshold) hits.push_back({id, sims[id]});
+    }
+
+    std::sort(hits.begin(), hits.end(), by_similarity_desc);
+    if (k != 0 && hits.size() > k) hits.resize(k);
+    return hits;
+}
+
+// ==========================================
+// HnswVectorIndex
+// ==========================================
+
+HnswVectorIndex::HnswVectorIndex(size_t dimension, const AnnConfig& config)
+    : VectorIndex(dimension),
+      m_(std::max<size_t>(config.hnsw_m, 2)),
+      m0_(2 * m_),
+      ef_construction_(std::max(config.hnsw_ef_construction, m_)),
+      ef_search_(std::max<size_t>(config.hnsw_ef_search, 1)),
+      level_mult_(1.0 / std::log(static_cast<double>(m_))),
+      rng_state_(config.seed) {}
+
+std::vector<HnswVectorIndex::Candidate> HnswVectorIndex::search_layer(
+    const float* query, uint32_t entry, size_t ef, int layer) const {
+    auto& visited = visited_marks();
+    visited.prepare(count_);
+
+    // Frontier ordered nearest-first; results kept as a max-heap of the ef best
+    std::priority_queue<Candidate, std::vector<Candidate>, std::greater<Candidate>> frontier;
+    std::priority_queue<Candidate> results;
+
+    float entry_dist = 1.0f - similarity(query, vector(entry));
+    visited.visit(entry);
+    frontier.emplace(entry_dist, entry);
+    results.emplace(entry_dist, entry);
+
+    while (!frontier.empty()) {
+        auto [dist, current] = frontier.top();
+        if (dist > results.top().first && results.size() >= ef) break;
+        frontier.pop();
+
+        for (uint32_t neighbor : links_[current][layer]) {
+            if (!visited.visit(neighbor)) continue;
+            float d = 1.0f - similarity(query, vector(neighbor));
+            if (results.size() < ef || d < results.top().first) {
+                frontier.emplace(d, neighbor);
+                results.emplace(d, neighbor);
+                if (results.size() > ef) results.pop();
+            }
+        }
+    }
+
+    std::vector<Candidate> out(results.size());
+    for (size_t i = out.size(); i-- > 0;) {
+        out[i] = results.top();
+        results.pop();
+    }
+    return out;
+}
+
+uint32_t HnswVectorIndex::greedy_descend(const float* query, uint32_t entry,
+                                         int from_layer, int to_layer) const {
+    float best = 1.0f - similarity(query, vector(entry));
+    for (int layer = from_layer; layer >= to_layer; --layer) {
+        bool improved = true;
+        while (improved) {
+            improved = false;
+            for (uint32_t neighbor : links_[entry][layer]) {
+                float d = 1.0f - similarity(query, vector(neighbor));
+                if (d < best) {
+                    best = d;
+                    entry = neighbor;
+                    improved = true;
+                }
+            }
+        }
+    }
+    return entry;
+}
+
+std::vector<uint32_t> HnswVectorIndex::select_neighbors(
+    const std::vector<Candidate>& candidates, size_t m) const {
+    // Diversity heuristic: keep a candidate only if it is closer to the base
+    // than to every neighbour already kept, then top up with the pruned ones
+    // so dense clusters of near-duplicates stay well connected.
+    std::vector<uint32_t> selected;
+    std::vector<uint32_t> pruned;
+    for (const auto& [dist, id] : candidates) {
+        if (selected.size() >= m) break;
+        bool diverse = true;
+        for (uint32_t kept : selected) {
+            if (1.0f - similarity(vector(id), vector(kept)) < dist) {
+                diverse = false;
+                break;
+            }
+        }
+        (diverse ? selected : pruned).push_back(id);
+    }
+    for (size_t i = 0; i < pruned.size() && selected.size() < m; ++i) {
+        selected.push_back(pruned[i]);
+    }
+    return selected;
+}
+
+void HnswVectorIndex::shrink_links(uint32_t id, int layer) {
+    auto& links = links_[id][layer];
+    std::vector<Candidate> candidates;
+    candidates.reserve(links.size());
+    for (uint32_t neighbor : links) {
+        candidates.emplace_back(1.0f - similarity(vector(id), vector(neighbor)), neighbor);
+    }
+    std::sort(candidates.begin(), candidates.end());
+    links = select_neighbors(candidates, layer == 0 ? m0_ : m_);
+}
+
+void HnswVectorIndex::on_add(uint32_t id) {
+    double u = (static_cast<double>(splitmix64(rng_state_) >> 11) + 1.0) * 0x1.0p-53;
+    int level = static_cast<int>(-std::log(u) * level_mult_);
+    links_.emplace_back(level + 1);
+
+    if (max_level_ < 0) {
+        entry_point_ = id;
+        max_level_ = level;
+        return;
+    }
+
+    const float* q = vector(id);
+    uint32_t entry = entry_point_;
+    if (max_level_ > level) {
+        entry = greedy_descend(q, entry, max_level_, level + 1);
+    }
+
+    for (int layer = std::min(level, max_level_); layer >= 0; --layer) {
+        auto candidates = search_layer(q, entry, ef_construction_, layer);
+        size_t max_links = layer == 0 ? m0_ : m_;
+        links_[id][layer] = select_neighbors(candidates, m_);
+        for (uint32_t neighbor : links_[id][layer]) {
+            auto& back = links_[neighbor][layer];
+            back.push_back(id);
+            if (back.size() > max_links) shrink_links(neighbor, layer);
+        }
+        entry = candidates.front().second;
+    }
+
+    if (level > max_level_) {
+        entry_point_ = id;
+        max_level_ = level;
+    }
+}
+
+std::vector<AnnNeighbor> HnswVectorIndex::query(const float* query, size_t ef, size_t k) const {
+    std::vector<AnnNeighbor> hits;
+    if (count_ == 0 || k == 0) return hits;
+
+    uint32_t entry = max_level_ > 0
+        ? greedy_descend(query, entry_point_, max_level_, 1)
+        : entry_point_;
+    auto candidates = search_layer(query, entry, std::max(ef, k), 0);
+
+    hits.reserve(std::min(k, candidates.size()));
+    for (const auto& [dist, id] : candidates) {
+        if (hits.size() >= k) break;
+        hits.push_back({id, 1.0f - dist});
+    }
+    std::sort(hits.begin(), hits.end(), by_similarity_desc);
+    return hits;
+}
+
+std::vector<AnnNeighbor> HnswVectorIndex::search(const float* query, size_t k) const {
+    return this->query(query, ef_search_, k);
+}
+
+std::vector<AnnNeighbor> HnswVectorIndex::search_threshold(
+    const float* query, float threshold, size_t k) const {
+    size_t limit = k == 0 ? ef_search_ : k;
+    auto hits = this->query(query, std::max(ef_search_, limit), limit);
+    hits.erase(std::remove_if(hits.begin(), hits.end(),
+                              [threshold](const AnnNeighbor& n) { return n.similarity < threshold; }),
+               hits.end());
+    return hits;
+}
+
+// ==========================================
+// Factory
+// ==========================================
+
+std::unique_ptr<VectorIndex> make_vector_index(
+    size_t dimension, size_t expected_size, const AnnConfig& config) {
+    if (config.method == AnnMethod::Exact || expected_size < config.exact_below) {
+        return std::make_unique<ExactVectorIndex>(dimension);
+    }
+    return std::make_unique<HnswVectorIndex>(dimension, config);
+}
+
+// ==========================================
+// Evaluation
+// ==========================================
+
+nlohmann::json AnnReport::to_json() const {
+    nlohmann::json j;
+    j["method"] = method;
+    j["num_vectors"] = num_vectors;
+    j["dimension"] = dimension;
+    j["num_queries"] = num_queries;
+    j["k"] = k;
+    j["recall_at_k"] = recall_at_k;
+    j["build_ms"] = build_ms;
+    j["exact_build_ms"] = exact_build_ms;
+    j["mean_query_us"] = mean_query_us;
+    j["exact_mean_query_us"] = exact_mean_query_us;
+    j["speedup"] = mean_query_us > 0.0 ? exact_mean_query_us / mean_query_us : 0.0;
+    return j;
+}
+
+AnnReport evaluate_vector_index(const std::vector<std::vector<float>>& vectors,
+                                const AnnConfig& config,
+                                size_t num_queries,
+                                size_t k) {
+    AnnReport report;
+    report.method = ann_method_to_string(config.method);
+    report.num_vectors = vectors.size();
+    report.k = k;
+    if (vectors.empty() || num_queries == 0 || k == 0) return report;
+
+    size_t dimension = vectors.front().size();
+    report.dimension = dimension;
+
+    // Build both directly so exact_below does not short-circuit the comparison
+    auto start = std::chrono::steady_clock::now();
+    ExactVectorIndex exact(dimension);
+    for (const auto& v : vectors) exact.add(v);
+    report.exact_build_ms = elapsed_ms(start);
+
+    start = std::chrono::steady_clock::now();
+    std::unique_ptr<VectorIndex> approx;
+    if (config.method == AnnMethod::Exact) {
+        approx = std::make_unique<ExactVectorIndex>(dimension);
+    } else {
+        approx = std::make_unique<HnswVectorIndex>(dimension, config);
+    }
+    for (const auto& v : vectors) approx->add(v);
+    report.build_ms = elapsed_ms(start);
+
+    num_queries = std::min(num_queries, vectors.size());
+    report.num_queries = num_queries;
+
+    double recall_sum = 0.0;
+    double exact_us = 0.0;
+    double approx_us = 0.0;
+    for (size_t q = 0; q < num_queries; ++q) {
+        const float* query = exact.vector(static_cast<uint32_t>(q * vectors.size() / num_queries));
+
+        start = std::chrono::steady_clock::now();
+        auto truth = exact.search(query, k);
+        exact_us += elapsed_ms(start) * 1000.0;
+
+        start = std::chrono::steady_clock::now();
+        auto found = approx->search(query, k);
+        approx_us += elapsed_ms(start) * 1000.0;
+
+        std::unordered_set<uint32_t> expected;
+        for (const auto& n : truth) expected.insert(n.id);
+        size_t hits = 0;
+        for (const auto& n : found) hits += expected.count(n.id);
+        recall_sum += truth.empty() ? 1.0 : static_cast<double>(hits) / truth.size();
+    }
+
+    report.recall_at_k = recall_sum / num_queries;
+    report.exact_mean_query_us = exact_us / num_queries;
+    report.mean_query_us = approx_us / num_queries;
+    return report;
+}
+
+} // namespace kg
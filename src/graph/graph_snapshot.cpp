@@ -0,0 +1,398 @@
+#include "graph/graph_snapshot.hpp"
+#include <limits>
+#include <stdexcept>
+
+namespace kg {
+
+namespace {
+
+constexpr SectionFile::Magic SNAPSHOT_MAGIC = {'K', 'G', 'S', 'N', 'A', 'P', '\r', '\n'};
+
+enum SectionId : uint32_t {
+    StringOffsets = 1,
+    StringData,
+    NodeIds,
+    NodeLabels,
+    NodePropertyOffsets,
+    NodeProperties,
+    NodeEmbeddingOffsets,
+    NodeEmbeddings,
+    NodeEdgeOffsets,
+    NodeEdges,
+    EdgeNodeOffsets,
+    EdgeNodes,
+    EdgeSourceOffsets,
+    EdgeSources,
+    EdgeTargetOffsets,
+    EdgeTargets,
+    EdgeIds,
+    EdgeRelations,
+    EdgeDocuments,
+    EdgeChunks,
+    EdgePages,
+    EdgeConfidences,
+    EdgePropertyOffsets,
+    EdgeProperties,
+    Counts,                                            // num_nodes, num_edges, num_strings
+    SectionCount
+};
+
+[[noreturn]] void corrupt(const std::string& what) {
+    throw std::runtime_error("Corrupt graph snapshot: " + what);
+}
+
+void check_offsets(const char* name, const uint64_t* offsets, size_t rows, size_t values) {
+    if (offsets[0] != 0 || offsets[rows] != values) {
+        corrupt(std::string(name) + " offsets do not span their values");
+    }
+    for (size_t i = 0; i < rows; ++i) {
+        if (offsets[i] > offsets[i + 1]) {
+            corrupt(std::string(name) + " offsets are not monotonic");
+        }
+    }
+}
+
+void check_range(const char* name, const uint32_t* values, size_t count, size_t bound) {
+    for (size_t i = 0; i < count; ++i) {
+        if (values[i] >= bound) {
+            corrupt(std::string(name) + " index out of range");
+        }
+    }
+}
+
+} // anonymous namespace
+
+// ==========================================
+// GraphSnapshot
+// ==========================================
+
+GraphSnapshot::GraphSnapshot(const std::string& filename)
+    : file_(filename, SNAPSHOT_MAGIC, VERSION, "graph snapshot") {
+    auto counts = file_.section<uint64_t>(Counts, 3);
+    if (counts[0] >= INVALID_ID || counts[1] >= INVALID_ID ||
+        counts[2] > std::numeric_limits<uint32_t>::max()) {
+        corrupt("counts exceed handle range");
+    }
+    num_nodes_ = counts[0];
+    num_edges_ = counts[1];
+    num_strings_ = counts[2];
+
+    string_offsets_ = file_.section<uint64_t>(StringOffsets, num_strings_ + 1);
+    string_data_ = file_.section<char>(StringData, string_offsets_[num_strings_]);
+
+    node_ids_ = file_.section<uint32_t>(NodeIds, num_nodes_);
+    node_labels_ = file_.section<uint32_t>(NodeLabels, num_nodes_);
+    node_property_offsets_ = file_.section<uint64_t>(NodePropertyOffsets, num_nodes_ + 1);
+    node_properties_ = file_.section<uint32_t>(NodeProperties, node_property_offsets_[num_nodes_]);
+    node_embedding_offsets_ = file_.section<uint64_t>(NodeEmbeddingOffsets, num_nodes_ + 1);
+    node_embeddings_ = file_.section<float>(NodeEmbeddings, node_embedding_offsets_[num_nodes_]);
+
+    node_edge_offsets_ = file_.section<uint64_t>(NodeEdgeOffsets, num_nodes_ + 1);
+    node_edges_ = file_.section<uint32_t>(NodeEdges, node_edge_offsets_[num_nodes_]);
+    edge_node_offsets_ = file_.section<uint64_t>(EdgeNodeOffsets, num_edges_ + 1);
+    edge_nodes_ = file_.section<uint32_t>(EdgeNodes, edge_node_offsets_[num_edges_]);
+
+    edge_source_offsets_ = file_.section<uint64_t>(EdgeSourceOffsets, num_edges_ + 1);
+    edge_sources_ = file_.section<uint32_t>(EdgeSources, edge_source_offsets_[num_edges_]);
+    edge_target_offsets_ = file_.section<uint64_t>(EdgeTargetOffsets, num_edges_ + 1);
+    edge_targets_ = file_.section<uint32_t>(EdgeTargets, edge_target_offsets_[num_edges_]);
+    edge_ids_ = file_.section<uint32_t>(EdgeIds, num_edges_);
+    edge_relations_ = file_.section<uint32_t>(EdgeRelations, num_edges_);
+    edge_documents_ = file_.section<uint32_t>(EdgeDocuments, num_edges_);
+    edge_chunks_ = file_.section<uint32_t>(EdgeChunks, num_edges_);
+    edge_pages_ = file_.section<int32_t>(EdgePages, num_edges_);
+    edge_confidences_ = file_.section<double>(EdgeConfidences, num_edges_);
+    edge_property_offsets_ = file_.section<uint64_t>(EdgePropertyOffsets, num_edges_ + 1);
+    edge_properties_ = file_.section<uint32_t>(EdgeProperties, edge_property_offsets_[num_edges_]);
+}
+
+bool GraphSnapshot::is_snapshot_file(const std::string& filename) {
+    return SectionFile::has_magic(filename, SNAPSHOT_MAGIC);
+}
+
+void GraphSnapshot::validate() const {
+    check_offsets("string", string_offsets_.data, num_strings_, string_data_.size);
+    check_offsets("node property", node_property_offsets_.data, num_nodes_, node_properties_.size);
+    check_offsets("node embedding", node_embedding_offsets_.data, num_nodes_, node_embeddings_.size);
+    check_offsets("node incidence", node_edge_offsets_.data, num_nodes_, node_edges_.size);
+    check_offsets("edge incidence", edge_node_offsets_.data, num_edges_, edge_nodes_.size);
+    check_offsets("edge source", edge_source_offsets_.data, num_edges_, edge_sources_.size);
+    check_offsets("edge target", edge_target_offsets_.data, num_edges_, edge_targets_.size);
+    check_offsets("edge property", edge_property_offsets_.data, num_edges_, edge_properties_.size);
+
+    check_range("node id", node_ids_.data, node_ids_.size, num_strings_);
+    check_range("node label", node_labels_.data, node_labels_.size, num_strings_);
+    check_range("node property", node_properties_.data, node_properties_.size, num_strings_);
+    check_range("node incidence", node_edges_.data, node_edges_.size, num_edges_);
+    check_range("edge incidence", edge_nodes_.data, edge_nodes_.size, num_nodes_);
+    check_range("edge source", edge_sources_.data, edge_sources_.size, num_nodes_);
+    check_range("edge target", edge_targets_.data, edge_targets_.size, num_nodes_);
+    check_range("edge id", edge_ids_.data, edge_ids_.size, num_strings_);
+    check_range("edge relation", edge_relations_.data, edge_relations_.size, num_strings_);
+    check_range("edge document", edge_documents_.data, edge_documents_.size, num_strings_);
+    check_range("edge chunk", edge_chunks_.data, edge_chunks_.size, num_strings_);
+    check_range("edge property", edge_properties_.data, edge_properties_.size, num_strings_);
+
+    for (size_t n = 0; n < num_nodes_; ++n) {
+        if ((node_property_offsets_[n + 1] - node_property_offsets_[n]) % 2 != 0) {
+            corrupt("node property list has an unpaired key");
+        }
+    }
+    for (size_t e = 0; e < num_edges_; ++e) {
+        if ((edge_property_offsets_[e + 1] - edge_property_offsets_[e]) % 2 != 0) {
+            corrupt("edge property list has an unpaired key");
+        }
+    }
+}
+
+std::string_view GraphSnapshot::string(uint32_t index) const {
+    uint64_t begin = string_offsets_[index];
+    return {string_data_.data + begin, static_cast<size_t>(string_offsets_[index + 1] - begin)};
+}
+
+IdSpan<uint32_t> GraphSnapshot::node_properties(NodeId n) const {
+    return row(node_property_offsets_, node_properties_, n);
+}
+
+IdSpan<float> GraphSnapshot::node_embedding(NodeId n) const {
+    return {node_embeddings_.data + node_embedding_offsets_[n],
+            node_embeddings_.data + node_embedding_offsets_[n + 1]};
+}
+
+IdSpan<EdgeId> GraphSnapshot::edges_of(NodeId n) const {
+    return row(node_edge_offsets_, node_edges_, n);
+}
+
+IdSpan<NodeId> GraphSnapshot::nodes_of(EdgeId e) const {
+    return row(edge_node_offsets_, edge_nodes_, e);
+}
+
+IdSpan<NodeId> GraphSnapshot::sources_of(EdgeId e) const {
+    return row(edge_source_offsets_, edge_sources_, e);
+}
+
+IdSpan<NodeId> GraphSnapshot::targets_of(EdgeId e) const {
+    return row(edge_target_offsets_, edge_targets_, e);
+}
+
+IdSpan<uint32_t> GraphSnapshot::edge_properties(EdgeId e) const {
+    return row(edge_property_offsets_, edge_properties_, e);
+}
+
+IncidenceCSR GraphSnapshot::incidence() const {
+    IncidenceCSR csr;
+    csr.node_offsets.assign(node_edge_offsets_.data, node_edge_offsets_.data + node_edge_offsets_.size);
+    csr.node_edges.assign(node_edges_.data, node_edges_.data + node_edges_.size);
+    csr.edge_offsets.assign(edge_node_offsets_.data, edge_node_offsets_.data + edge_node_offsets_.size);
+    csr.edge_nodes.assign(edge_nodes_.data, edge_nodes_.data + edge_nodes_.size);
+    return csr;
+}
+
+// ==========================================
+// Hypergraph binary import/export
+// ==========================================
+
+void Hypergraph::export_to_binary(const std::string& filename) const {
+    // Dense renumbering of live handles
+    std::vector<NodeId> node_map(node_slots_.size(), INVALID_ID);
+    std::vector<NodeId> live_node_order;
+    live_node_order.reserve(live_nodes_);
+    for (NodeId id = 0; id < node_slots_.size(); ++id) {
+        if (!node_slots_[id].alive) continue;
+        node_map[id] = static_cast<NodeId>(live_node_order.size());
+        live_node_order.push_back(id);
+    }
+    std::vector<EdgeId> edge_map(edge_slots_.size(), INVALID_ID);
+    std::vector<EdgeId> live_edge_order;
+    live_edge_order.reserve(live_edges_);
+    for (EdgeId id = 0; id < edge_slots_.size(); ++id) {
+        if (!edge_slots_[id].alive) continue;
+        edge_map[id] = static_cast<EdgeId>(live_edge_order.size());
+        live_edge_order.push_back(id);
+    }
+
+    StringTableBuilder strings;
+    auto append_properties = [&](const std::map<std::string, std::string>& properties,
+                                 std::vector<uint64_t>& offsets, std::vector<uint32_t>& values) {
+        for (const auto& [key, value] : properties) {
+            values.push_back(strings.intern(key));
+            values.push_back(strings.intern(value));
+        }
+        offsets.push_back(values.size());
+    };
+
+    // Node columns and node -> edge rows
+    std::vector<uint32_t> node_ids, node_labels, node_properties, node_edges;
+    std::vector<uint64_t> node_property_offsets{0}, node_embedding_offsets{0}, node_edge_offsets{0};
+    std::vector<float> node_embeddings;
+    node_ids.reserve(live_node_order.size());
+    node_labels.reserve(live_node_order.size());
+    for (NodeId id : live_node_order) {
+        const auto& slot = node_slots_[id];
+        node_ids.push_back(strings.intern(slot.node.id));
+        node_labels.push_back(strings.intern(slot.node.label));
+        append_properties(slot.node.properties, node_property_offsets, node_properties);
+        node_embeddings.insert(node_embeddings.end(), slot.node.embedding.begin(), slot.node.embedding.end());
+        node_embedding_offsets.push_back(node_embeddings.size());
+        for (EdgeId edge_id : slot.edges) {
+            node_edges.push_back(edge_map[edge_id]);
+        }
+        node_edge_offsets.push_back(node_edges.size());
+    }
+
+    // Edge columns and edge -> node rows
+    std::vector<uint32_t> edge_nodes, edge_sources, edge_targets, edge_properties;
+    std::vector<uint32_t> edge_ids, edge_relations, edge_documents, edge_chunks;
+    std::vector<uint64_t> edge_node_offsets{0}, edge_source_offsets{0}, edge_target_offsets{0};
+    std::vector<uint64_t> edge_property_offsets{0};
+    std::vector<int32_t> edge_pages;
+    std::vector<double> edge_confidences;
+    for (EdgeId id : live_edge_order) {
+        const auto& slot = edge_slots_[id];
+        // Renumbering preserves handle order, so members stay sorted
+        for (NodeId n : slot.members) edge_nodes.push_back(node_map[n]);
+        edge_node_offsets.push_back(edge_nodes.size());
+        for (NodeId n : slot.sources) edge_sources.push_back(node_map[n]);
+        edge_source_offsets.push_back(edge_sources.size());
+        for (NodeId n : slot.targets) edge_targets.push_back(node_map[n]);
+        edge_target_offsets.push_back(edge_targets.size());
+
+        edge_ids.push_back(strings.intern(slot.edge.id));
+        edge_relations.push_back(strings.intern(slot.edge.relation));
+        edge_documents.push_back(strings.intern(slot.edge.source_document));
+        edge_chunks.push_back(strings.intern(slot.edge.source_chunk_id));
+        edge_pages.push_back(slot.edge.source_page);
+        edge_confidences.push_back(slot.edge.confidence);
+        append_properties(slot.edge.properties, edge_property_offsets, edge_properties);
+    }
+
+    std::vector<uint64_t> counts{live_node_order.size(), live_edge_order.size(), strings.size()};
+
+    SectionFileWriter writer;
+    writer.add(Counts, counts);
+    writer.add(StringOffsets, strings.offsets());
+    writer.add(StringData, strings.data());
+    writer.add(NodeIds, node_ids);
+    writer.add(NodeLabels, node_labels);
+    writer.add(NodePropertyOffsets, node_property_offsets);
+    writer.add(NodeProperties, node_properties);
+    writer.add(NodeEmbeddingOffsets, node_embedding_offsets);
+    writer.add(NodeEmbeddings, node_embeddings);
+    writer.add(NodeEdgeOffsets, node_edge_offsets);
+    writer.add(NodeEdges, node_edges);
+    writer.add(EdgeNodeOffsets, edge_node_offsets);
+    writer.add(EdgeNodes, edge_nodes);
+    writer.add(EdgeSourceOffsets, edge_source_offsets);
+    writer.add(EdgeSources, edge_sources);
+    writer.add(EdgeTargetOffsets, edge_target_offsets);
+    writer.add(EdgeTargets, edge_targets);
+    writer.add(EdgeIds, edge_ids);
+    writer.add(EdgeRelations, edge_relations);
+    writer.add(EdgeDocuments, edge_documents);
+    writer.add(EdgeChunks, edge_chunks);
+    writer.add(EdgePages, edge_pages);
+    writer.add(EdgeConfidences, edge_confidences);
+    writer.add(EdgePropertyOffsets, edge_property_offsets);
+    writer.add(EdgeProperties, edge_properties);
+
+    writer.write(filename, SNAPSHOT_MAGIC, GraphSnapshot::VERSION);
+}
+
+Hypergraph Hypergraph::from_snapshot(const GraphSnapshot& snapshot) {
+    snapshot.validate();
+
+    Hypergraph graph;
+    size_t num_nodes = snapshot.num_nodes();
+    size_t num_edges = snapshot.num_edges();
+    graph.node_slots_.resize(num_nodes);
+    graph.edge_slots_.resize(num_edges);
+    graph.node_lookup_.reserve(num_nodes);
+    graph.edge_lookup_.reserve(num_edges);
+
+    auto read_properties = [&](IdSpan<uint32_t> pairs, std::map<std::string, std::string>& out) {
+        // Written in key order, so every insert lands at the end
+        for (size_t i = 0; i + 1 < pairs.size(); i += 2) {
+            out.emplace_hint(out.end(), snapshot.string(pairs[i]), snapshot.string(pairs[i + 1]));
+        }
+    };
+
+    for (NodeId id = 0; id < num_nodes; ++id) {
+        auto& slot = graph.node_slots_[id];
+        slot.alive = true;
+        slot.node.id = snapshot.node_id(id);
+        slot.node.label = snapshot.node_label(id);
+        read_properties(snapshot.node_properties(id), slot.node.properties);
+        auto embedding = snapshot.node_embedding(id);
+        slot.node.embedding.assign(embedding.begin(), embedding.end());
+        auto edges = snapshot.edges_of(id);
+        slot.edges.assign(edges.begin(), edges.end());
+        slot.node.degree = static_cast<int>(slot.edges.size());
+
+        if (!graph.node_lookup_.emplace(slot.node.id, id).second) {
+            corrupt("duplicate node id " + slot.node.id);
+        }
+    }
+
+    for (EdgeId id = 0; id < num_edges; ++id) {
+        auto& slot = graph.edge_slots_[id];
+        slot.alive = true;
+        auto sources = snapshot.sources_of(id);
+        auto targets = snapshot.targets_of(id);
+        auto members = snapshot.nodes_of(id);
+        slot.sources.assign(sources.begin(), sources.end());
+        slot.targets.assign(targets.begin(), targets.end());
+        slot.members.assign(members.begin(), members.end());
+
+        auto& edge = slot.edge;
+        edge.id = snapshot.edge_id(id);
+        edge.relation = snapshot.edge_relation(id);
+        edge.source_document = snapshot.edge_document(id);
+        edge.source_chunk_id = snapshot.edge_chunk(id);
+        edge.source_page = snapshot.edge_page(id);
+        edge.confidence = snapshot.edge_confidence(id);
+        read_properties(snapshot.edge_properties(id), edge.properties);
+        edge.sources.reserve(sources.size());
+        for (NodeId n : sources) edge.sources.push_back(graph.node_slots_[n].node.id);
+        edge.targets.reserve(targets.size());
+        for (NodeId n : targets) edge.targets.push_back(graph.node_slots_[n].node.id);
+
+        if (!graph.edge_lookup_.emplace(edge.id, id).second) {
+            corrupt("duplicate edge id " + edge.id);
+        }
+
+        size_t size = edge.size();
+        if (graph.edge_size_counts_.size() <= size) graph.edge_size_counts_.resize(size + 1, 0);
+        ++graph.edge_size_counts_[size];
+        graph.total_edge_size_ += size;
+    }
+
+    for (auto& slot : graph.node_slots_) {
+        slot.node.incident_edges.reserve(slot.edges.size());
+        for (EdgeId edge_id : slot.edges) {
+            slot.node.incident_edges.push_back(graph.edge_slots_[edge_id].edge.id);
+        }
+
+        size_t degree = slot.edges.size();
+        if (graph.degree_counts_.size() <= degree) graph.degree_counts_.resize(degree + 1, 0);
+        ++graph.degree_counts_[degree];
+        graph.total_degree_ += degree;
+    }
+
+    graph.live_nodes_ = num_nodes;
+    graph.live_edges_ = num_edges;
+    graph.generation_ = 1;
+    return graph;
+}
+
+Hypergraph Hypergraph::load_from_binary(const std::string& filename) {
+    return from_snapshot(GraphSnapshot(filename));
+}
+
+Hypergraph Hypergraph::load(const std::string& filename, const JsonLoadOptions& options) {
+    if (GraphSnapshot::is_snapshot_file(filename)) {
+        return load_from_binary(filename);
+    }
+    return load_from_json(filename, options);
+}
+
+} // namespace kg
@@ -1,4 +1,6 @@
 #include "graph/hypergraph.hpp"
+#include "util/parallel.hpp"
+#include "util/vector_math.hpp"
 #include <algorithm>
 #include <queue>
 #include <stack>
@@ -6,6 +8,7 @@
 #include <fstream>
 #include <sstream>
 #include <numeric>
+#include <random>
 #include <stdexcept>
 
 namespace kg {
@@ -27,6 +30,19 @@ nlohmann::json HyperNode::to_json() const {
     return j;
 }
 
+void HyperNode::write_json(JsonWriter& writer) const {
+    writer.begin_object();
+    writer.member("id", id);
+    writer.member("label", label);
+    writer.member("degree", degree);
+    writer.member("properties", properties);
+    writer.member("incident_edges", incident_edges);
+    if (!embedding.empty()) {
+        writer.member("embedding", embedding);
+    }
+    writer.end_object();
+}
+
 HyperNode HyperNode::from_json(const nlohmann::json& j) {
     HyperNode node;
     node.id = j.at("id").get<std::string>();
@@ -105,6 +121,29 @@ nlohmann::json HyperEdge::to_json() const {
     return j;
 }
 
+void HyperEdge::write_json(JsonWriter& writer, bool include_metadata) const {
+    writer.begin_object();
+    writer.member("id", id);
+    writer.member("sources", sources);
+    writer.member("relation", relation);
+    writer.member("targets", targets);
+    writer.member("confidence", confidence);
+
+    if (include_metadata) {
+        writer.member("properties", properties);
+        if (!source_document.empty()) {
+            writer.member("source_document", source_document);
+        }
+        if (!source_chunk_id.empty()) {
+            writer.member("source_chunk_id", source_chunk_id);
+        }
+        if (source_page >= 0) {
+            writer.member("source_page", source_page);
+        }
+    }
+    writer.end_object();
+}
+
 HyperEdge HyperEdge::from_json(const nlohmann::json& j) {
     HyperEdge edge;
     edge.id = j.at("id").get<std::string>();
@@ -149,6 +188,16 @@ nlohmann::json HypergraphStatistics::to_json() const {
     j["num_pairs_overlap_2"] = num_pairs_overlap_2;
     j["num_pairs_overlap_3"] = num_pairs_overlap_3;
 
+    if (overlap_estimated) {
+        j["overlap_estimate"] = {
+            {"sample_size", overlap_sample_size},
+            {"confidence", 0.95},
+            {"overlap_1_margin", overlap_1_margin},
+            {"overlap_2_margin", overlap_2_margin},
+            {"overlap_3_margin", overlap_3_margin}
+        };
+    }
+
     if (power_law_exponent.has_value()) {
         j["power_law_exponent"] = power_law_exponent.value();
     }
@@ -159,6 +208,19 @@ nlohmann::json HypergraphStatistics::to_json() const {
     return j;
 }
 
+// ==========================================
+// MergeResult Implementation
+// ==========================================
+
+nlohmann::json MergeResult::to_json() const {
+    nlohmann::json j;
+    j["edges_merged"] = edges_merged;
+    j["nodes_added"] = nodes_added;
+    j["duplicate_edges"] = duplicate_edges;
+    j["self_loops"] = self_loops;
+    return j;
+}
+
 // ==========================================
 // PathSearchResult Implementation
 // ==========================================
@@ -187,54 +249,103 @@ nlohmann::json PathSearchResult::to_json() const {
 // Hypergraph Implementation
 // ==========================================
 
+NodeId Hypergraph::intern_node(const std::string& normalized_id, const std::string& label) {
+    auto it = node_lookup_.find(normalized_id);
+    if (it != node_lookup_.end()) {
+        return it->second;
+    }
+
+    if (node_slots_.size() >= INVALID_ID) {
+        throw std::length_error("Hypergraph node capacity exceeded");
+    }
+
+    NodeId id = static_cast<NodeId>(node_slots_.size());
+    NodeSlot slot;
+    slot.node.id = normalized_id;
+    slot.node.label = label;
+    slot.alive = true;
+    node_slots_.push_back(std::move(slot));
+    node_lookup_.emplace(normalized_id, id);
+    ++live_nodes_;
+    ++generation_;
+
+    if (degree_counts_.empty()) degree_counts_.resize(1, 0);
+    ++degree_counts_[0];
+
+    observers_.notify([&](HypergraphObserver& o) { o.on_node_added(*this, id); });
+    return id;
+}
+
 std::string Hypergraph::add_hyperedge(const HyperEdge& edge) {
-    HyperEdge new_edge = edge;
+    return insert_hyperedge(edge, false);
+}
 
-    // Generate ID if not provided
+std::string Hypergraph::insert_hyperedge(HyperEdge new_edge, bool normalized) {
+    // Generate ID if not provided, skipping IDs already present (e.g. loaded from JSON)
     if (new_edge.id.empty()) {
-        new_edge.id = generate_edge_id();
+        do {
+            new_edge.id = generate_edge_id();
+        } while (has_edge(new_edge.id));
+    } else if (has_edge(new_edge.id)) {
+        // Re-adding an existing ID replaces the old hyperedge
+        remove_hyperedge(new_edge.id);
     }
 
+    if (edge_slots_.size() >= INVALID_ID) {
+        throw std::length_error("Hypergraph edge capacity exceeded");
+    }
+
+    EdgeSlot slot;
+    slot.sources.reserve(new_edge.sources.size());
+    slot.targets.reserve(new_edge.targets.size());
+
     // Normalize node IDs in sources and targets for case-insensitive matching
-    // This ensures "Knowledge Graph" and "knowledge graph" map to the same node
+    // This ensures "Knowledge Graph" and "knowledge graph" map to the same node.
+    // New nodes keep the original label for display.
+    // Normalized IDs are never longer than their labels, so assigning them
+    // back reuses each label's storage
+    thread_local std::string normalized_id;
     for (auto& src : new_edge.sources) {
-        std::string original_label = src;
-        std::string normalized_id = normalize_node_id(src);
-
-        // Create node if it doesn't exist, preserving original label for display
-        if (!has_node(normalized_id)) {
-            HyperNode node;
-            node.id = normalized_id;
-            node.label = original_label;  // Keep original for display
-            add_node(node);
+        if (normalized) {
+            slot.sources.push_back(intern_node(src, src));
+            continue;
         }
-
-        // Update edge to use normalized ID
-        src = normalized_id;
+        normalize_node_id(src, normalized_id);
+        slot.sources.push_back(intern_node(normalized_id, src));
+        src.assign(normalized_id);
     }
 
     for (auto& tgt : new_edge.targets) {
-        std::string original_label = tgt;
-        std::string normalized_id = normalize_node_id(tgt);
-
-        // Create node if it doesn't exist, preserving original label for display
-        if (!has_node(normalized_id)) {
-            HyperNode node;
-            node.id = normalized_id;
-            node.label = original_label;  // Keep original for display
-            add_node(node);
+        if (normalized) {
+            slot.targets.push_back(intern_node(tgt, tgt));
+            continue;
         }
-
-        // Update edge to use normalized ID
-        tgt = normalized_id;
+        normalize_node_id(tgt, normalized_id);
+        slot.targets.push_back(intern_node(normalized_id, tgt));
+        tgt.assign(normalized_id);
     }
 
-    // Add edge to storage
-    hyperedges_[new_edge.id] = new_edge;
-
-    update_indices(new_edge);
+    rebuild_members(slot);
+    slot.edge = std::move(new_edge);
+    slot.alive = true;
 
-    return new_edge.id;
+    // Add edge to storage
+    EdgeId id = static_cast<EdgeId>(edge_slots_.size());
+    edge_lookup_.emplace(slot.edge.id, id);
+    edge_slots_.push_back(std::move(slot));
+    ++live_edges_;
+    ++generation_;
+
+    size_t size = edge_slots_[id].edge.size();
+    if (edge_size_counts_.size() <= size) edge_size_counts_.resize(size + 1, 0);
+    ++edge_size_counts_[size];
+    total_edge_size_ += size;
+
+    update_indices(id);
+    index_signature(id);
+
+    observers_.notify([&](HypergraphObserver& o) { o.on_edge_added(*this, id); });
+    return edge_slots_[id].edge.id;
 }
 
 std::string Hypergraph::add_hyperedge(
@@ -253,122 +364,204 @@ std::string Hypergraph::add_hyperedge(
     return add_hyperedge(edge);
 }
 
+std::vector<std::string> Hypergraph::add_hyperedges(std::vector<HyperEdge> edges) {
+    std::vector<std::string> labels;
+    for (const auto& edge : edges) {
+        labels.insert(labels.end(), edge.sources.begin(), edge.sources.end());
+        labels.insert(labels.end(), edge.targets.begin(), edge.targets.end());
+    }
+    std::vector<std::string> normalized = normalize_node_ids(labels);
+
+    // New nodes are created with the label they first appear under, as
+    // add_hyperedge() would, before inserting the pre-normalized edge
+    std::vector<std::string> ids;
+    ids.reserve(edges.size());
+    size_t next = 0;
+    for (auto& edge : edges) {
+        for (auto* members : {&edge.sources, &edge.targets}) {
+            for (auto& member : *members) {
+                intern_node(normalized[next], member);
+                member = std::move(normalized[next++]);
+            }
+        }
+        ids.push_back(insert_hyperedge(std::move(edge), true));
+    }
+    return ids;
+}
+
 void Hypergraph::add_node(const HyperNode& node) {
-    std::string normalized_id = normalize_node_id(node.id);
+    insert_node(node, false);
+}
 
-    if (nodes_.find(normalized_id) != nodes_.end()) {
+void Hypergraph::insert_node(HyperNode node, bool normalized) {
+    std::string normalized_id = normalized ? std::move(node.id) : normalize_node_id(node.id);
+
+    auto it = node_lookup_.find(normalized_id);
+    if (it != node_lookup_.end()) {
         // Node exists, update properties and embedding but keep existing label
         // (preserves the first label seen for display)
-        nodes_[normalized_id].properties = node.properties;
-        nodes_[normalized_id].embedding = node.embedding;
+        auto& existing = node_slots_[it->second].node;
+        existing.properties = std::move(node.properties);
+        existing.embedding = std::move(node.embedding);
     } else {
-        // New node - use normalized ID but original label
-        HyperNode new_node = node;
-        new_node.id = normalized_id;
-        // Keep the original label for display purposes
-        nodes_[normalized_id] = new_node;
+        // New node - use normalized ID but original label. Incidence is
+        // derived from the edges actually present in this graph.
+        NodeId id = intern_node(normalized_id, node.label);
+        auto& new_node = node_slots_[id].node;
+        new_node.properties = std::move(node.properties);
+        new_node.embedding = std::move(node.embedding);
     }
 }
 
 bool Hypergraph::remove_hyperedge(const std::string& edge_id) {
-    auto it = hyperedges_.find(edge_id);
-    if (it == hyperedges_.end()) {
+    auto it = edge_lookup_.find(edge_id);
+    if (it == edge_lookup_.end()) {
         return false;
     }
 
-    remove_from_indices(edge_id);
-    hyperedges_.erase(it);
+    EdgeId id = it->second;
+    observers_.notify([&](HypergraphObserver& o) { o.on_edge_removing(*this, id); });
+    unindex_signature(id);
+    remove_from_indices(id);
+    edge_lookup_.erase(it);
+
+    // Leave a tombstone so outstanding handles never alias a different edge
+    auto& slot = edge_slots_[id];
+    --edge_size_counts_[slot.edge.size()];
+    total_edge_size_ -= slot.edge.size();
+    slot.alive = false;
+    slot.edge = HyperEdge{};
+    std::vector<NodeId>().swap(slot.sources);
+    std::vector<NodeId>().swap(slot.targets);
+    std::vector<NodeId>().swap(slot.members);
+    --live_edges_;
+    ++generation_;
 
     return true;
 }
 
 bool Hypergraph::remove_node(const std::string& node_id) {
-    std::string normalized = normalize_node_id(node_id);
-    auto it = nodes_.find(normalized);
-    if (it == nodes_.end()) {
+    NodeId id = find_node_id(node_id);
+    if (id == INVALID_ID) {
         return false;
     }
 
-    // Remove all incident edges
-    auto incident = get_incident_edges(normalized);
-    for (const auto& edge : incident) {
-        remove_hyperedge(edge.id);
-    }
-
-    nodes_.erase(it);
-    node_to_edges_.erase(normalized);
-
+    remove_node_at(id);
     return true;
 }
 
+void Hypergraph::remove_node_at(NodeId id) {
+    // Remove all incident edges
+    std::vector<EdgeId> incident = node_slots_[id].edges;
+    for (EdgeId edge_id : incident) {
+        remove_hyperedge(edge_slots_[edge_id].edge.id);
+    }
+
+    observers_.notify([&](HypergraphObserver& o) { o.on_node_removing(*this, id); });
+    auto& slot = node_slots_[id];
+    node_lookup_.erase(slot.node.id);
+    --degree_counts_[0];
+    slot.alive = false;
+    slot.node = HyperNode{};
+    std::vector<EdgeId>().swap(slot.edges);
+    --live_nodes_;
+    ++generation_;
+}
+
 const HyperNode* Hypergraph::get_node(const std::string& node_id) const {
-    std::string normalized = normalize_node_id(node_id);
-    auto it = nodes_.find(normalized);
-    return it != nodes_.end() ? &it->second : nullptr;
+    NodeId id = find_node_id(node_id);
+    return id != INVALID_ID ? &node_slots_[id].node : nullptr;
 }
 
 HyperNode* Hypergraph::get_node(const std::string& node_id) {
-    std::string normalized = normalize_node_id(node_id);
-    auto it = nodes_.find(normalized);
-    return it != nodes_.end() ? &it->second : nullptr;
+    NodeId id = find_node_id(node_id);
+    return id != INVALID_ID ? &node_slots_[id].node : nullptr;
 }
 
 const HyperEdge* Hypergraph::get_hyperedge(const std::string& edge_id) const {
-    auto it = hyperedges_.find(edge_id);
-    return it != hyperedges_.end() ? &it->second : nullptr;
+    EdgeId id = find_edge_id(edge_id);
+    return id != INVALID_ID ? &edge_slots_[id].edge : nullptr;
 }
 
 HyperEdge* Hypergraph::get_hyperedge(const std::string& edge_id) {
-    auto it = hyperedges_.find(edge_id);
-    return it != hyperedges_.end() ? &it->second : nullptr;
-}
+    EdgeId id = find_edge_id(edge_id);
+    if (id == INVALID_ID) {
+        return nullptr;
+    }
 
-std::vector<HyperEdge> Hypergraph::get_incident_edges(const std::string& node_id) const {
-    std::vector<HyperEdge> result;
-
-    std::string normalized = normalize_node_id(node_id);
-    auto it = node_to_edges_.find(normalized);
-    if (it != node_to_edges_.end()) {
-        for (const auto& edge_id : it->second) {
-            auto edge_it = hyperedges_.find(edge_id);
-            if (edge_it != hyperedges_.end()) {
-                result.push_back(edge_it->second);
-            }
-        }
+    // The caller may change the relation, so signatures and the duplicate
+    // count in memoized statistics can no longer be trusted
+    signature_index_.clear();
+    signature_index_valid_ = false;
+    {
+        std::lock_guard<std::mutex> lock(cache_.mutex);
+        cache_.statistics.reset();
     }
 
-    return result;
+    return &edge_slots_[id].edge;
+}
+
+std::vector<HyperEdge> Hypergraph::get_incident_edges(const std::string& node_id) const {
+    auto view = incident_view(node_id);
+    return std::vector<HyperEdge>(view.begin(), view.end());
 }
 
 std::vector<HyperNode> Hypergraph::get_all_nodes() const {
-    std::vector<HyperNode> result;
-    result.reserve(nodes_.size());
+    auto view = nodes_view();
+    return std::vector<HyperNode>(view.begin(), view.end());
+}
 
-    for (const auto& [id, node] : nodes_) {
-        result.push_back(node);
-    }
+std::vector<HyperEdge> Hypergraph::get_all_edges() const {
+    auto view = edges_view();
+    return std::vector<HyperEdge>(view.begin(), view.end());
+}
 
-    return result;
+Hypergraph::NodeView Hypergraph::nodes_view() const {
+    return NodeView(node_slots_.data(), node_slots_.data() + node_slots_.size(), live_nodes_);
 }
 
-std::vector<HyperEdge> Hypergraph::get_all_edges() const {
-    std::vector<HyperEdge> result;
-    result.reserve(hyperedges_.size());
+Hypergraph::EdgeView Hypergraph::edges_view() const {
+    return EdgeView(edge_slots_.data(), edge_slots_.data() + edge_slots_.size(), live_edges_);
+}
 
-    for (const auto& [id, edge] : hyperedges_) {
-        result.push_back(edge);
-    }
+Hypergraph::IncidentEdgeView Hypergraph::incident_view(const std::string& node_id) const {
+    NodeId id = find_node_id(node_id);
+    return id != INVALID_ID ? incident_view(id) : IncidentEdgeView();
+}
 
-    return result;
+Hypergraph::IncidentEdgeView Hypergraph::incident_view(NodeId id) const {
+    const auto& edges = node_slots_[id].edges;
+    return IncidentEdgeView(edge_slots_.data(), edges.data(), edges.data() + edges.size());
 }
 
 bool Hypergraph::has_node(const std::string& node_id) const {
-    std::string normalized = normalize_node_id(node_id);
-    return nodes_.find(normalized) != nodes_.end();
+    return find_node_id(node_id) != INVALID_ID;
 }
 
 bool Hypergraph::has_edge(const std::string& edge_id) const {
-    return hyperedges_.find(edge_id) != hyperedges_.end();
+    return edge_lookup_.find(edge_id) != edge_lookup_.end();
+}
+
+NodeId Hypergraph::find_node_id(const std::string& node_id) const {
+    // Per-thread buffer: lookups from concurrent readers never allocate
+    thread_local std::string normalized_id;
+    normalize_node_id(node_id, normalized_id);
+    auto it = node_lookup_.find(normalized_id);
+    return it != node_lookup_.end() ? it->second : INVALID_ID;
+}
+
+EdgeId Hypergraph::find_edge_id(const std::string& edge_id) const {
+    auto it = edge_lookup_.find(edge_id);
+    return it != edge_lookup_.end() ? it->second : INVALID_ID;
+}
+
+std::shared_ptr<const IncidenceCSR> Hypergraph::incidence() const {
+    std::lock_guard<std::mutex> lock(cache_.mutex);
+    if (!cache_.incidence || cache_.incidence_generation != generation_) {
+        cache_.incidence = build_incidence();
+        cache_.incidence_generation = generation_;
+    }
+    return cache_.incidence;
 }
 
 // ==========================================
@@ -376,39 +569,75 @@ bool Hypergraph::has_edge(const std::string& edge_id) const {
 // ==========================================
 
 void Hypergraph::merge_similar_nodes(double similarity_threshold) {
+    AnnConfig exact;
+    exact.method = AnnMethod::Exact;
+    exact.max_neighbors = 0;
+    merge_similar_nodes(similarity_threshold, exact);
+}
+
+size_t Hypergraph::merge_similar_nodes(double similarity_threshold, const AnnConfig& ann) {
     if (similarity_threshold < 0.0 || similarity_threshold > 1.0) {
         throw std::invalid_argument("Similarity threshold must be in [0, 1]");
     }
 
-    // Build similarity graph
-    std::map<std::string, std::vector<std::string>> similarity_graph;
-
-    std::vector<std::string> node_ids;
-    for (const auto& [id, node] : nodes_) {
-        if (!node.embedding.empty()) {
-            node_ids.push_back(id);
+    // Vectors of different lengths are never similar, so index each
+    // embedding dimension separately
+    std::map<size_t, std::vector<NodeId>> by_dimension;
+    for (NodeId id = 0; id < node_slots_.size(); ++id) {
+        if (node_slots_[id].alive && !node_slots_[id].node.embedding.empty()) {
+            by_dimension[node_slots_[id].node.embedding.size()].push_back(id);
         }
     }
 
-    // Compute pairwise similarities
-    for (size_t i = 0; i < node_ids.size(); ++i) {
-        for (size_t j = i + 1; j < node_ids.size(); ++j) {
-            const auto& node_i = nodes_[node_ids[i]];
-            const auto& node_j = nodes_[node_ids[j]];
+    std::vector<std::vector<NodeId>> similar(node_slots_.size());
+    for (const auto& [dimension, node_ids] : by_dimension) {
+        if (node_ids.size() < 2) continue;
 
-            double sim = cosine_similarity(node_i.embedding, node_j.embedding);
+        auto index = make_vector_index(dimension, node_ids.size(), ann);
+        for (NodeId id : node_ids) {
+            index->add(node_slots_[id].node.embedding);
+        }
 
-            if (sim >= similarity_threshold) {
-                similarity_graph[node_ids[i]].push_back(node_ids[j]);
-                similarity_graph[node_ids[j]].push_back(node_ids[i]);
+        std::vector<std::vector<AnnNeighbor>> hits(node_ids.size());
+        parallel_for_shards(node_ids.size(), ann.num_threads,
+            [&](size_t, size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    hits[i] = index->search_threshold(index->vector(static_cast<uint32_t>(i)),
+                                                      static_cast<float>(similarity_threshold),
+                                                      ann.max_neighbors);
+                }
+            });
+
+        // Symmetrize: approximate neighbour lists need not be mutual
+        for (size_t i = 0; i < node_ids.size(); ++i) {
+            for (const auto& hit : hits[i]) {
+                if (hit.id == i) continue;
+                similar[node_ids[i]].push_back(node_ids[hit.id]);
+                similar[node_ids[hit.id]].push_back(node_ids[i]);
             }
         }
     }
 
+    // Neighbours in handle order, matching the order the all-pairs scan produced
+    std::map<std::string, std::vector<std::string>> similarity_graph;
+    for (NodeId id = 0; id < similar.size(); ++id) {
+        auto& list = similar[id];
+        if (list.empty()) continue;
+        std::sort(list.begin(), list.end());
+        list.erase(std::unique(list.begin(), list.end()), list.end());
+
+        auto& names = similarity_graph[node_slots_[id].node.id];
+        names.reserve(list.size());
+        for (NodeId other : list) {
+            names.push_back(node_slots_[other].node.id);
+        }
+    }
+
     // Find connected components (equivalence classes)
     auto components = find_similarity_components(similarity_graph);
 
     // Merge each component
+    size_t merged = 0;
     for (const auto& component : components) {
         if (component.empty()) continue;
 
@@ -428,18 +657,21 @@ void Hypergraph::merge_similar_nodes(double similarity_threshold) {
         for (const auto& node_id : component) {
             if (node_id != representative) {
                 merge_nodes(representative, node_id);
+                ++merged;
             }
         }
     }
+
+    return merged;
 }
 
 size_t Hypergraph::remove_self_loops() {
     size_t removed = 0;
 
     std::vector<std::string> to_remove;
-    for (const auto& [id, edge] : hyperedges_) {
-        if (edge.is_self_loop()) {
-            to_remove.push_back(id);
+    for (const auto& slot : edge_slots_) {
+        if (slot.alive && slot.edge.is_self_loop()) {
+            to_remove.push_back(slot.edge.id);
         }
     }
 
@@ -455,19 +687,22 @@ size_t Hypergraph::remove_self_loops() {
 std::map<std::string, std::vector<std::string>> Hypergraph::find_duplicate_edges() const {
     std::map<std::string, std::vector<std::string>> duplicates;
 
-    std::vector<std::string> edge_ids;
-    for (const auto& [id, edge] : hyperedges_) {
-        edge_ids.push_back(id);
-    }
+    // hash -> canonical signatures seen so far (more than one only on collision)
+    std::unordered_map<uint64_t, std::vector<std::pair<EdgeId, EdgeSignature>>> groups;
+    groups.reserve(live_edges_);
 
-    for (size_t i = 0; i < edge_ids.size(); ++i) {
-        for (size_t j = i + 1; j < edge_ids.size(); ++j) {
-            const auto& edge_i = hyperedges_.at(edge_ids[i]);
-            const auto& edge_j = hyperedges_.at(edge_ids[j]);
+    for (EdgeId id = 0; id < edge_slots_.size(); ++id) {
+        if (!edge_slots_[id].alive) continue;
 
-            if (are_duplicate_edges(edge_i, edge_j)) {
-                duplicates[edge_ids[i]].push_back(edge_ids[j]);
-            }
+        EdgeSignature signature = signature_of(id);
+        auto& bucket = groups[signature.hash];
+
+        auto match = std::find_if(bucket.begin(), bucket.end(),
+                                  [&signature](const auto& entry) { return entry.second == signature; });
+        if (match != bucket.end()) {
+            duplicates[edge_slots_[match->first].edge.id].push_back(edge_slots_[id].edge.id);
+        } else {
+            bucket.emplace_back(id, std::move(signature));
         }
     }
 
@@ -490,16 +725,17 @@ size_t Hypergraph::merge_duplicate_edges() {
 }
 
 int Hypergraph::get_node_degree(const std::string& node_id) const {
-    std::string normalized = normalize_node_id(node_id);
-    auto it = node_to_edges_.find(normalized);
-    return it != node_to_edges_.end() ? static_cast<int>(it->second.size()) : 0;
+    NodeId id = find_node_id(node_id);
+    return id != INVALID_ID ? static_cast<int>(node_slots_[id].edges.size()) : 0;
 }
 
 std::map<std::string, int> Hypergraph::compute_node_degrees() const {
     std::map<std::string, int> degrees;
 
-    for (const auto& [node_id, node] : nodes_) {
-        degrees[node_id] = get_node_degree(node_id);
+    for (const auto& slot : node_slots_) {
+        if (slot.alive) {
+            degrees[slot.node.id] = static_cast<int>(slot.edges.size());
+        }
     }
 
     return degrees;
@@ -525,73 +761,82 @@ std::vector<std::pair<std::string, int>> Hypergraph::get_top_hubs(size_t k) cons
 }
 
 HypergraphStatistics Hypergraph::compute_statistics() const {
-    HypergraphStatistics stats;
+    return compute_statistics(StatisticsOptions{});
+}
 
-    stats.num_nodes = nodes_.size();
-    stats.num_edges = hyperedges_.size();
+HypergraphStatistics Hypergraph::compute_statistics(StatisticsTier tier) const {
+    StatisticsOptions options;
+    options.tier = tier;
+    return compute_statistics(options);
+}
 
-    if (hyperedges_.empty()) {
-        return stats;
-    }
+HypergraphStatistics Hypergraph::cheap_statistics() const {
+    HypergraphStatistics stats;
 
-    // Edge size statistics
-    size_t total_edge_size = 0;
-    stats.max_edge_size = 0;
-    stats.min_edge_size = std::numeric_limits<size_t>::max();
+    stats.num_nodes = live_nodes_;
+    stats.num_edges = live_edges_;
 
-    for (const auto& [id, edge] : hyperedges_) {
-        size_t size = edge.size();
-        total_edge_size += size;
-        stats.max_edge_size = std::max(stats.max_edge_size, size);
-        stats.min_edge_size = std::min(stats.min_edge_size, size);
+    if (live_edges_ == 0) {
+        return stats;
     }
 
-    stats.avg_edge_size = static_cast<double>(total_edge_size) / hyperedges_.size();
-
-    // Node degree statistics
-    auto degrees = compute_node_degrees();
-    if (!degrees.empty()) {
-        size_t total_degree = 0;
-        stats.max_node_degree = 0;
-        stats.min_node_degree = std::numeric_limits<size_t>::max();
-
-        for (const auto& [node_id, degree] : degrees) {
-            total_degree += degree;
-            stats.max_node_degree = std::max(stats.max_node_degree, static_cast<size_t>(degree));
-            stats.min_node_degree = std::min(stats.min_node_degree, static_cast<size_t>(degree));
+    // Edge size statistics from the size histogram
+    stats.avg_edge_size = static_cast<double>(total_edge_size_) / live_edges_;
+    bool seen_edge = false;
+    for (size_t size = 0; size < edge_size_counts_.size(); ++size) {
+        if (edge_size_counts_[size] > 0) {
+            if (!seen_edge) stats.min_edge_size = size;
+            stats.max_edge_size = size;
+            seen_edge = true;
         }
-
-        stats.avg_node_degree = static_cast<double>(total_degree) / degrees.size();
     }
 
-    // Compute duplicate edges
-    stats.num_duplicate_edges = find_duplicate_edges().size();
-
-    // Compute pairwise overlaps
-    std::vector<std::string> edge_ids;
-    for (const auto& [id, edge] : hyperedges_) {
-        edge_ids.push_back(id);
+    // Node degree statistics from the degree histogram
+    if (live_nodes_ > 0) {
+        stats.avg_node_degree = static_cast<double>(total_degree_) / live_nodes_;
+        bool seen_node = false;
+        for (size_t degree = 0; degree < degree_counts_.size(); ++degree) {
+            if (degree_counts_[degree] > 0) {
+                if (!seen_node) stats.min_node_degree = degree;
+                stats.max_node_degree = degree;
+                seen_node = true;
+            }
+        }
     }
 
-    for (size_t i = 0; i < edge_ids.size(); ++i) {
-        for (size_t j = i + 1; j < edge_ids.size(); ++j) {
-            const auto& edge_i = hyperedges_.at(edge_ids[i]);
-            const auto& edge_j = hyperedges_.at(edge_ids[j]);
+    return stats;
+}
 
-            auto intersection = edge_i.intersection(edge_j);
-            size_t overlap_size = intersection.size();
+HypergraphStatistics Hypergraph::compute_statistics(const StatisticsOptions& options) const {
+    HypergraphStatistics stats = cheap_statistics();
 
-            if (overlap_size >= 1) stats.num_pairs_overlap_1++;
-            if (overlap_size >= 2) stats.num_pairs_overlap_2++;
-            if (overlap_size >= 3) stats.num_pairs_overlap_3++;
+    if (options.tier == StatisticsTier::Cheap || live_edges_ == 0) {
+        return stats;
+    }
 
-            stats.max_edge_intersection = std::max(
-                stats.max_edge_intersection,
-                overlap_size
-            );
+    // Thread count does not change the result, so only sampling settings
+    // have to match for the memo to apply
+    auto same_sampling = [&](const StatisticsOptions& cached) {
+        return cached.overlap_sample_threshold == options.overlap_sample_threshold
+            && cached.overlap_sample_size == options.overlap_sample_size
+            && cached.seed == options.seed;
+    };
+    {
+        std::lock_guard<std::mutex> lock(cache_.mutex);
+        if (cache_.statistics && cache_.statistics_generation == generation_
+            && same_sampling(cache_.statistics_options)) {
+            return *cache_.statistics;
         }
     }
 
+    // Count redundant edges: a group of k identical edges contributes k - 1
+    for (const auto& [canonical, dups] : find_duplicate_edges()) {
+        stats.num_duplicate_edges += dups.size();
+    }
+
+    // Compute pairwise overlaps
+    compute_overlap_statistics(stats, options);
+
     // Fit power law
     auto [exponent, r_squared] = fit_power_law();
     if (r_squared > 0.5) {  // Only include if reasonable fit
@@ -599,9 +844,125 @@ HypergraphStatistics Hypergraph::compute_statistics() const {
         stats.power_law_r_squared = r_squared;
     }
 
+    {
+        std::lock_guard<std::mutex> lock(cache_.mutex);
+        cache_.statistics = std::make_shared<const HypergraphStatistics>(stats);
+        cache_.statistics_generation = generation_;
+        cache_.statistics_options = options;
+    }
+
     return stats;
 }
 
+namespace {
+
+// Per-shard accumulator for the overlap kernel
+struct OverlapTally {
+    size_t pairs[3] = {0, 0, 0};                       // Partners sharing >= 1, 2, 3 nodes
+    double squares[3] = {0.0, 0.0, 0.0};               // Sum of squared per-edge counts
+    size_t max_intersection = 0;
+};
+
+} // namespace
+
+void Hypergraph::compute_overlap_statistics(
+    HypergraphStatistics& stats,
+    const StatisticsOptions& options
+) const {
+    auto csr = incidence();
+
+    std::vector<EdgeId> edges;
+    edges.reserve(live_edges_);
+    for (EdgeId id = 0; id < edge_slots_.size(); ++id) {
+        if (edge_slots_[id].alive) {
+            edges.push_back(id);
+        }
+    }
+
+    const size_t total = edges.size();
+    const bool sampled = options.overlap_sample_threshold > 0
+        && total > options.overlap_sample_threshold
+        && options.overlap_sample_size > 0
+        && options.overlap_sample_size < total;
+
+    if (sampled) {
+        // Partial Fisher-Yates: the first sample_size entries become a
+        // uniform sample without replacement
+        std::mt19937_64 rng(options.seed);
+        for (size_t i = 0; i < options.overlap_sample_size; ++i) {
+            std::uniform_int_distribution<size_t> pick(i, total - 1);
+            std::swap(edges[i], edges[pick(rng)]);
+        }
+        edges.resize(options.overlap_sample_size);
+    }
+
+    size_t workers = options.num_threads > 0 ? options.num_threads : default_thread_count();
+    std::vector<OverlapTally> tallies(std::min(workers, std::max<size_t>(edges.size(), 1)));
+    const size_t num_edge_rows = csr->num_edge_rows();
+
+    parallel_for_shards(edges.size(), workers, [&](size_t shard, size_t begin, size_t end) {
+        std::vector<uint32_t> overlap(num_edge_rows, 0);
+        std::vector<EdgeId> touched;
+        auto& tally = tallies[shard];
+        for (size_t i = begin; i < end; ++i) {
+            // Exact mode sees each pair once, from its lower edge; sampled
+            // edges count every partner
+            size_t counts[3] = {0, 0, 0};
+            for_each_overlap(*csr, edges[i], !sampled, overlap, touched, [&](EdgeId, uint32_t shared) {
+                counts[0]++;
+                if (shared >= 2) counts[1]++;
+                if (shared >= 3) counts[2]++;
+                tally.max_intersection = std::max(tally.max_intersection, static_cast<size_t>(shared));
+            });
+            for (int k = 0; k < 3; ++k) {
+                tally.pairs[k] += counts[k];
+                tally.squares[k] += static_cast<double>(counts[k]) * counts[k];
+            }
+        }
+    });
+
+    OverlapTally sum;
+    for (const auto& tally : tallies) {
+        for (int k = 0; k < 3; ++k) {
+            sum.pairs[k] += tally.pairs[k];
+            sum.squares[k] += tally.squares[k];
+        }
+        sum.max_intersection = std::max(sum.max_intersection, tally.max_intersection);
+    }
+    stats.max_edge_intersection = sum.max_intersection;
+
+    if (!sampled) {
+        stats.num_pairs_overlap_1 = sum.pairs[0];
+        stats.num_pairs_overlap_2 = sum.pairs[1];
+        stats.num_pairs_overlap_3 = sum.pairs[2];
+        return;
+    }
+
+    // Every pair is seen from both endpoints, so the pair total is half the
+    // sum of per-edge partner counts; scale the sample mean accordingly and
+    // bound it with a normal interval using the finite population correction
+    const double n = static_cast<double>(edges.size());
+    const double N = static_cast<double>(total);
+    const double fpc = 1.0 - n / N;
+    double estimates[3];
+    double margins[3];
+    for (int k = 0; k < 3; ++k) {
+        double mean = sum.pairs[k] / n;
+        double variance = n > 1 ? (sum.squares[k] - n * mean * mean) / (n - 1) : 0.0;
+        estimates[k] = N * mean / 2.0;
+        margins[k] = 1.96 * (N / 2.0) * std::sqrt(std::max(variance, 0.0) / n * fpc);
+    }
+
+    stats.overlap_estimated = true;
+    stats.overlap_sample_size = edges.size();
+    stats.num_pairs_overlap_1 = static_cast<size_t>(std::llround(estimates[0]));
+    stats.num_pairs_overlap_2 = static_cast<size_t>(std::llround(estimates[1]));
+    stats.num_pairs_overlap_3 = static_cast<size_t>(std::llround(estimates[2]));
+    stats.overlap_1_margin = margins[0];
+    stats.overlap_2_margin = margins[1];
+    stats.overlap_3_margin = margins[2];
+}
+
 // ==========================================
 // Path Finding (continued in next part)
 // ==========================================
@@ -611,257 +972,692 @@ std::vector<HyperEdge> Hypergraph::find_shortest_path(
     const std::string& end,
     int min_intersection_size
 ) const {
-    return bfs_path_search(start, end, min_intersection_size);
+    std::vector<HyperEdge> path;
+
+    NodeId start_id = find_node_id(start);
+    NodeId end_id = find_node_id(end);
+    if (start_id == INVALID_ID || end_id == INVALID_ID) {
+        return path;
+    }
+
+    auto csr = incidence();
+    for (EdgeId edge_id : s_path_search(*csr, csr->edges_of(start_id), end_id, min_intersection_size)) {
+        path.push_back(edge_slots_[edge_id].edge);
+    }
+    return path;
 }
 
 PathSearchResult Hypergraph::find_k_shortest_paths(
     const std::string& start,
     const std::string& end,
     int k,
-    int min_intersection_size
+    int min_intersection_size,
+    size_t max_hops
 ) const {
-    PathSearchResult result;
-
-    if (!has_node(start) || !has_node(end)) {
-        return result;
+    NodeId start_id = find_node_id(start);
+    NodeId end_id = find_node_id(end);
+    if (start_id == INVALID_ID || end_id == INVALID_ID || k <= 0) {
+        return PathSearchResult();
     }
 
-    // Yen's algorithm adapted for hypergraphs
-    // Step 1: Find shortest path
-    auto shortest = find_shortest_path(start, end, min_intersection_size);
+    auto csr = incidence();
+    auto shortest = s_path_search(*csr, csr->edges_of(start_id), end_id, min_intersection_size, max_hops);
+    return k_shortest_from(*csr, start_id, end_id, std::move(shortest), k, min_intersection_size, max_hops);
+}
+
+PathSearchResult Hypergraph::k_shortest_from(
+    const IncidenceCSR& csr,
+    NodeId start_id,
+    NodeId end_id,
+    std::vector<EdgeId> shortest,
+    int k,
+    int min_intersection_size,
+    size_t max_hops
+) const {
+    PathSearchResult result;
 
+    // Yen's algorithm on the line graph of s-adjacent hyperedges. A spur at
+    // index i keeps the first i edges of the previous path and searches again
+    // from the i-th edge, so the detour leaves through the actual nodes that
+    // edge shares with its neighbours; at i = 0 it restarts from the start node.
+    struct Candidate {
+        std::vector<EdgeId> edges;
+        size_t deviation = 0;                          // First index where it differs from its parent
+    };
+    auto longer = [](const Candidate& a, const Candidate& b) {
+        if (a.edges.size() != b.edges.size()) return a.edges.size() > b.edges.size();
+        return a.edges > b.edges;
+    };
+    std::priority_queue<Candidate, std::vector<Candidate>, decltype(longer)> heap(longer);
+    std::set<std::vector<EdgeId>> known;               // Accepted or queued paths
+
+    std::vector<Candidate> accepted;
+    result.num_paths_explored = 1;
     if (shortest.empty()) {
         return result;
     }
+    known.insert(shortest);
+    accepted.push_back({std::move(shortest), 0});
+
+    std::vector<EdgeId> banned;
+    std::vector<size_t> sharing;
+    while (accepted.size() < static_cast<size_t>(k)) {
+        const Candidate prev = accepted.back();
+
+        // Accepted paths that agree with prev on its first `deviation` edges;
+        // narrowed one edge at a time as the root grows. Earlier spur indices
+        // were already explored when prev's parent was expanded.
+        sharing.clear();
+        for (size_t j = 0; j < accepted.size(); ++j) {
+            const auto& edges = accepted[j].edges;
+            if (edges.size() > prev.deviation
+                && std::equal(prev.edges.begin(), prev.edges.begin() + prev.deviation, edges.begin())) {
+                sharing.push_back(j);
+            }
+        }
 
-    result.paths.push_back(shortest);
-    result.found = true;
-    result.num_paths_explored = 1;
-
-    // Priority queue of candidate paths
-    std::vector<std::pair<size_t, std::vector<HyperEdge>>> candidates;
-
-    // Step 2: Find k-1 additional paths
-    for (int k_iter = 1; k_iter < k; ++k_iter) {
-        const auto& prev_path = result.paths.back();
+        for (size_t i = prev.deviation; i < prev.edges.size() && !sharing.empty(); ++i) {
+            // A deviation at index i yields at least i + 1 edges
+            if (max_hops > 0 && i + 1 > max_hops) break;
 
-        // Generate spur paths by removing edges
-        for (size_t i = 0; i < prev_path.size(); ++i) {
-            // Build exclusion set
-            std::set<std::string> excluded_edges;
+            // Ban the root (except the spur edge itself) and every edge that
+            // an accepted path with this root already took next
+            const size_t root_len = i > 0 ? i - 1 : 0;
+            banned.assign(prev.edges.begin(), prev.edges.begin() + root_len);
+            for (size_t j : sharing) {
+                banned.push_back(accepted[j].edges[i]);
+            }
 
-            for (const auto& path : result.paths) {
-                if (path.size() > i) {
-                    excluded_edges.insert(path[i].id);
+            IdSpan<EdgeId> seeds = i == 0
+                ? csr.edges_of(start_id)
+                : IdSpan<EdgeId>(&prev.edges[i - 1], &prev.edges[i - 1] + 1);
+            auto spur = s_path_search(csr, seeds, end_id, min_intersection_size,
+                                      max_hops > 0 ? max_hops - root_len : 0, banned);
+            result.num_paths_explored++;
+
+            if (!spur.empty()) {
+                Candidate candidate;
+                candidate.edges.reserve(root_len + spur.size());
+                candidate.edges.assign(prev.edges.begin(), prev.edges.begin() + root_len);
+                candidate.edges.insert(candidate.edges.end(), spur.begin(), spur.end());
+                candidate.deviation = i;
+                if (known.insert(candidate.edges).second) {
+                    heap.push(std::move(candidate));
                 }
             }
 
-            // Find spur path
-            auto spur_path = bfs_path_search(
-                prev_path[i].targets[0],  // Simplified: use first target
-                end,
-                min_intersection_size,
-                excluded_edges
-            );
-
-            if (!spur_path.empty()) {
-                // Combine root + spur
-                std::vector<HyperEdge> candidate;
-                candidate.insert(candidate.end(), prev_path.begin(), prev_path.begin() + i);
-                candidate.insert(candidate.end(), spur_path.begin(), spur_path.end());
-
-                candidates.push_back({candidate.size(), candidate});
+            // Keep only paths that also share edge i with prev
+            size_t kept = 0;
+            for (size_t j : sharing) {
+                const auto& edges = accepted[j].edges;
+                if (edges.size() > i + 1 && edges[i] == prev.edges[i]) {
+                    sharing[kept++] = j;
+                }
             }
+            sharing.resize(kept);
         }
 
-        if (candidates.empty()) {
+        if (heap.empty()) {
             break;
         }
+        accepted.push_back(heap.top());
+        heap.pop();
+    }
 
-        // Sort by path length and take shortest
-        std::sort(candidates.begin(), candidates.end(),
-                  [](const auto& a, const auto& b) { return a.first < b.first; });
-
-        result.paths.push_back(candidates[0].second);
-        candidates.erase(candidates.begin());
-        result.num_paths_explored++;
+    result.found = true;
+    for (const auto& path : accepted) {
+        std::vector<HyperEdge> edges;
+        edges.reserve(path.edges.size());
+        for (EdgeId edge_id : path.edges) {
+            edges.push_back(edge_slots_[edge_id].edge);
+        }
+        result.paths.push_back(std::move(edges));
+    }
+
+    // Junction nodes of the shortest path: the first node each step shares
+    const auto& best = accepted.front().edges;
+    for (size_t i = 0; i + 1 < best.size(); ++i) {
+        const auto& a = edge_slots_[best[i]].members;
+        const auto& b = edge_slots_[best[i + 1]].members;
+        std::vector<NodeId> shared;
+        std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(shared));
+        if (!shared.empty()) {
+            result.intersection_nodes.push_back(node_slots_[shared.front()].node.id);
+        }
     }
 
     return result;
 }
 
-// This file continues in the next part...
-// Remaining implementations will be in hypergraph_part2.cpp
-
 // ==========================================
 // Helper Methods
 // ==========================================
 
-void Hypergraph::update_indices(const HyperEdge& edge) {
-    for (const auto& node_id : edge.get_all_nodes()) {
-        node_to_edges_[node_id].push_back(edge.id);
-        if (nodes_.find(node_id) != nodes_.end()) {
-            nodes_[node_id].incident_edges.push_back(edge.id);
-            nodes_[node_id].degree = static_cast<int>(node_to_edges_[node_id].size());
-        }
+void Hypergraph::rebuild_members(EdgeSlot& slot) const {
+    slot.members.clear();
+    slot.members.reserve(slot.sources.size() + slot.targets.size());
+    slot.members.insert(slot.members.end(), slot.sources.begin(), slot.sources.end());
+    slot.members.insert(slot.members.end(), slot.targets.begin(), slot.targets.end());
+    std::sort(slot.members.begin(), slot.members.end());
+    slot.members.erase(std::unique(slot.members.begin(), slot.members.end()), slot.members.end());
+}
+
+void Hypergraph::update_indices(EdgeId edge_id) {
+    const auto& slot = edge_slots_[edge_id];
+    for (NodeId node_id : slot.members) {
+        auto& node_slot = node_slots_[node_id];
+        move_degree(node_slot.edges.size(), node_slot.edges.size() + 1);
+        node_slot.edges.push_back(edge_id);
+        node_slot.node.incident_edges.push_back(slot.edge.id);
+        node_slot.node.degree = static_cast<int>(node_slot.edges.size());
     }
 }
 
-void Hypergraph::remove_from_indices(const std::string& edge_id) {
-    auto it = hyperedges_.find(edge_id);
-    if (it == hyperedges_.end()) return;
+void Hypergraph::move_degree(size_t from, size_t to) {
+    if (degree_counts_.size() <= to) degree_counts_.resize(to + 1, 0);
+    --degree_counts_[from];
+    ++degree_counts_[to];
+    total_degree_ = total_degree_ + to - from;
+}
 
-    for (const auto& node_id : it->second.get_all_nodes()) {
-        auto& edges = node_to_edges_[node_id];
+void Hypergraph::remove_from_indices(EdgeId edge_id) {
+    const auto& slot = edge_slots_[edge_id];
+    for (NodeId node_id : slot.members) {
+        auto& node_slot = node_slots_[node_id];
+        auto& edges = node_slot.edges;
+        size_t old_degree = edges.size();
         edges.erase(std::remove(edges.begin(), edges.end(), edge_id), edges.end());
+        move_degree(old_degree, edges.size());
+
+        auto& incident = node_slot.node.incident_edges;
+        incident.erase(std::remove(incident.begin(), incident.end(), slot.edge.id), incident.end());
+        node_slot.node.degree = static_cast<int>(edges.size());
+    }
+}
+
+Hypergraph::EdgeSignature Hypergraph::make_signature(
+    const std::string& relation,
+    std::vector<NodeId> sources,
+    std::vector<NodeId> targets
+) {
+    EdgeSignature signature;
+    signature.relation = &relation;
+
+    // Set semantics: order and repetition within sources/targets don't matter
+    std::sort(sources.begin(), sources.end());
+    sources.erase(std::unique(sources.begin(), sources.end()), sources.end());
+    std::sort(targets.begin(), targets.end());
+    targets.erase(std::unique(targets.begin(), targets.end()), targets.end());
+
+    uint64_t hash = std::hash<std::string>{}(relation);
+    auto mix = [&hash](uint64_t value) {
+        hash ^= value + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+    };
+    mix(sources.size());
+    for (NodeId id : sources) mix(id);
+    mix(targets.size());
+    for (NodeId id : targets) mix(id);
+
+    signature.sources = std::move(sources);
+    signature.targets = std::move(targets);
+    signature.hash = hash;
+    return signature;
+}
+
+Hypergraph::EdgeSignature Hypergraph::signature_of(EdgeId edge_id) const {
+    const auto& slot = edge_slots_[edge_id];
+    return make_signature(slot.edge.relation, slot.sources, slot.targets);
+}
 
-        if (nodes_.find(node_id) != nodes_.end()) {
-            auto& incident = nodes_[node_id].incident_edges;
-            incident.erase(std::remove(incident.begin(), incident.end(), edge_id), incident.end());
-            nodes_[node_id].degree = static_cast<int>(edges.size());
+void Hypergraph::ensure_signature_index() {
+    if (signature_index_valid_) return;
+
+    signature_index_.clear();
+    signature_index_.reserve(live_edges_);
+    signature_index_valid_ = true;
+    for (EdgeId id = 0; id < edge_slots_.size(); ++id) {
+        if (edge_slots_[id].alive) {
+            index_signature(id);
         }
     }
 }
 
-bool Hypergraph::are_duplicate_edges(const HyperEdge& e1, const HyperEdge& e2) const {
-    if (e1.relation != e2.relation) return false;
+void Hypergraph::index_signature(EdgeId edge_id) {
+    if (!signature_index_valid_) return;
+    signature_index_[signature_of(edge_id).hash].push_back(edge_id);
+}
+
+void Hypergraph::unindex_signature(EdgeId edge_id) {
+    if (!signature_index_valid_) return;
 
-    std::set<std::string> src1(e1.sources.begin(), e1.sources.end());
-    std::set<std::string> src2(e2.sources.begin(), e2.sources.end());
-    std::set<std::string> tgt1(e1.targets.begin(), e1.targets.end());
-    std::set<std::string> tgt2(e2.targets.begin(), e2.targets.end());
+    auto it = signature_index_.find(signature_of(edge_id).hash);
+    if (it == signature_index_.end()) return;
 
-    return src1 == src2 && tgt1 == tgt2;
+    auto& bucket = it->second;
+    bucket.erase(std::remove(bucket.begin(), bucket.end(), edge_id), bucket.end());
+    if (bucket.empty()) {
+        signature_index_.erase(it);
+    }
 }
 
-std::vector<HyperEdge> Hypergraph::bfs_path_search(
-    const std::string& start,
-    const std::string& end,
-    int min_intersection_size,
-    const std::set<std::string>& excluded_edges
-) const {
-    // BFS on hyperedges
-    std::queue<std::string> edge_queue;
-    std::map<std::string, std::string> parent_edge;
-    std::set<std::string> visited_edges;
+EdgeId Hypergraph::find_signature(const EdgeSignature& signature) const {
+    auto it = signature_index_.find(signature.hash);
+    if (it == signature_index_.end()) return INVALID_ID;
 
-    // Start from edges containing start node
-    auto start_edges = get_incident_edges(start);
-    for (const auto& edge : start_edges) {
-        if (excluded_edges.find(edge.id) == excluded_edges.end()) {
-            edge_queue.push(edge.id);
-            parent_edge[edge.id] = "";
-            visited_edges.insert(edge.id);
+    for (EdgeId candidate : it->second) {
+        if (signature_of(candidate) == signature) {
+            return candidate;
         }
     }
+    return INVALID_ID;
+}
 
-    std::string goal_edge_id;
+namespace {
+
+// Reusable buffers for s_path_search. Marks are stamped with the query's
+// epoch, so nothing sized to the graph is cleared between searches.
+// Index 0 is the side searching from the seeds, 1 the side from the end node.
+struct PathScratch {
+    uint32_t epoch = 0;
+    std::vector<uint32_t> seen[2];                     // Edge reached by a side
+    std::vector<uint32_t> depth[2];                    // Hops from that side's seeds
+    std::vector<EdgeId> parent[2];                     // Predecessor towards that side's seeds
+    std::vector<uint32_t> expanded[2];                 // Node whose edges a side has scanned (s = 1)
+    std::vector<uint32_t> banned;
+    std::vector<uint32_t> overlap;                     // Shared-node counters, all zero between uses
+    std::vector<EdgeId> frontier[2];
+    std::vector<EdgeId> next;
+    std::vector<EdgeId> touched;
+
+    void prepare(size_t num_edges, size_t num_nodes) {
+        if (banned.size() < num_edges) {
+            for (int side = 0; side < 2; ++side) {
+                seen[side].resize(num_edges, 0);
+                depth[side].resize(num_edges, 0);
+                parent[side].resize(num_edges, INVALID_ID);
+            }
+            banned.resize(num_edges, 0);
+            overlap.resize(num_edges, 0);
+        }
+        if (expanded[0].size() < num_nodes) {
+            expanded[0].resize(num_nodes, 0);
+            expanded[1].resize(num_nodes, 0);
+        }
+        if (++epoch == 0) {
+            // Stamps wrapped around; start over from a clean slate
+            for (int side = 0; side < 2; ++side) {
+                std::fill(seen[side].begin(), seen[side].end(), 0);
+                std::fill(expanded[side].begin(), expanded[side].end(), 0);
+            }
+            std::fill(banned.begin(), banned.end(), 0);
+            epoch = 1;
+        }
+        frontier[0].clear();
+        frontier[1].clear();
+    }
+};
 
-    while (!edge_queue.empty() && goal_edge_id.empty()) {
-        std::string current_edge_id = edge_queue.front();
-        edge_queue.pop();
+PathScratch& path_scratch() {
+    thread_local PathScratch scratch;
+    return scratch;
+}
 
-        const auto& current_edge = hyperedges_.at(current_edge_id);
+// Call reach(edge_id) for every edge that shares at least s nodes with
+// `current` and is neither banned nor already seen by `side`. reach must
+// mark the edge as seen.
+template <typename Reach>
+void expand_edge(
+    const IncidenceCSR& csr,
+    PathScratch& scratch,
+    int side,
+    EdgeId current,
+    uint32_t s,
+    Reach&& reach
+) {
+    const uint32_t epoch = scratch.epoch;
+    if (s == 1) {
+        // Any shared node suffices, so each node's edge list only needs
+        // scanning once per side: hubs are paid for once
+        for (NodeId node_id : csr.nodes_of(current)) {
+            if (scratch.expanded[side][node_id] == epoch) continue;
+            scratch.expanded[side][node_id] = epoch;
+            for (EdgeId edge_id : csr.edges_of(node_id)) {
+                if (scratch.seen[side][edge_id] == epoch || scratch.banned[edge_id] == epoch) continue;
+                reach(edge_id);
+            }
+        }
+        return;
+    }
 
-        // Check if this edge contains the end node
-        if (current_edge.contains_node(end)) {
-            goal_edge_id = current_edge_id;
-            break;
+    scratch.touched.clear();
+    for (NodeId node_id : csr.nodes_of(current)) {
+        for (EdgeId edge_id : csr.edges_of(node_id)) {
+            if (edge_id == current || scratch.seen[side][edge_id] == epoch
+                || scratch.banned[edge_id] == epoch) continue;
+            if (scratch.overlap[edge_id]++ == 0) {
+                scratch.touched.push_back(edge_id);
+            }
         }
+    }
+    for (EdgeId edge_id : scratch.touched) {
+        if (scratch.overlap[edge_id] >= s) {
+            reach(edge_id);
+        }
+        scratch.overlap[edge_id] = 0;
+    }
+}
 
-        // Explore s-connected neighbors
-        auto neighbors = get_s_connected_neighbors(current_edge_id, min_intersection_size);
+} // namespace
 
-        for (const auto& neighbor_id : neighbors) {
-            if (visited_edges.find(neighbor_id) == visited_edges.end() &&
-                excluded_edges.find(neighbor_id) == excluded_edges.end()) {
+std::vector<EdgeId> Hypergraph::s_path_search(
+    const IncidenceCSR& csr,
+    IdSpan<EdgeId> seeds,
+    NodeId end,
+    int min_intersection_size,
+    size_t max_hops,
+    const std::vector<EdgeId>& banned
+) {
+    PathScratch& scratch = path_scratch();
+    scratch.prepare(csr.num_edge_rows(), csr.num_node_rows());
+    const uint32_t epoch = scratch.epoch;
+    const uint32_t s = static_cast<uint32_t>(std::max(min_intersection_size, 1));
+
+    for (EdgeId edge_id : banned) {
+        scratch.banned[edge_id] = epoch;
+    }
+
+    auto mark = [&](int side, EdgeId edge_id, EdgeId parent, uint32_t depth) {
+        scratch.seen[side][edge_id] = epoch;
+        scratch.parent[side][edge_id] = parent;
+        scratch.depth[side][edge_id] = depth;
+    };
+
+    // Seed both sides; an edge holding both endpoints is a one-hop path
+    EdgeId meet = INVALID_ID;
+    size_t best = std::numeric_limits<size_t>::max();
+    for (EdgeId edge_id : seeds) {
+        if (scratch.banned[edge_id] == epoch || scratch.seen[0][edge_id] == epoch) continue;
+        mark(0, edge_id, INVALID_ID, 0);
+        scratch.frontier[0].push_back(edge_id);
+    }
+    for (EdgeId edge_id : csr.edges_of(end)) {
+        if (scratch.banned[edge_id] == epoch || scratch.seen[1][edge_id] == epoch) continue;
+        mark(1, edge_id, INVALID_ID, 0);
+        scratch.frontier[1].push_back(edge_id);
+        if (scratch.seen[0][edge_id] == epoch && best > 1) {
+            meet = edge_id;
+            best = 1;
+        }
+    }
 
-                edge_queue.push(neighbor_id);
-                parent_edge[neighbor_id] = current_edge_id;
-                visited_edges.insert(neighbor_id);
+    // Expand whole levels of the smaller frontier. A meeting found during a
+    // level is optimal once that level is finished, and any path not yet
+    // seen needs at least level[0] + level[1] + 2 hops.
+    uint32_t level[2] = {0, 0};
+    while (meet == INVALID_ID && !scratch.frontier[0].empty() && !scratch.frontier[1].empty()) {
+        if (max_hops > 0 && level[0] + level[1] + 2 > max_hops) break;
+
+        const int side = scratch.frontier[0].size() <= scratch.frontier[1].size() ? 0 : 1;
+        const int other = 1 - side;
+        scratch.next.clear();
+
+        EdgeId from = INVALID_ID;
+        auto reach = [&](EdgeId edge_id) {
+            mark(side, edge_id, from, level[side] + 1);
+            scratch.next.push_back(edge_id);
+            if (scratch.seen[other][edge_id] == epoch) {
+                size_t length = level[side] + 1 + scratch.depth[other][edge_id] + 1;
+                if (length < best) {
+                    best = length;
+                    meet = edge_id;
+                }
             }
+        };
+
+        for (EdgeId current : scratch.frontier[side]) {
+            from = current;
+            expand_edge(csr, scratch, side, current, s, reach);
         }
+
+        std::swap(scratch.frontier[side], scratch.next);
+        ++level[side];
     }
 
-    // Reconstruct path
-    std::vector<HyperEdge> path;
-    if (!goal_edge_id.empty()) {
-        std::string current = goal_edge_id;
-        while (!current.empty()) {
-            path.push_back(hyperedges_.at(current));
-            current = parent_edge[current];
-        }
-        std::reverse(path.begin(), path.end());
+    std::vector<EdgeId> path;
+    if (meet == INVALID_ID || (max_hops > 0 && best > max_hops)) {
+        return path;
+    }
+
+    // Walk back to the seeds, then forward along the end side's parents
+    for (EdgeId current = meet; current != INVALID_ID; current = scratch.parent[0][current]) {
+        path.push_back(current);
+    }
+    std::reverse(path.begin(), path.end());
+    for (EdgeId current = scratch.parent[1][meet]; current != INVALID_ID; current = scratch.parent[1][current]) {
+        path.push_back(current);
     }
 
     return path;
 }
 
-bool Hypergraph::are_s_connected(
-    const HyperEdge& e1,
-    const HyperEdge& e2,
-    int min_intersection_size
+std::vector<EdgeId> Hypergraph::s_path_sweep(
+    const IncidenceCSR& csr,
+    NodeId start,
+    const std::vector<NodeId>& targets,
+    int min_intersection_size,
+    size_t max_hops
+) {
+    std::vector<EdgeId> hits(targets.size(), INVALID_ID);
+
+    std::unordered_map<NodeId, std::vector<size_t>> pending;
+    for (size_t i = 0; i < targets.size(); ++i) {
+        if (targets[i] != INVALID_ID) {
+            pending[targets[i]].push_back(i);
+        }
+    }
+
+    PathScratch& scratch = path_scratch();
+    scratch.prepare(csr.num_edge_rows(), csr.num_node_rows());
+    const uint32_t epoch = scratch.epoch;
+    const uint32_t s = static_cast<uint32_t>(std::max(min_intersection_size, 1));
+
+    // The first level an edge is reached at fixes the path length of every
+    // target it contains
+    uint32_t depth = 0;
+    EdgeId from = INVALID_ID;
+    auto reach = [&](EdgeId edge_id) {
+        scratch.seen[0][edge_id] = epoch;
+        scratch.parent[0][edge_id] = from;
+        scratch.depth[0][edge_id] = depth;
+        scratch.next.push_back(edge_id);
+        for (NodeId node_id : csr.nodes_of(edge_id)) {
+            auto it = pending.find(node_id);
+            if (it != pending.end()) {
+                for (size_t i : it->second) hits[i] = edge_id;
+                pending.erase(it);
+            }
+        }
+    };
+
+    scratch.next.clear();
+    for (EdgeId edge_id : csr.edges_of(start)) {
+        reach(edge_id);
+    }
+
+    while (!pending.empty() && !scratch.next.empty()) {
+        if (max_hops > 0 && depth + 1 >= max_hops) break;
+        std::swap(scratch.frontier[0], scratch.next);
+        scratch.next.clear();
+        ++depth;
+        for (EdgeId current : scratch.frontier[0]) {
+            from = current;
+            expand_edge(csr, scratch, 0, current, s, reach);
+        }
+    }
+
+    return hits;
+}
+
+std::vector<int> Hypergraph::find_path_lengths(
+    const std::string& start,
+    const std::vector<std::string>& targets,
+    int min_intersection_size,
+    size_t max_hops
 ) const {
-    return e1.intersection(e2).size() >= static_cast<size_t>(min_intersection_size);
+    std::vector<int> lengths(targets.size(), -1);
+
+    NodeId start_id = find_node_id(start);
+    if (start_id == INVALID_ID) {
+        return lengths;
+    }
+
+    std::vector<NodeId> target_ids;
+    target_ids.reserve(targets.size());
+    for (const auto& target : targets) {
+        target_ids.push_back(find_node_id(target));
+    }
+
+    auto csr = incidence();
+    auto hits = s_path_sweep(*csr, start_id, target_ids, min_intersection_size, max_hops);
+    const PathScratch& scratch = path_scratch();
+    for (size_t i = 0; i < hits.size(); ++i) {
+        if (hits[i] != INVALID_ID) {
+            lengths[i] = static_cast<int>(scratch.depth[0][hits[i]]) + 1;
+        }
+    }
+    return lengths;
 }
 
-std::vector<std::string> Hypergraph::get_s_connected_neighbors(
-    const std::string& edge_id,
-    int min_intersection_size
+std::vector<PathSearchResult> Hypergraph::find_k_shortest_paths_to(
+    const std::string& start,
+    const std::vector<std::string>& targets,
+    int k,
+    int min_intersection_size,
+    size_t max_hops
 ) const {
-    std::vector<std::string> neighbors;
+    std::vector<PathSearchResult> results(targets.size());
 
-    auto it = hyperedges_.find(edge_id);
-    if (it == hyperedges_.end()) return neighbors;
+    NodeId start_id = find_node_id(start);
+    if (start_id == INVALID_ID || k <= 0) {
+        return results;
+    }
 
-    const auto& edge = it->second;
+    std::vector<NodeId> target_ids;
+    target_ids.reserve(targets.size());
+    for (const auto& target : targets) {
+        target_ids.push_back(find_node_id(target));
+    }
 
-    // Check all edges that share nodes with this edge
-    std::set<std::string> candidate_edges;
-    for (const auto& node_id : edge.get_all_nodes()) {
-        auto incident = get_incident_edges(node_id);
-        for (const auto& incident_edge : incident) {
-            if (incident_edge.id != edge_id) {
-                candidate_edges.insert(incident_edge.id);
-            }
+    // Walk every shortest path back out of the scratch before the spur
+    // searches reuse it
+    auto csr = incidence();
+    auto hits = s_path_sweep(*csr, start_id, target_ids, min_intersection_size, max_hops);
+    const PathScratch& scratch = path_scratch();
+    std::vector<std::vector<EdgeId>> shortest(targets.size());
+    for (size_t i = 0; i < hits.size(); ++i) {
+        for (EdgeId current = hits[i]; current != INVALID_ID; current = scratch.parent[0][current]) {
+            shortest[i].push_back(current);
         }
+        std::reverse(shortest[i].begin(), shortest[i].end());
     }
 
-    // Filter by intersection size
-    for (const auto& candidate_id : candidate_edges) {
-        const auto& candidate = hyperedges_.at(candidate_id);
-        if (are_s_connected(edge, candidate, min_intersection_size)) {
-            neighbors.push_back(candidate_id);
+    for (size_t i = 0; i < targets.size(); ++i) {
+        if (!shortest[i].empty()) {
+            results[i] = k_shortest_from(*csr, start_id, target_ids[i], std::move(shortest[i]),
+                                         k, min_intersection_size, max_hops);
         }
     }
+    return results;
+}
 
-    return neighbors;
+size_t Hypergraph::edge_overlap(EdgeId e1, EdgeId e2) const {
+    const auto& a = edge_slots_[e1].members;
+    const auto& b = edge_slots_[e2].members;
+
+    // Both member lists are sorted, so a merge walk counts the intersection
+    size_t count = 0;
+    auto it_a = a.begin();
+    auto it_b = b.begin();
+    while (it_a != a.end() && it_b != b.end()) {
+        if (*it_a < *it_b) {
+            ++it_a;
+        } else if (*it_b < *it_a) {
+            ++it_b;
+        } else {
+            ++count;
+            ++it_a;
+            ++it_b;
+        }
+    }
+    return count;
+}
+
+std::shared_ptr<const IncidenceCSR> Hypergraph::build_incidence() const {
+    auto csr = std::make_shared<IncidenceCSR>();
+
+    // Counting pass: row lengths become offsets
+    csr->node_offsets.assign(node_slots_.size() + 1, 0);
+    for (size_t n = 0; n < node_slots_.size(); ++n) {
+        csr->node_offsets[n + 1] = csr->node_offsets[n] + node_slots_[n].edges.size();
+    }
+    csr->edge_offsets.assign(edge_slots_.size() + 1, 0);
+    for (size_t e = 0; e < edge_slots_.size(); ++e) {
+        csr->edge_offsets[e + 1] = csr->edge_offsets[e] + edge_slots_[e].members.size();
+    }
+
+    // Fill pass: dead slots have empty vectors and produce empty rows
+    csr->node_edges.reserve(csr->node_offsets.back());
+    for (const auto& slot : node_slots_) {
+        csr->node_edges.insert(csr->node_edges.end(), slot.edges.begin(), slot.edges.end());
+    }
+    csr->edge_nodes.reserve(csr->edge_offsets.back());
+    for (const auto& slot : edge_slots_) {
+        csr->edge_nodes.insert(csr->edge_nodes.end(), slot.members.begin(), slot.members.end());
+    }
+
+    return csr;
 }
 
 void Hypergraph::merge_nodes(const std::string& keep_id, const std::string& remove_id) {
-    std::string normalized_keep = normalize_node_id(keep_id);
-    std::string normalized_remove = normalize_node_id(remove_id);
-
-    if (!has_node(normalized_keep) || !has_node(normalized_remove)) return;
-
-    // Transfer incident edges
-    auto incident = get_incident_edges(normalized_remove);
-    for (const auto& edge : incident) {
-        auto* mutable_edge = get_hyperedge(edge.id);
-        if (mutable_edge) {
-            // Replace remove_id with keep_id in sources
-            for (auto& src : mutable_edge->sources) {
-                if (src == normalized_remove) src = normalized_keep;
+    NodeId keep = find_node_id(keep_id);
+    NodeId remove = find_node_id(remove_id);
+
+    if (keep == INVALID_ID || remove == INVALID_ID || keep == remove) return;
+
+    const std::string keep_name = node_slots_[keep].node.id;
+
+    // Transfer incident edges: rewrite each edge in place and move it from
+    // the removed node's incidence list to the kept node's
+    std::vector<EdgeId> incident = node_slots_[remove].edges;
+    for (EdgeId edge_id : incident) {
+        observers_.notify([&](HypergraphObserver& o) { o.on_edge_updating(*this, edge_id); });
+        remove_from_indices(edge_id);
+
+        unindex_signature(edge_id);
+
+        auto& slot = edge_slots_[edge_id];
+        for (size_t i = 0; i < slot.sources.size(); ++i) {
+            if (slot.sources[i] == remove) {
+                slot.sources[i] = keep;
+                slot.edge.sources[i] = keep_name;
             }
-            // Replace in targets
-            for (auto& tgt : mutable_edge->targets) {
-                if (tgt == normalized_remove) tgt = normalized_keep;
+        }
+        for (size_t i = 0; i < slot.targets.size(); ++i) {
+            if (slot.targets[i] == remove) {
+                slot.targets[i] = keep;
+                slot.edge.targets[i] = keep_name;
             }
         }
+        rebuild_members(slot);
+
+        update_indices(edge_id);
+        index_signature(edge_id);
+        observers_.notify([&](HypergraphObserver& o) { o.on_edge_updated(*this, edge_id); });
     }
+    ++generation_;
 
-    // Remove the node
-    remove_node(normalized_remove);
+    // Remove the node (now without incident edges)
+    remove_node_at(remove);
 }
 
 std::vector<std::vector<std::string>> Hypergraph::find_similarity_components(
@@ -917,104 +1713,129 @@ double Hypergraph::cosine_similarity(
         return 0.0;
     }
 
-    double dot_product = 0.0;
-    double norm1 = 0.0;
-    double norm2 = 0.0;
-
-    for (size_t i = 0; i < vec1.size(); ++i) {
-        dot_product += vec1[i] * vec2[i];
-        norm1 += vec1[i] * vec1[i];
-        norm2 += vec2[i] * vec2[i];
-    }
+    return vec::cosine(vec1.data(), vec2.data(), vec1.size());
+}
 
-    if (norm1 == 0.0 || norm2 == 0.0) {
-        return 0.0;
-    }
+// Byte classification for normalize_node_id: ASCII is handled inline, other
+// bytes go through the C library as before
+static bool is_space_byte(unsigned char c) {
+    if (c < 128) return c == ' ' || (c >= '\t' && c <= '\r');
+    return std::isspace(c) != 0;
+}
 
-    return dot_product / (std::sqrt(norm1) * std::sqrt(norm2));
+static char lower_byte(unsigned char c) {
+    if (c < 128) return static_cast<char>(c >= 'A' && c <= 'Z' ? c + ('a' - 'A') : c);
+    return static_cast<char>(std::tolower(c));
 }
 
-// Helper: check if string is pure ASCII alphabetic
-static bool is_ascii_alpha_word(const std::string& text) {
+static bool is_ascii_alpha_word(std::string_view text) {
     if (text.empty()) return false;
     for (unsigned char c : text) {
-        if (c >= 128 || !std::isalpha(c)) return false;
+        if (!((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z'))) return false;
     }
     return true;
 }
 
-// Helper: singularize a single ASCII word (basic English rules)
-static std::string singularize_word(const std::string& word) {
-    if (word.size() <= 3) return word;
-    if (!is_ascii_alpha_word(word)) return word;
+static bool ends_with(std::string_view text, std::string_view suffix) {
+    return text.size() >= suffix.size() && text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+// Singularize the word text[word_start..] in place (basic English rules);
+// every rule shortens the word, so this never reallocates
+static void singularize_word(std::string& text, size_t word_start) {
+    std::string_view word(text.data() + word_start, text.size() - word_start);
+    if (word.size() <= 3) return;
+    if (!is_ascii_alpha_word(word)) return;
 
     // "ies" -> "y" (e.g., "studies" -> "study")
-    if (word.size() >= 4 && word.compare(word.size() - 3, 3, "ies") == 0) {
-        return word.substr(0, word.size() - 3) + "y";
+    if (ends_with(word, "ies")) {
+        text.resize(text.size() - 2);
+        text.back() = 'y';
+        return;
     }
     // "ches", "shes", "xes", "ses", "zes" -> remove "es"
-    if (word.size() >= 4 &&
-        (word.compare(word.size() - 4, 4, "ches") == 0 ||
-         word.compare(word.size() - 4, 4, "shes") == 0 ||
-         word.compare(word.size() - 3, 3, "xes") == 0 ||
-         word.compare(word.size() - 3, 3, "ses") == 0 ||
-         word.compare(word.size() - 3, 3, "zes") == 0)) {
-        return word.substr(0, word.size() - 2);
+    if (ends_with(word, "ches") || ends_with(word, "shes") || ends_with(word, "xes") ||
+        ends_with(word, "ses") || ends_with(word, "zes")) {
+        text.resize(text.size() - 2);
+        return;
     }
     // Don't singularize words ending in "ss" (e.g., "class", "process")
-    if (word.size() >= 2 && word.compare(word.size() - 2, 2, "ss") == 0) {
-        return word;
+    if (ends_with(word, "ss")) {
+        return;
     }
     // Remove trailing "s"
-    if (!word.empty() && word.back() == 's') {
-        return word.substr(0, word.size() - 1);
+    if (word.back() == 's') {
+        text.pop_back();
     }
-    return word;
 }
 
 std::string Hypergraph::normalize_node_id(const std::string& label) {
     std::string result;
-    result.reserve(label.size());
+    normalize_node_id(label, result);
+    return result;
+}
 
-    // Trim leading whitespace
+void Hypergraph::normalize_node_id(std::string_view label, std::string& out) {
+    // Trim whitespace
     size_t start = 0;
-    while (start < label.size() && std::isspace(static_cast<unsigned char>(label[start]))) {
-        ++start;
-    }
-
-    // Trim trailing whitespace
     size_t end = label.size();
-    while (end > start && std::isspace(static_cast<unsigned char>(label[end - 1]))) {
-        --end;
-    }
+    while (start < end && is_space_byte(static_cast<unsigned char>(label[start]))) ++start;
+    while (end > start && is_space_byte(static_cast<unsigned char>(label[end - 1]))) --end;
 
     // Convert to lowercase
+    out.resize(end - start);
     for (size_t i = start; i < end; ++i) {
-        result += static_cast<char>(std::tolower(static_cast<unsigned char>(label[i])));
+        out[i - start] = lower_byte(static_cast<unsigned char>(label[i]));
     }
 
     // Singularize: for multi-word entities, singularize the last word
     // For single-word entities, singularize the whole word
     // e.g., "knowledge graphs" -> "knowledge graph"
     //       "houses" -> "house"
-    size_t last_space = result.rfind(' ');
-    if (last_space != std::string::npos) {
-        // Multi-word: singularize last word only
-        std::string prefix = result.substr(0, last_space + 1);
-        std::string last_word = result.substr(last_space + 1);
-        result = prefix + singularize_word(last_word);
-    } else {
-        // Single word: singularize the whole thing
-        result = singularize_word(result);
-    }
+    size_t last_space = out.rfind(' ');
+    singularize_word(out, last_space != std::string::npos ? last_space + 1 : 0);
+}
 
+std::vector<std::string> Hypergraph::normalize_node_ids(const std::vector<std::string>& labels,
+                                                        size_t num_threads) {
+    std::vector<std::string> result(labels.size());
+    // Small batches are not worth waking workers for
+    constexpr size_t MIN_PARALLEL_BATCH = 4096;
+    if (labels.size() < MIN_PARALLEL_BATCH) num_threads = 1;
+    parallel_for_shards(labels.size(), num_threads, [&](size_t, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) normalize_node_id(labels[i], result[i]);
+    });
     return result;
 }
 
 void Hypergraph::clear() {
-    nodes_.clear();
-    hyperedges_.clear();
-    node_to_edges_.clear();
+    node_slots_.clear();
+    edge_slots_.clear();
+    node_lookup_.clear();
+    edge_lookup_.clear();
+    live_nodes_ = 0;
+    live_edges_ = 0;
+    edge_size_counts_.clear();
+    degree_counts_.clear();
+    total_edge_size_ = 0;
+    total_degree_ = 0;
+    signature_index_.clear();
+    signature_index_valid_ = false;
+    ++generation_;
+
+    observers_.notify([&](HypergraphObserver& o) { o.on_cleared(*this); });
+}
+
+void Hypergraph::add_observer(HypergraphObserver* observer) {
+    auto& list = observers_.observers;
+    if (std::find(list.begin(), list.end(), observer) == list.end()) {
+        list.push_back(observer);
+    }
+}
+
+void Hypergraph::remove_observer(HypergraphObserver* observer) {
+    auto& list = observers_.observers;
+    list.erase(std::remove(list.begin(), list.end(), observer), list.end());
 }
 
 } // namespace kg
@@ -1,4 +1,6 @@
 #include "graph/hypergraph.hpp"
+#include "util/parallel.hpp"
+#include <atomic>
 #include <fstream>
 #include <cmath>
 #include <algorithm>
@@ -17,15 +19,18 @@ nlohmann::json Hypergraph::to_json(bool include_metadata) const {
 
     // Export nodes
     nlohmann::json nodes_json = nlohmann::json::array();
-    for (const auto& [id, node] : nodes_) {
-        nodes_json.push_back(node.to_json());
+    for (const auto& slot : node_slots_) {
+        if (slot.alive) {
+            nodes_json.push_back(slot.node.to_json());
+        }
     }
     j["nodes"] = nodes_json;
 
     // Export hyperedges
     nlohmann::json edges_json = nlohmann::json::array();
-    for (const auto& [id, edge] : hyperedges_) {
-        auto edge_json = edge.to_json();
+    for (const auto& slot : edge_slots_) {
+        if (!slot.alive) continue;
+        auto edge_json = slot.edge.to_json();
         if (!include_metadata) {
             edge_json.erase("source_document");
             edge_json.erase("source_chunk_id");
@@ -38,21 +43,44 @@ nlohmann::json Hypergraph::to_json(bool include_metadata) const {
 
     // Add statistics
     j["metadata"] = {
-        {"num_nodes", nodes_.size()},
-        {"num_edges", hyperedges_.size()}
+        {"num_nodes", live_nodes_},
+        {"num_edges", live_edges_},
+        {"normalized", true}
     };
 
     return j;
 }
 
-void Hypergraph::export_to_json(const std::string& filename, bool include_metadata) const {
-    std::ofstream file(filename);
-    if (!file.is_open()) {
-        throw std::runtime_error("Failed to open file for writing: " + filename);
+void Hypergraph::write_json(std::ostream& out, bool include_metadata, bool compact) const {
+    JsonWriter writer(out, compact);
+    writer.begin_object();
+
+    // Metadata first so streaming readers see the normalized flag up front
+    writer.key("metadata").begin_object();
+    writer.member("num_nodes", live_nodes_);
+    writer.member("num_edges", live_edges_);
+    writer.member("normalized", true);
+    writer.end_object();
+
+    writer.key("nodes").begin_array();
+    for (const auto& slot : node_slots_) {
+        if (slot.alive) slot.node.write_json(writer);
+    }
+    writer.end_array();
+
+    writer.key("hyperedges").begin_array();
+    for (const auto& slot : edge_slots_) {
+        if (slot.alive) slot.edge.write_json(writer, include_metadata);
     }
+    writer.end_array();
+
+    writer.end_object();
+}
 
-    auto j = to_json(include_metadata);
-    file << j.dump(2);  // Pretty print with 2-space indentation
+void Hypergraph::export_to_json(const std::string& filename, bool include_metadata,
+                                const JsonWriteOptions& options) const {
+    JsonOutputFile file(filename, options);
+    write_json(file.stream(), include_metadata, options.compact);
     file.close();
 }
 
@@ -67,15 +95,18 @@ void Hypergraph::export_to_dot(const std::string& filename) const {
     file << "  node [shape=ellipse, style=filled, color=lightblue];\n\n";
 
     // Write nodes
-    for (const auto& [id, node] : nodes_) {
-        file << "  \"" << id << "\" [label=\"" << node.label << "\"];\n";
+    for (const auto& slot : node_slots_) {
+        if (!slot.alive) continue;
+        file << "  \"" << slot.node.id << "\" [label=\"" << slot.node.label << "\"];\n";
     }
 
     file << "\n";
 
     // Write hyperedges as relation nodes
     int rel_counter = 0;
-    for (const auto& [id, edge] : hyperedges_) {
+    for (const auto& slot : edge_slots_) {
+        if (!slot.alive) continue;
+        const auto& edge = slot.edge;
         std::string rel_node_id = "rel_" + std::to_string(rel_counter++);
 
         // Create relation node (diamond)
@@ -103,31 +134,42 @@ void Hypergraph::export_to_dot(const std::string& filename) const {
 nlohmann::json Hypergraph::to_incidence_matrix() const {
     nlohmann::json j;
 
-    // Create ordered lists
+    // Create ordered lists (rows and columns sorted by string ID)
+    std::vector<NodeId> node_order;
+    for (NodeId id = 0; id < node_slots_.size(); ++id) {
+        if (node_slots_[id].alive) node_order.push_back(id);
+    }
+    std::sort(node_order.begin(), node_order.end(), [this](NodeId a, NodeId b) {
+        return node_slots_[a].node.id < node_slots_[b].node.id;
+    });
+
+    std::vector<EdgeId> edge_order;
+    for (EdgeId id = 0; id < edge_slots_.size(); ++id) {
+        if (edge_slots_[id].alive) edge_order.push_back(id);
+    }
+    std::sort(edge_order.begin(), edge_order.end(), [this](EdgeId a, EdgeId b) {
+        return edge_slots_[a].edge.id < edge_slots_[b].edge.id;
+    });
+
     std::vector<std::string> node_list;
-    for (const auto& [id, node] : nodes_) {
-        node_list.push_back(id);
+    std::vector<size_t> row_of(node_slots_.size(), 0);
+    for (size_t i_idx = 0; i_idx < node_order.size(); ++i_idx) {
+        node_list.push_back(node_slots_[node_order[i_idx]].node.id);
+        row_of[node_order[i_idx]] = i_idx;
     }
-    std::sort(node_list.begin(), node_list.end());
 
     std::vector<std::string> edge_list;
-    for (const auto& [id, edge] : hyperedges_) {
-        edge_list.push_back(id);
+    for (EdgeId id : edge_order) {
+        edge_list.push_back(edge_slots_[id].edge.id);
     }
-    std::sort(edge_list.begin(), edge_list.end());
 
     // Build matrix
     std::vector<std::vector<int>> matrix(node_list.size(),
                                          std::vector<int>(edge_list.size(), 0));
 
-    for (size_t j_idx = 0; j_idx < edge_list.size(); ++j_idx) {
-        const auto& edge = hyperedges_.at(edge_list[j_idx]);
-        auto all_nodes = edge.get_all_nodes();
-
-        for (size_t i_idx = 0; i_idx < node_list.size(); ++i_idx) {
-            if (all_nodes.find(node_list[i_idx]) != all_nodes.end()) {
-                matrix[i_idx][j_idx] = 1;
-            }
+    for (size_t j_idx = 0; j_idx < edge_order.size(); ++j_idx) {
+        for (NodeId node_id : edge_slots_[edge_order[j_idx]].members) {
+            matrix[row_of[node_id]][j_idx] = 1;
         }
     }
 
@@ -140,85 +182,448 @@ nlohmann::json Hypergraph::to_incidence_matrix() const {
 
 Hypergraph Hypergraph::from_json(const nlohmann::json& j) {
     Hypergraph graph;
+    bool normalized = j.contains("metadata") && j["metadata"].value("normalized", false);
 
     // Load nodes
     if (j.contains("nodes")) {
         for (const auto& node_json : j["nodes"]) {
-            auto node = HyperNode::from_json(node_json);
-            graph.add_node(node);
+            graph.insert_node(HyperNode::from_json(node_json), normalized);
         }
     }
 
     // Load hyperedges
     if (j.contains("hyperedges")) {
         for (const auto& edge_json : j["hyperedges"]) {
-            auto edge = HyperEdge::from_json(edge_json);
-            graph.add_hyperedge(edge);
+            graph.insert_hyperedge(HyperEdge::from_json(edge_json), normalized);
         }
     }
 
     return graph;
 }
 
-Hypergraph Hypergraph::load_from_json(const std::string& filename) {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        throw std::runtime_error("Failed to open file for reading: " + filename);
+namespace {
+
+/**
+ * @brief SAX consumer that assembles nodes and hyperedges as tokens arrive
+ *
+ * Only one record is materialized at a time; finished records go to the
+ * sinks. Unknown keys and projected-out fields are skipped without
+ * allocating their values.
+ */
+class GraphSaxHandler : public nlohmann::json_sax<nlohmann::json> {
+public:
+    using NodeSink = std::function<void(HyperNode&&)>;
+    using EdgeSink = std::function<void(HyperEdge&&)>;
+
+    GraphSaxHandler(const JsonLoadOptions& options, NodeSink on_node, EdgeSink on_edge)
+        : options_(options), on_node_(std::move(on_node)), on_edge_(std::move(on_edge)) {}
+
+    bool normalized_flag() const { return normalized_flag_; }
+    bool nodes_done() const { return nodes_done_; }
+
+    // Scalars
+    bool null() override {
+        skip_scalar();                                 // Null reads as an absent field
+        return true;
+    }
+    bool boolean(bool value) override {
+        if (skip_scalar()) return true;
+        if (section_ == Section::Metadata && depth_ == 2 && field_ == Field::Normalized) {
+            normalized_flag_ = value;
+            return true;
+        }
+        return type_error("boolean");
+    }
+    bool number_integer(number_integer_t value) override { return number(static_cast<double>(value)); }
+    bool number_unsigned(number_unsigned_t value) override { return number(static_cast<double>(value)); }
+    bool number_float(number_float_t value, const string_t&) override { return number(value); }
+    bool binary(binary_t&) override { return skip_scalar() || type_error("binary"); }
+
+    bool string(string_t& value) override {
+        if (skip_scalar()) return true;
+        if (depth_ == 3 && section_ == Section::Nodes) {
+            if (field_ == Field::Id) { node_.id = std::move(value); has_id_ = true; return true; }
+            if (field_ == Field::Label) { node_.label = std::move(value); has_label_ = true; return true; }
+        } else if (depth_ == 3 && section_ == Section::Edges) {
+            switch (field_) {
+                case Field::Id: edge_.id = std::move(value); has_id_ = true; return true;
+                case Field::Relation: edge_.relation = std::move(value); has_label_ = true; return true;
+                case Field::Document: edge_.source_document = std::move(value); return true;
+                case Field::Chunk: edge_.source_chunk_id = std::move(value); return true;
+                default: break;
+            }
+        } else if (depth_ == 4 && field_ == Field::Properties) {
+            auto& properties = section_ == Section::Nodes ? node_.properties : edge_.properties;
+            properties[std::move(property_key_)] = std::move(value);
+            return true;
+        } else if (depth_ == 4 && section_ == Section::Edges) {
+            if (field_ == Field::Sources) { edge_.sources.push_back(std::move(value)); return true; }
+            if (field_ == Field::Targets) { edge_.targets.push_back(std::move(value)); return true; }
+        }
+        return type_error("string");
     }
 
-    nlohmann::json j;
-    file >> j;
-    file.close();
+    // Containers
+    bool start_object(std::size_t) override {
+        if (enter_container()) return true;
+        if (depth_ == 1) return true;
+        if (depth_ == 2 && section_ == Section::Metadata) return true;
+        if (depth_ == 3 && section_ != Section::Metadata) return begin_record();
+        if (depth_ == 4 && field_ == Field::Properties) return true;
+        return type_error("object");
+    }
+
+    bool end_object() override {
+        if (leave_container()) return true;
+        if (depth_ == 3) finish_record();
+        if (depth_ == 2) section_ = Section::None;
+        --depth_;
+        return true;
+    }
+
+    bool start_array(std::size_t) override {
+        if (enter_container()) return true;
+        if (depth_ == 2 && (section_ == Section::Nodes || section_ == Section::Edges)) return true;
+        if (depth_ == 4 && (field_ == Field::Embedding || field_ == Field::Sources ||
+                            field_ == Field::Targets)) {
+            if (field_ == Field::Sources) has_sources_ = true;
+            if (field_ == Field::Targets) has_targets_ = true;
+            return true;
+        }
+        return type_error("array");
+    }
+
+    bool end_array() override {
+        if (leave_container()) return true;
+        if (depth_ == 2) {
+            if (section_ == Section::Nodes) nodes_done_ = true;
+            section_ = Section::None;
+        }
+        --depth_;
+        return true;
+    }
+
+    bool key(string_t& name) override {
+        if (skip_depth_ > 0) return true;
+        if (depth_ == 1) {
+            section_ = name == "nodes" ? Section::Nodes
+                     : name == "hyperedges" ? Section::Edges
+                     : name == "metadata" ? Section::Metadata
+                     : Section::None;
+            skip_next_ = section_ == Section::None;
+        } else if (depth_ == 2) {
+            field_ = name == "normalized" ? Field::Normalized : Field::None;
+            skip_next_ = field_ == Field::None;
+        } else if (depth_ == 3) {
+            field_ = section_ == Section::Nodes ? node_field(name) : edge_field(name);
+            skip_next_ = field_ == Field::None;
+        } else {
+            property_key_ = std::move(name);
+        }
+        return true;
+    }
+
+    bool parse_error(std::size_t position, const std::string&,
+                     const nlohmann::detail::exception& error) override {
+        throw std::runtime_error("Failed to parse hypergraph JSON at byte " +
+                                 std::to_string(position) + ": " + error.what());
+    }
+
+private:
+    enum class Section { None, Nodes, Edges, Metadata };
+    enum class Field {
+        None, Id, Label, Properties, Embedding, Sources, Targets, Relation,
+        Confidence, Document, Chunk, Page, Normalized
+    };
+
+    Field node_field(const std::string& name) const {
+        if (name == "id") return Field::Id;
+        if (name == "label") return Field::Label;
+        if (name == "properties" && options_.node_properties) return Field::Properties;
+        if (name == "embedding" && options_.embeddings) return Field::Embedding;
+        return Field::None;                            // degree and incident_edges are derived
+    }
+
+    Field edge_field(const std::string& name) const {
+        if (name == "id") return Field::Id;
+        if (name == "sources") return Field::Sources;
+        if (name == "targets") return Field::Targets;
+        if (name == "relation") return Field::Relation;
+        if (name == "confidence") return Field::Confidence;
+        if (name == "properties" && options_.edge_properties) return Field::Properties;
+        if (options_.provenance) {
+            if (name == "source_document") return Field::Document;
+            if (name == "source_chunk_id") return Field::Chunk;
+            if (name == "source_page") return Field::Page;
+        }
+        return Field::None;
+    }
+
+    bool number(double value) {
+        if (skip_scalar()) return true;
+        if (depth_ == 4 && field_ == Field::Embedding) {
+            node_.embedding.push_back(static_cast<float>(value));
+            return true;
+        }
+        if (depth_ == 3 && section_ == Section::Edges) {
+            if (field_ == Field::Confidence) { edge_.confidence = value; return true; }
+            if (field_ == Field::Page) { edge_.source_page = static_cast<int>(value); return true; }
+        }
+        return type_error("number");
+    }
+
+    // A skipped scalar value consumes the pending skip
+    bool skip_scalar() {
+        if (skip_depth_ > 0) return true;
+        if (skip_next_) {
+            skip_next_ = false;
+            return true;
+        }
+        return false;
+    }
+
+    bool enter_container() {
+        ++depth_;
+        if (skip_depth_ > 0) return true;
+        if (skip_next_) {
+            skip_next_ = false;
+            skip_depth_ = depth_;
+            return true;
+        }
+        return false;
+    }
+
+    bool leave_container() {
+        if (skip_depth_ == 0) return false;
+        if (skip_depth_ == depth_) skip_depth_ = 0;
+        --depth_;
+        return true;
+    }
+
+    bool begin_record() {
+        node_ = HyperNode();
+        edge_ = HyperEdge();
+        has_id_ = has_label_ = has_sources_ = has_targets_ = false;
+        return true;
+    }
+
+    void finish_record() {
+        if (section_ == Section::Nodes) {
+            if (!has_id_ || !has_label_) {
+                throw std::runtime_error("Hypergraph JSON node is missing \"id\" or \"label\"");
+            }
+            on_node_(std::move(node_));
+        } else {
+            if (!has_id_ || !has_label_ || !has_sources_ || !has_targets_) {
+                throw std::runtime_error(
+                    "Hypergraph JSON hyperedge is missing \"id\", \"relation\", \"sources\" or \"targets\"");
+            }
+            on_edge_(std::move(edge_));
+        }
+        field_ = Field::None;
+    }
+
+    [[noreturn]] bool type_error(const char* kind) {
+        throw std::runtime_error(std::string("Unexpected JSON ") + kind + " in hypergraph file");
+    }
+
+    const JsonLoadOptions& options_;
+    NodeSink on_node_;
+    EdgeSink on_edge_;
 
-    return from_json(j);
+    size_t depth_ = 0;
+    size_t skip_depth_ = 0;                            // Depth of the container being skipped (0 = none)
+    bool skip_next_ = false;                           // Skip the value following the current key
+    Section section_ = Section::None;
+    Field field_ = Field::None;
+    std::string property_key_;
+
+    HyperNode node_;
+    HyperEdge edge_;
+    bool has_id_ = false;
+    bool has_label_ = false;                           // Node label or edge relation
+    bool has_sources_ = false;
+    bool has_targets_ = false;
+
+    bool normalized_flag_ = false;
+    bool nodes_done_ = false;
+};
+
+} // anonymous namespace
+
+Hypergraph Hypergraph::load_from_json_stream(std::istream& input, const JsonLoadOptions& options) {
+    Hypergraph graph;
+    std::vector<HyperEdge> pending_edges;
+    bool started = false;
+    bool normalized = false;
+    GraphSaxHandler* handler_ptr = nullptr;
+
+    // Normalization is decided once, before the first insert, so every ID
+    // in the graph goes through the same path
+    auto start = [&]() {
+        if (!started) {
+            started = true;
+            normalized = options.trust_normalized_flag && handler_ptr->normalized_flag();
+        }
+    };
+
+    GraphSaxHandler handler(
+        options,
+        [&](HyperNode&& node) {
+            start();
+            graph.insert_node(std::move(node), normalized);
+        },
+        [&](HyperEdge&& edge) {
+            if (!handler_ptr->nodes_done()) {
+                pending_edges.push_back(std::move(edge));
+                return;
+            }
+            start();
+            graph.insert_hyperedge(std::move(edge), normalized);
+        });
+    handler_ptr = &handler;
+
+    if (!nlohmann::json::sax_parse(input, &handler)) {
+        throw std::runtime_error("Failed to parse hypergraph JSON");
+    }
+
+    start();
+    for (auto& edge : pending_edges) {
+        graph.insert_hyperedge(std::move(edge), normalized);
+    }
+
+    return graph;
+}
+
+Hypergraph Hypergraph::load_from_json(const std::string& filename, const JsonLoadOptions& options) {
+    auto input = open_json_input(filename);
+    return load_from_json_stream(*input, options);
 }
 
 // ==========================================
 // Advanced Graph Operations
 // ==========================================
 
-std::vector<std::set<std::string>> Hypergraph::find_s_connected_components(
-    int min_intersection_size
-) const {
-    std::vector<std::set<std::string>> components;
-    std::set<std::string> visited;
+namespace {
 
-    for (const auto& [edge_id, edge] : hyperedges_) {
-        if (visited.find(edge_id) != visited.end()) continue;
+// Union-find that tolerates concurrent unite() calls: roots are linked from
+// the larger handle to the smaller with a CAS, and find() halves paths
+class ConcurrentUnionFind {
+public:
+    explicit ConcurrentUnionFind(size_t size) : parent_(size) {
+        for (size_t i = 0; i < size; ++i) {
+            parent_[i].store(static_cast<uint32_t>(i), std::memory_order_relaxed);
+        }
+    }
 
-        // BFS/DFS to find component
-        std::set<std::string> component;
-        std::queue<std::string> queue;
-        queue.push(edge_id);
+    uint32_t find(uint32_t x) {
+        uint32_t parent = parent_[x].load(std::memory_order_acquire);
+        while (parent != x) {
+            uint32_t grandparent = parent_[parent].load(std::memory_order_acquire);
+            if (grandparent == parent) {
+                return parent;
+            }
+            // Links only ever point at smaller roots, so skipping ahead is
+            // safe even if another thread already moved this entry
+            parent_[x].compare_exchange_weak(parent, grandparent, std::memory_order_acq_rel);
+            x = grandparent;
+            parent = parent_[x].load(std::memory_order_acquire);
+        }
+        return x;
+    }
 
-        while (!queue.empty()) {
-            std::string current_id = queue.front();
-            queue.pop();
+    void unite(uint32_t a, uint32_t b) {
+        while (true) {
+            a = find(a);
+            b = find(b);
+            if (a == b) return;
+            if (a < b) std::swap(a, b);
+            uint32_t expected = a;
+            if (parent_[a].compare_exchange_strong(expected, b, std::memory_order_acq_rel)) {
+                return;
+            }
+        }
+    }
+
+private:
+    std::vector<std::atomic<uint32_t>> parent_;
+};
 
-            if (visited.find(current_id) != visited.end()) continue;
+} // namespace
 
-            visited.insert(current_id);
-            component.insert(current_id);
+std::vector<std::set<std::string>> Hypergraph::find_s_connected_components(
+    int min_intersection_size
+) const {
+    return std::move(find_s_connected_components_multi({min_intersection_size})[min_intersection_size]);
+}
 
-            // Find s-connected neighbors
-            auto neighbors = get_s_connected_neighbors(current_id, min_intersection_size);
-            for (const auto& neighbor_id : neighbors) {
-                if (visited.find(neighbor_id) == visited.end()) {
-                    queue.push(neighbor_id);
+std::map<int, std::vector<std::set<std::string>>> Hypergraph::find_s_connected_components_multi(
+    const std::vector<int>& s_values,
+    size_t num_threads
+) const {
+    std::map<int, std::vector<std::set<std::string>>> result;
+    if (s_values.empty()) {
+        return result;
+    }
+
+    // Every co-incident pair shares at least one node, so s <= 1 all
+    // collapse to the same threshold
+    std::vector<uint32_t> thresholds;
+    for (int s : s_values) {
+        thresholds.push_back(static_cast<uint32_t>(std::max(s, 1)));
+    }
+    std::sort(thresholds.begin(), thresholds.end());
+    thresholds.erase(std::unique(thresholds.begin(), thresholds.end()), thresholds.end());
+
+    auto csr = incidence();
+    const size_t num_edges = csr->num_edge_rows();
+    std::vector<std::unique_ptr<ConcurrentUnionFind>> forests;
+    for (size_t t = 0; t < thresholds.size(); ++t) {
+        forests.push_back(std::make_unique<ConcurrentUnionFind>(num_edges));
+    }
+
+    // Each pair is seen once, from its lower edge, and joined in every
+    // forest whose threshold its overlap meets
+    parallel_for_shards(num_edges, num_threads, [&](size_t, size_t begin, size_t end) {
+        std::vector<uint32_t> overlap(num_edges, 0);
+        std::vector<EdgeId> touched;
+        for (size_t edge_id = begin; edge_id < end; ++edge_id) {
+            if (!edge_slots_[edge_id].alive) continue;
+            EdgeId current = static_cast<EdgeId>(edge_id);
+            for_each_overlap(*csr, current, true, overlap, touched, [&](EdgeId other, uint32_t shared) {
+                for (size_t t = 0; t < thresholds.size() && thresholds[t] <= shared; ++t) {
+                    forests[t]->unite(current, other);
                 }
+            });
+        }
+    });
+
+    // Components are emitted in order of their lowest edge, then sorted by size
+    std::map<uint32_t, std::vector<std::set<std::string>>> by_threshold;
+    std::vector<size_t> component_of(num_edges);
+    for (size_t t = 0; t < thresholds.size(); ++t) {
+        auto& components = by_threshold[thresholds[t]];
+        std::fill(component_of.begin(), component_of.end(), std::numeric_limits<size_t>::max());
+        for (EdgeId edge_id = 0; edge_id < num_edges; ++edge_id) {
+            if (!edge_slots_[edge_id].alive) continue;
+            uint32_t root = forests[t]->find(edge_id);
+            if (component_of[root] == std::numeric_limits<size_t>::max()) {
+                component_of[root] = components.size();
+                components.emplace_back();
             }
+            components[component_of[root]].insert(edge_slots_[edge_id].edge.id);
         }
 
-        if (!component.empty()) {
-            components.push_back(component);
-        }
+        // Sort by size (largest first)
+        std::sort(components.begin(), components.end(),
+                  [](const auto& a, const auto& b) { return a.size() > b.size(); });
     }
 
-    // Sort by size (largest first)
-    std::sort(components.begin(), components.end(),
-              [](const auto& a, const auto& b) { return a.size() > b.size(); });
+    for (int s : s_values) {
+        result[s] = by_threshold[static_cast<uint32_t>(std::max(s, 1))];
+    }
 
-    return components;
+    return result;
 }
 
 std::set<std::string> Hypergraph::get_neighborhood(
@@ -227,35 +632,34 @@ std::set<std::string> Hypergraph::get_neighborhood(
     int min_intersection_size
 ) const {
     (void)min_intersection_size;
-    if (!has_node(node_id) || hops < 0) {
+    NodeId start = find_node_id(node_id);
+    if (start == INVALID_ID || hops < 0) {
         return {};
     }
 
+    auto csr = incidence();
     std::set<std::string> neighborhood;
-    std::set<std::string> current_level = {node_id};
-    std::set<std::string> visited_nodes = {node_id};
-
-    for (int h = 0; h < hops; ++h) {
-        std::set<std::string> next_level;
-
-        for (const auto& current_node : current_level) {
-            // Get incident edges
-            auto incident = get_incident_edges(current_node);
-
-            for (const auto& edge : incident) {
-                // Add all nodes from this edge
-                auto nodes = edge.get_all_nodes();
-                for (const auto& n : nodes) {
-                    if (visited_nodes.find(n) == visited_nodes.end()) {
-                        next_level.insert(n);
-                        visited_nodes.insert(n);
-                        neighborhood.insert(n);
+    std::vector<NodeId> current_level = {start};
+    std::vector<char> visited_nodes(csr->num_node_rows(), 0);
+    visited_nodes[start] = 1;
+
+    for (int h = 0; h < hops && !current_level.empty(); ++h) {
+        std::vector<NodeId> next_level;
+
+        for (NodeId current_node : current_level) {
+            // Add all nodes from each incident edge
+            for (EdgeId edge_id : csr->edges_of(current_node)) {
+                for (NodeId n : csr->nodes_of(edge_id)) {
+                    if (!visited_nodes[n]) {
+                        visited_nodes[n] = 1;
+                        next_level.push_back(n);
+                        neighborhood.insert(node_slots_[n].node.id);
                     }
                 }
             }
         }
 
-        current_level = next_level;
+        current_level = std::move(next_level);
     }
 
     return neighborhood;
@@ -263,29 +667,26 @@ std::set<std::string> Hypergraph::get_neighborhood(
 
 Hypergraph Hypergraph::extract_subgraph(const std::set<std::string>& node_ids) const {
     Hypergraph subgraph;
+    std::vector<char> included(node_slots_.size(), 0);
 
     // Add nodes
     for (const auto& node_id : node_ids) {
-        auto* node = get_node(node_id);
-        if (node) {
-            subgraph.add_node(*node);
+        NodeId id = find_node_id(node_id);
+        if (id != INVALID_ID) {
+            included[id] = 1;
+            subgraph.add_node(node_slots_[id].node);
         }
     }
 
     // Add hyperedges where all nodes are in the set
-    for (const auto& [id, edge] : hyperedges_) {
-        auto edge_nodes = edge.get_all_nodes();
+    for (const auto& slot : edge_slots_) {
+        if (!slot.alive) continue;
 
-        bool all_included = true;
-        for (const auto& n : edge_nodes) {
-            if (node_ids.find(n) == node_ids.end()) {
-                all_included = false;
-                break;
-            }
-        }
+        bool all_included = std::all_of(slot.members.begin(), slot.members.end(),
+                                        [&included](NodeId n) { return included[n] != 0; });
 
         if (all_included) {
-            subgraph.add_hyperedge(edge);
+            subgraph.add_hyperedge(slot.edge);
         }
     }
 
@@ -365,15 +766,18 @@ std::pair<double, double> Hypergraph::fit_power_law() const {
 
 double Hypergraph::compute_rich_club_coefficient(int degree_threshold) const {
     // Get nodes with degree >= threshold
-    std::set<std::string> rich_nodes;
-
-    for (const auto& [node_id, node] : nodes_) {
-        if (get_node_degree(node_id) >= degree_threshold) {
-            rich_nodes.insert(node_id);
+    std::vector<char> is_rich(node_slots_.size(), 0);
+    size_t num_rich = 0;
+
+    for (NodeId id = 0; id < node_slots_.size(); ++id) {
+        const auto& slot = node_slots_[id];
+        if (slot.alive && static_cast<int>(slot.edges.size()) >= degree_threshold) {
+            is_rich[id] = 1;
+            ++num_rich;
         }
     }
 
-    if (rich_nodes.size() < 2) {
+    if (num_rich < 2) {
         return 0.0;
     }
 
@@ -381,13 +785,13 @@ double Hypergraph::compute_rich_club_coefficient(int degree_threshold) const {
     size_t edges_among_rich = 0;
     size_t total_edges_with_rich = 0;
 
-    for (const auto& [id, edge] : hyperedges_) {
-        auto edge_nodes = edge.get_all_nodes();
+    for (const auto& slot : edge_slots_) {
+        if (!slot.alive) continue;
 
         // Count how many rich nodes are in this edge
         size_t rich_count = 0;
-        for (const auto& n : edge_nodes) {
-            if (rich_nodes.find(n) != rich_nodes.end()) {
+        for (NodeId n : slot.members) {
+            if (is_rich[n]) {
                 rich_count++;
             }
         }
@@ -409,31 +813,32 @@ double Hypergraph::compute_rich_club_coefficient(int degree_threshold) const {
 
 std::map<std::string, int> Hypergraph::compute_hub_integration_scores(int top_k_hubs) const {
     auto hubs = get_top_hubs(top_k_hubs);
-    std::set<std::string> hub_ids;
+    std::vector<NodeId> hub_ids;
+    std::vector<char> is_hub(node_slots_.size(), 0);
 
     for (const auto& [id, degree] : hubs) {
-        hub_ids.insert(id);
+        auto it = node_lookup_.find(id);
+        if (it != node_lookup_.end()) {
+            hub_ids.push_back(it->second);
+            is_hub[it->second] = 1;
+        }
     }
 
     std::map<std::string, int> integration_scores;
 
-    for (const auto& hub_id : hub_ids) {
+    for (NodeId hub_id : hub_ids) {
         int score = 0;
 
         // Count co-occurrences with other hubs
-        auto incident = get_incident_edges(hub_id);
-
-        for (const auto& edge : incident) {
-            auto nodes = edge.get_all_nodes();
-
-            for (const auto& node : nodes) {
-                if (node != hub_id && hub_ids.find(node) != hub_ids.end()) {
+        for (EdgeId edge_id : node_slots_[hub_id].edges) {
+            for (NodeId node : edge_slots_[edge_id].members) {
+                if (node != hub_id && is_hub[node]) {
                     score++;
                 }
             }
         }
 
-        integration_scores[hub_id] = score;
+        integration_scores[node_slots_[hub_id].node.id] = score;
     }
 
     return integration_scores;
@@ -443,49 +848,75 @@ std::map<std::string, int> Hypergraph::compute_hub_integration_scores(int top_k_
 // Merge Operations
 // ==========================================
 
-void Hypergraph::merge(const Hypergraph& other, bool deduplicate) {
+MergeResult Hypergraph::merge(const Hypergraph& other, bool deduplicate) {
+    MergeResult result;
+
+    // IDs in other are already normalized, and normalize_node_id is not
+    // idempotent for every label, so nodes and edges are inserted verbatim
+
     // Merge nodes
-    for (const auto& [id, node] : other.nodes_) {
-        if (!has_node(id)) {
-            add_node(node);
+    for (const auto& node : other.nodes_view()) {
+        auto it = node_lookup_.find(node.id);
+        if (it == node_lookup_.end()) {
+            insert_node(node, true);
+            ++result.nodes_added;
         } else {
-            // Node exists, merge properties
-            auto* existing = get_node(id);
-            if (existing) {
-                // Merge properties (prefer existing)
-                for (const auto& [key, value] : node.properties) {
-                    if (existing->properties.find(key) == existing->properties.end()) {
-                        existing->properties[key] = value;
-                    }
+            // Node exists, merge properties (prefer existing)
+            auto& existing = node_slots_[it->second].node;
+            for (const auto& [key, value] : node.properties) {
+                if (existing.properties.find(key) == existing.properties.end()) {
+                    existing.properties[key] = value;
                 }
             }
         }
     }
 
-    // Merge hyperedges
-    for (const auto& [id, edge] : other.hyperedges_) {
-        // Check if duplicate
-        bool is_duplicate = false;
+    if (deduplicate && !signature_index_valid_) {
+        // First deduplicating merge (or index dropped): clean up the
+        // destination once, after which the index keeps it clean
+        result.duplicate_edges += merge_duplicate_edges();
+        result.self_loops += remove_self_loops();
+        ensure_signature_index();
+    }
 
+    // Stream hyperedges
+    std::vector<NodeId> sources;
+    std::vector<NodeId> targets;
+    for (const auto& edge : other.edges_view()) {
         if (deduplicate) {
-            for (const auto& [existing_id, existing_edge] : hyperedges_) {
-                if (are_duplicate_edges(edge, existing_edge)) {
-                    is_duplicate = true;
-                    break;
-                }
+            if (edge.is_self_loop()) {
+                ++result.self_loops;
+                continue;
+            }
+
+            // Duplicate check: O(1) lookup of the edge's signature in this graph
+            sources.clear();
+            targets.clear();
+            bool all_known = true;
+            for (const auto& src : edge.sources) {
+                sources.push_back(find_node_id(src));
+                all_known = all_known && sources.back() != INVALID_ID;
+            }
+            for (const auto& tgt : edge.targets) {
+                targets.push_back(find_node_id(tgt));
+                all_known = all_known && targets.back() != INVALID_ID;
+            }
+            if (all_known &&
+                find_signature(make_signature(edge.relation, sources, targets)) != INVALID_ID) {
+                ++result.duplicate_edges;
+                continue;
             }
         }
 
-        if (!is_duplicate) {
-            add_hyperedge(edge);
+        HyperEdge copy = edge;
+        if (has_edge(copy.id)) {
+            copy.id.clear();
         }
+        insert_hyperedge(std::move(copy), true);
+        ++result.edges_merged;
     }
 
-    if (deduplicate) {
-        // Clean up duplicates that might have been introduced
-        merge_duplicate_edges();
-        remove_self_loops();
-    }
+    return result;
 }
 
 void Hypergraph::export_to_html(const std::string& filename,
@@ -496,43 +927,29 @@ void Hypergraph::export_to_html(const std::string& filename,
     }
 
     // Collect statistics for display
-    auto stats = compute_statistics();
+    auto stats = compute_statistics(StatisticsTier::Cheap);
 
     // Calculate optimal minimum degree for ~1000 hyperedges max
     const int MAX_INITIAL_EDGES = 1000;
     int optimal_min_degree = 1;
     int max_degree = 1;
 
-    if (static_cast<int>(hyperedges_.size()) > MAX_INITIAL_EDGES) {
-        // Build degree distribution
-        std::map<int, std::set<std::string>> nodes_by_degree;
-        for (const auto& [id, node] : nodes_) {
-            nodes_by_degree[node.degree].insert(id);
-            if (node.degree > max_degree) max_degree = node.degree;
+    if (static_cast<int>(live_edges_) > MAX_INITIAL_EDGES) {
+        for (const auto& slot : node_slots_) {
+            if (slot.alive && slot.node.degree > max_degree) max_degree = slot.node.degree;
         }
 
         // Try increasing min_degree until we get <= MAX_INITIAL_EDGES hyperedges
         for (int test_degree = 1; test_degree <= max_degree; ++test_degree) {
-            // Collect nodes with degree >= test_degree
-            std::set<std::string> visible_nodes;
-            for (int d = test_degree; d <= max_degree; ++d) {
-                if (nodes_by_degree.count(d)) {
-                    visible_nodes.insert(nodes_by_degree[d].begin(), nodes_by_degree[d].end());
-                }
-            }
-
-            // Count hyperedges that connect to at least one visible node
+            // Count hyperedges that connect to at least one node with degree >= test_degree
             int visible_edges = 0;
-            for (const auto& [id, edge] : hyperedges_) {
-                bool has_visible = false;
-                for (const auto& src : edge.sources) {
-                    if (visible_nodes.count(src)) { has_visible = true; break; }
-                }
-                if (!has_visible) {
-                    for (const auto& tgt : edge.targets) {
-                        if (visible_nodes.count(tgt)) { has_visible = true; break; }
-                    }
-                }
+            for (const auto& slot : edge_slots_) {
+                if (!slot.alive) continue;
+                bool has_visible = std::any_of(
+                    slot.members.begin(), slot.members.end(),
+                    [this, test_degree](NodeId n) {
+                        return node_slots_[n].node.degree >= test_degree;
+                    });
                 if (has_visible) visible_edges++;
             }
 
@@ -550,21 +967,25 @@ void Hypergraph::export_to_html(const std::string& filename,
     nlohmann::json links_json = nlohmann::json::array();
 
     // Add entity nodes
-    std::map<std::string, int> node_index;
+    std::vector<int> node_index(node_slots_.size(), -1);
     int idx = 0;
-    for (const auto& [id, node] : nodes_) {
+    for (NodeId id = 0; id < node_slots_.size(); ++id) {
+        const auto& slot = node_slots_[id];
+        if (!slot.alive) continue;
         nlohmann::json n;
-        n["id"] = id;
-        n["label"] = node.label;
+        n["id"] = slot.node.id;
+        n["label"] = slot.node.label;
         n["type"] = "entity";
-        n["degree"] = node.degree;
+        n["degree"] = slot.node.degree;
         nodes_json.push_back(n);
         node_index[id] = idx++;
     }
 
     // Add hyperedge nodes (relation nodes) and links
     int edge_idx = 0;
-    for (const auto& [id, edge] : hyperedges_) {
+    for (const auto& slot : edge_slots_) {
+        if (!slot.alive) continue;
+        const auto& edge = slot.edge;
         std::string edge_node_id = "edge_" + std::to_string(edge_idx);
 
         // Add edge as a node
@@ -579,8 +1000,8 @@ void Hypergraph::export_to_html(const std::string& filename,
         int edge_node_idx = idx++;
 
         // Add links from sources to relation
-        for (const auto& src : edge.sources) {
-            if (node_index.find(src) != node_index.end()) {
+        for (NodeId src : slot.sources) {
+            if (node_index[src] >= 0) {
                 nlohmann::json link;
                 link["source"] = node_index[src];
                 link["target"] = edge_node_idx;
@@ -590,8 +1011,8 @@ void Hypergraph::export_to_html(const std::string& filename,
         }
 
         // Add links from relation to targets
-        for (const auto& tgt : edge.targets) {
-            if (node_index.find(tgt) != node_index.end()) {
+        for (NodeId tgt : slot.targets) {
+            if (node_index[tgt] >= 0) {
                 nlohmann::json link;
                 link["source"] = edge_node_idx;
                 link["target"] = node_index[tgt];
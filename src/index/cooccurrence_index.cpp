@@ -0,0 +1,348 @@
+#include "index/cooccurrence_index.hpp"
+#include "util/parallel.hpp"
+#include <algorithm>
+#include <numeric>
+
+namespace kg {
+
+namespace {
+
+uint64_t pack(uint32_t a, uint32_t b) {
+    return a <= b ? (uint64_t(a) << 32) | b : (uint64_t(b) << 32) | a;
+}
+
+/**
+ * Sort packed keys and collapse runs into (key, count)
+ */
+std::vector<std::pair<uint64_t, int32_t>> count_runs(std::vector<uint64_t>& keys) {
+    std::sort(keys.begin(), keys.end());
+    std::vector<std::pair<uint64_t, int32_t>> runs;
+    for (size_t i = 0; i < keys.size();) {
+        size_t j = i;
+        while (j < keys.size() && keys[j] == keys[i]) ++j;
+        runs.emplace_back(keys[i], static_cast<int32_t>(j - i));
+        i = j;
+    }
+    return runs;
+}
+
+/**
+ * Merge sorted runs, summing counts of equal keys
+ */
+std::vector<std::pair<uint64_t, int32_t>> merge_runs(const std::vector<std::pair<uint64_t, int32_t>>& a,
+                                                     const std::vector<std::pair<uint64_t, int32_t>>& b) {
+    std::vector<std::pair<uint64_t, int32_t>> merged;
+    merged.reserve(a.size() + b.size());
+    size_t i = 0, j = 0;
+    while (i < a.size() || j < b.size()) {
+        if (j == b.size() || (i < a.size() && a[i].first < b[j].first)) {
+            merged.push_back(a[i++]);
+        } else if (i == a.size() || b[j].first < a[i].first) {
+            merged.push_back(b[j++]);
+        } else {
+            merged.emplace_back(a[i].first, a[i].second + b[j].second);
+            ++i;
+            ++j;
+        }
+    }
+    return merged;
+}
+
+} // anonymous namespace
+
+struct CooccurrenceIndex::Data {
+    std::vector<uint64_t> name_offsets{0};
+    std::vector<char> name_data;
+    std::vector<uint64_t> offsets{0};
+    std::vector<uint32_t> partners;
+    std::vector<int32_t> counts;
+};
+
+// ==========================================
+// Construction
+// ==========================================
+
+CooccurrenceIndex CooccurrenceIndex::build(const Hypergraph& graph, size_t num_threads) {
+    // Entities: live nodes in ID order
+    std::vector<NodeId> handles;
+    handles.reserve(graph.num_nodes());
+    for (NodeId id = 0; id < graph.node_id_bound(); ++id) {
+        if (graph.is_live_node(id)) handles.push_back(id);
+    }
+    std::sort(handles.begin(), handles.end(),
+        [&](NodeId a, NodeId b) { return graph.node_at(a).id < graph.node_at(b).id; });
+
+    std::vector<Entity> entity_of(graph.node_id_bound(), NO_ENTITY);
+    std::vector<std::string> names;
+    names.reserve(handles.size());
+    for (NodeId id : handles) {
+        entity_of[id] = static_cast<Entity>(names.size());
+        names.push_back(graph.node_at(id).id);
+    }
+
+    // Each shard counts the pairs of its edges, then shards are merged.
+    // A node listed twice in an edge pairs with itself and counts twice
+    // with its neighbours, as sources and targets are combined as-is.
+    if (num_threads == 0) num_threads = default_thread_count();
+    std::vector<std::vector<std::pair<uint64_t, int32_t>>> shard_runs(
+        std::min(num_threads, std::max<size_t>(1, graph.edge_id_bound())));
+    parallel_for_shards(graph.edge_id_bound(), num_threads, [&](size_t shard, size_t begin, size_t end) {
+        std::vector<uint64_t> keys;
+        std::vector<Entity> entities;
+        for (size_t e = begin; e < end; ++e) {
+            EdgeId edge = static_cast<EdgeId>(e);
+            if (!graph.is_live_edge(edge)) continue;
+            entities.clear();
+            for (NodeId n : graph.edge_source_ids(edge)) entities.push_back(entity_of[n]);
+            for (NodeId n : graph.edge_target_ids(edge)) entities.push_back(entity_of[n]);
+            for (size_t i = 0; i < entities.size(); ++i) {
+                for (size_t j = i + 1; j < entities.size(); ++j) {
+                    keys.push_back(pack(entities[i], entities[j]));
+                }
+            }
+        }
+        shard_runs[shard] = count_runs(keys);
+    });
+
+    // Pairwise tree merge keeps every step linear in its inputs
+    while (shard_runs.size() > 1) {
+        std::vector<std::vector<std::pair<uint64_t, int32_t>>> next((shard_runs.size() + 1) / 2);
+        parallel_for_shards(next.size(), num_threads, [&](size_t, size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                next[i] = 2 * i + 1 < shard_runs.size()
+                    ? merge_runs(shard_runs[2 * i], shard_runs[2 * i + 1])
+                    : std::move(shard_runs[2 * i]);
+            }
+        });
+        shard_runs = std::move(next);
+    }
+
+    return from_sorted(std::move(names), shard_runs.empty() ? std::vector<std::pair<uint64_t, int32_t>>()
+                                                            : shard_runs.front());
+}
+
+CooccurrenceIndex CooccurrenceIndex::from_pairs(
+    const std::vector<std::tuple<std::string, std::string, int>>& pairs) {
+    std::vector<std::string> names;
+    names.reserve(pairs.size() * 2);
+    for (const auto& [a, b, count] : pairs) {
+        names.push_back(a);
+        names.push_back(b);
+    }
+    std::sort(names.begin(), names.end());
+    names.erase(std::unique(names.begin(), names.end()), names.end());
+
+    auto entity = [&](const std::string& id) {
+        return static_cast<Entity>(std::lower_bound(names.begin(), names.end(), id) - names.begin());
+    };
+    std::vector<std::pair<uint64_t, int32_t>> keyed;
+    keyed.reserve(pairs.size());
+    for (const auto& [a, b, count] : pairs) {
+        keyed.emplace_back(pack(entity(a), entity(b)), count);
+    }
+    std::sort(keyed.begin(), keyed.end());
+
+    std::vector<std::pair<uint64_t, int32_t>> merged;
+    for (const auto& [key, count] : keyed) {
+        if (!merged.empty() && merged.back().first == key) {
+            merged.back().second += count;
+        } else {
+            merged.emplace_back(key, count);
+        }
+    }
+    return from_sorted(std::move(names), merged);
+}
+
+CooccurrenceIndex CooccurrenceIndex::from_sorted(std::vector<std::string> names,
+                                                 const std::vector<std::pair<uint64_t, int32_t>>& pairs) {
+    auto data = std::make_shared<Data>();
+    for (const auto& name : names) {
+        data->name_data.insert(data->name_data.end(), name.begin(), name.end());
+        data->name_offsets.push_back(data->name_data.size());
+    }
+
+    // Row sizes, then fill. Pairs arrive sorted by (a, b), so every row
+    // receives its partners in ascending order: smaller partners while
+    // scanning earlier rows, itself and larger ones while scanning its own.
+    size_t num_entities = names.size();
+    std::vector<uint64_t> fill(num_entities + 1, 0);
+    for (const auto& [key, count] : pairs) {
+        Entity a = static_cast<Entity>(key >> 32), b = static_cast<Entity>(key & 0xFFFFFFFFu);
+        ++fill[a + 1];
+        if (a != b) ++fill[b + 1];
+    }
+    std::partial_sum(fill.begin(), fill.end(), fill.begin());
+    data->offsets = fill;
+    data->partners.resize(fill[num_entities]);
+    data->counts.resize(fill[num_entities]);
+    for (const auto& [key, count] : pairs) {
+        Entity a = static_cast<Entity>(key >> 32), b = static_cast<Entity>(key & 0xFFFFFFFFu);
+        data->partners[fill[a]] = b;
+        data->counts[fill[a]++] = count;
+        if (a != b) {
+            data->partners[fill[b]] = a;
+            data->counts[fill[b]++] = count;
+        }
+    }
+
+    CooccurrenceIndex index;
+    index.strings_ = {{data->name_offsets.data(), data->name_offsets.size()},
+                      {data->name_data.data(), data->name_data.size()}};
+    index.offsets_ = {data->offsets.data(), data->offsets.size()};
+    index.partners_ = {data->partners.data(), data->partners.size()};
+    index.counts_ = {data->counts.data(), data->counts.size()};
+    index.num_pairs_ = pairs.size();
+    index.data_ = std::move(data);
+    return index;
+}
+
+CooccurrenceIndex CooccurrenceIndex::from_sections(const SectionFile& file, StringTableView strings,
+                                                   ArrayView<uint32_t> entity_strings,
+                                                   ArrayView<uint64_t> offsets, ArrayView<uint32_t> partners,
+                                                   ArrayView<int32_t> counts) {
+    size_t num_entities = entity_strings.size;
+    if (offsets.size != num_entities + 1 || offsets[0] != 0 || offsets[num_entities] != partners.size ||
+        counts.size != partners.size) {
+        file.corrupt("co-occurrence arrays do not match");
+    }
+    for (size_t e = 0; e < num_entities; ++e) {
+        if (entity_strings[e] >= strings.size() || (e > 0 && entity_strings[e - 1] >= entity_strings[e])) {
+            file.corrupt("co-occurrence entities are not sorted string indices");
+        }
+        if (offsets[e] > offsets[e + 1]) {
+            file.corrupt("co-occurrence offsets are not monotonic");
+        }
+    }
+
+    size_t self_pairs = 0;
+    for (size_t e = 0; e < num_entities; ++e) {
+        for (uint64_t i = offsets[e]; i < offsets[e + 1]; ++i) {
+            if (partners[i] >= num_entities || (i > offsets[e] && partners[i - 1] >= partners[i])) {
+                file.corrupt("co-occurrence partners are out of range or unsorted");
+            }
+            if (partners[i] == e) ++self_pairs;
+        }
+    }
+
+    CooccurrenceIndex index;
+    index.strings_ = strings;
+    index.entity_strings_ = entity_strings;
+    index.offsets_ = offsets;
+    index.partners_ = partners;
+    index.counts_ = counts;
+    index.num_pairs_ = (partners.size + self_pairs) / 2;
+    return index;
+}
+
+// ==========================================
+// Updates
+// ==========================================
+
+void CooccurrenceIndex::Update::add_edge(const std::vector<std::string_view>& members, int delta) {
+    // Same pairing as build(): repeated members count as-is
+    for (size_t i = 0; i < members.size(); ++i) {
+        for (size_t j = i + 1; j < members.size(); ++j) {
+            auto key = members[i] <= members[j]
+                ? std::make_pair(std::string(members[i]), std::string(members[j]))
+                : std::make_pair(std::string(members[j]), std::string(members[i]));
+            deltas[key] += delta;
+        }
+    }
+}
+
+CooccurrenceIndex CooccurrenceIndex::updated(const Update& update) const {
+    // New entity list: existing names minus removed, merged with added ones.
+    // Both inputs are sorted, so renumbering existing entities is monotonic
+    // and their pairs stay in (a, b) order.
+    std::vector<std::string> names;
+    names.reserve(num_entities() + update.added.size());
+    std::vector<Entity> renumber(num_entities(), NO_ENTITY);
+    auto added = update.added.begin();
+    for (Entity e = 0; e < num_entities(); ++e) {
+        std::string_view current = name(e);
+        for (; added != update.added.end() && *added <= current; ++added) {
+            if (*added != current) names.push_back(*added);
+        }
+        if (update.removed.count(std::string(current))) continue;
+        renumber[e] = static_cast<Entity>(names.size());
+        names.emplace_back(current);
+    }
+    names.insert(names.end(), added, update.added.end());
+
+    auto entity = [&](const std::string& id) {
+        auto it = std::lower_bound(names.begin(), names.end(), id);
+        return it != names.end() && *it == id ? static_cast<Entity>(it - names.begin()) : NO_ENTITY;
+    };
+
+    // Deltas are keyed by ID; ID order is entity order, so sorting the
+    // packed keys keeps them aligned with the existing pairs
+    std::vector<std::pair<uint64_t, int32_t>> deltas;
+    deltas.reserve(update.deltas.size());
+    for (const auto& [ids, delta] : update.deltas) {
+        Entity a = entity(ids.first), b = entity(ids.second);
+        if (a == NO_ENTITY || b == NO_ENTITY || delta == 0) continue;
+        deltas.emplace_back(pack(a, b), delta);
+    }
+    std::sort(deltas.begin(), deltas.end());
+
+    std::vector<std::pair<uint64_t, int32_t>> existing;
+    existing.reserve(num_pairs());
+    for_each_pair([&](Entity a, Entity b, int count) {
+        if (renumber[a] != NO_ENTITY && renumber[b] != NO_ENTITY) {
+            existing.emplace_back(pack(renumber[a], renumber[b]), count);
+        }
+    });
+
+    auto merged = merge_runs(existing, deltas);
+    merged.erase(std::remove_if(merged.begin(), merged.end(), [](const auto& run) { return run.second <= 0; }),
+                 merged.end());
+    return from_sorted(std::move(names), merged);
+}
+
+// ==========================================
+// Queries
+// ==========================================
+
+CooccurrenceIndex::Entity CooccurrenceIndex::find(std::string_view id) const {
+    size_t lo = 0, hi = num_entities();
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (name(static_cast<Entity>(mid)) < id) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if (lo < num_entities() && name(static_cast<Entity>(lo)) == id) {
+        return static_cast<Entity>(lo);
+    }
+    return NO_ENTITY;
+}
+
+int CooccurrenceIndex::count(Entity a, Entity b) const {
+    if (a >= num_entities() || b >= num_entities()) return 0;
+    // Search the shorter row
+    if (offsets_[a + 1] - offsets_[a] > offsets_[b + 1] - offsets_[b]) std::swap(a, b);
+    const Entity* first = partners_.data + offsets_[a];
+    const Entity* last = partners_.data + offsets_[a + 1];
+    const Entity* it = std::lower_bound(first, last, b);
+    if (it == last || *it != b) return 0;
+    return counts_[static_cast<size_t>(it - partners_.data)];
+}
+
+std::vector<std::pair<CooccurrenceIndex::Entity, int>> CooccurrenceIndex::top_partners(Entity e, size_t k) const {
+    std::vector<std::pair<Entity, int>> result;
+    if (e >= num_entities()) return result;
+    for (uint64_t i = offsets_[e]; i < offsets_[e + 1]; ++i) {
+        result.emplace_back(partners_[i], counts_[i]);
+    }
+    auto by_count = [](const auto& x, const auto& y) {
+        return x.second != y.second ? x.second > y.second : x.first < y.first;
+    };
+    k = std::min(k, result.size());
+    std::partial_sort(result.begin(), result.begin() + k, result.end(), by_count);
+    result.resize(k);
+    return result;
+}
+
+} // namespace kg
@@ -0,0 +1,831 @@
+#include "index/hypergraph_index.hpp"
+#include "util/section_file.hpp"
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <mutex>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_set>
+
+namespace kg {
+
+namespace {
+
+constexpr SectionFile::Magic INDEX_MAGIC = {'K', 'G', 'I', 'N', 'D', 'E', 'X', '\n'};
+
+enum SectionId : uint32_t {
+    Meta = 1,                                          // node_count, edge_count, created, source
+    StringOffsets,
+    StringData,
+    RelationKeys,
+    RelationOffsets,
+    RelationValues,
+    LabelKeys,
+    LabelOffsets,
+    LabelValues,
+    SValues,
+    SComponentRanges,                                  // Per s: range into the component list
+    ComponentOffsets,                                  // Per component: range into members
+    ComponentMembers,
+    DegreeNodes,
+    DegreeValues,
+    CooccurrenceEntities,                              // Entity -> string index, ascending
+    CooccurrenceOffsets,
+    CooccurrencePartners,
+    CooccurrenceCounts,
+};
+
+std::string to_lower(std::string text) {
+    std::transform(text.begin(), text.end(), text.begin(), ::tolower);
+    return text;
+}
+
+// Degree descending, ties by node ID, so rankings are reproducible
+struct RankOrder {
+    bool operator()(const std::pair<std::string, int>& a, const std::pair<std::string, int>& b) const {
+        return a.second != b.second ? a.second > b.second : a.first < b.first;
+    }
+};
+
+} // anonymous namespace
+
+// ==========================================
+// Storage
+// ==========================================
+
+/**
+ * Heavy tables behind a HypergraphIndex. Built and JSON indices fill the
+ * containers directly; a binary index keeps the mapped file and fills each
+ * container on first access under its once_flag.
+ */
+struct HypergraphIndex::Storage {
+    template <typename T>
+    struct Lazy {
+        std::once_flag once;
+        T value;
+    };
+
+    Lazy<Postings> relations;
+    Lazy<Postings> labels;
+    Lazy<SComponents> components;
+    Lazy<std::vector<std::pair<std::string, int>>> degrees;
+    CooccurrenceIndex cooccurrence;                    // Views into file when mapped
+
+    // Binary index only
+    std::unique_ptr<SectionFile> file;
+    StringTableView strings;
+    ArrayView<uint32_t> degree_nodes;
+    ArrayView<int32_t> degree_values;
+
+    // Attached index only (see attach())
+    std::unique_ptr<Tracker> tracker;
+
+    Storage() = default;
+    ~Storage();
+
+    template <typename T, typename Loader>
+    const T& get(Lazy<T>& table, Loader&& load) {
+        std::call_once(table.once, [&] {
+            if (file) load(table.value);
+        });
+        return table.value;
+    }
+
+    std::string_view string(uint64_t index) const {
+        if (index >= strings.size()) file->corrupt("string index out of range");
+        return strings[static_cast<uint32_t>(index)];
+    }
+
+    void read_postings(uint32_t keys_id, uint32_t offsets_id, uint32_t values_id, Postings& out) const {
+        auto keys = file->section<uint32_t>(keys_id);
+        auto offsets = file->section<uint64_t>(offsets_id, keys.size + 1);
+        auto values = file->section<uint32_t>(values_id, offsets[keys.size]);
+        out.reserve(keys.size);
+        for (size_t k = 0; k < keys.size; ++k) {
+            if (offsets[k] > offsets[k + 1]) file->corrupt("posting offsets are not monotonic");
+            auto& list = out[std::string(string(keys[k]))];
+            list.reserve(offsets[k + 1] - offsets[k]);
+            for (uint64_t i = offsets[k]; i < offsets[k + 1]; ++i) {
+                list.emplace_back(string(values[i]));
+            }
+        }
+    }
+
+    void read_components(SComponents& out) const {
+        auto s_values = file->section<int32_t>(SValues);
+        auto ranges = file->section<uint64_t>(SComponentRanges, s_values.size + 1);
+        auto offsets = file->section<uint64_t>(ComponentOffsets, ranges[s_values.size] + 1);
+        auto members = file->section<uint32_t>(ComponentMembers, offsets[ranges[s_values.size]]);
+        for (size_t s = 0; s < s_values.size; ++s) {
+            if (ranges[s] > ranges[s + 1]) file->corrupt("component ranges are not monotonic");
+            auto& comps = out[s_values[s]];
+            comps.reserve(ranges[s + 1] - ranges[s]);
+            for (uint64_t c = ranges[s]; c < ranges[s + 1]; ++c) {
+                if (offsets[c] > offsets[c + 1]) file->corrupt("component offsets are not monotonic");
+                std::set<std::string> comp;
+                // Members are written in string order, so every insert lands at the end
+                for (uint64_t i = offsets[c]; i < offsets[c + 1]; ++i) {
+                    comp.emplace_hint(comp.end(), string(members[i]));
+                }
+                comps.push_back(std::move(comp));
+            }
+        }
+    }
+};
+
+// ==========================================
+// Tracker
+// ==========================================
+
+/**
+ * Applies one graph's mutations to the tables of a Storage. Postings and the
+ * degree ranking are edited in place; the ranking is kept as an ordered set
+ * and copied out when degree_ranked_nodes() is next read. Co-occurrence
+ * changes accumulate in pending until cooccurrence() merges them, and any
+ * edge change marks the s-components stale.
+ */
+struct HypergraphIndex::Tracker : HypergraphObserver {
+    Storage& storage;
+    Hypergraph* graph;                                 // Null once the graph is gone
+    size_t nodes;
+    size_t edges;
+    std::vector<int> s_values;
+    std::unordered_map<std::string, size_t> relation_position;  // Edge ID -> index in its posting
+    std::unordered_map<std::string, int> degree_of;
+    std::set<std::pair<std::string, int>, RankOrder> ranked;
+    CooccurrenceIndex::Update pending;
+
+    std::mutex mutex;                                  // Serializes the refreshes below
+    std::atomic<bool> degrees_dirty{false};
+    std::atomic<bool> cooccurrence_dirty{false};
+    std::atomic<bool> components_stale{false};
+
+    Tracker(Storage& s, Hypergraph& g)
+        : storage(s), graph(&g), nodes(g.num_nodes()), edges(g.num_edges()) {
+        for (const auto& [s_value, comps] : storage.components.value) s_values.push_back(s_value);
+        for (const auto& [relation, ids] : storage.relations.value) {
+            for (size_t i = 0; i < ids.size(); ++i) relation_position[ids[i]] = i;
+        }
+        for (const auto& entry : storage.degrees.value) {
+            degree_of.insert(entry);
+            ranked.insert(entry);
+        }
+    }
+
+    // ---- Graph events ----
+
+    void on_node_added(const Hypergraph& g, NodeId n) override {
+        const auto& node = g.node_at(n);
+        storage.labels.value[to_lower(node.label)].push_back(node.id);
+        set_degree(node.id, 0);
+        if (!pending.removed.erase(node.id)) pending.added.insert(node.id);
+        cooccurrence_dirty = true;
+        ++nodes;
+    }
+
+    void on_node_removing(const Hypergraph& g, NodeId n) override {
+        const auto& node = g.node_at(n);
+        auto label = storage.labels.value.find(to_lower(node.label));
+        if (label != storage.labels.value.end()) {
+            auto& ids = label->second;
+            ids.erase(std::remove(ids.begin(), ids.end(), node.id), ids.end());
+            if (ids.empty()) storage.labels.value.erase(label);
+        }
+        auto degree = degree_of.find(node.id);
+        if (degree != degree_of.end()) {
+            ranked.erase(*degree);
+            degree_of.erase(degree);
+            degrees_dirty = true;
+        }
+        if (!pending.added.erase(node.id)) pending.removed.insert(node.id);
+        cooccurrence_dirty = true;
+        --nodes;
+    }
+
+    void on_edge_added(const Hypergraph& g, EdgeId e) override {
+        const auto& edge = g.edge_at(e);
+        auto& ids = storage.relations.value[to_lower(edge.relation)];
+        relation_position[edge.id] = ids.size();
+        ids.push_back(edge.id);
+        touch_edge(g, e, +1);
+        ++edges;
+    }
+
+    void on_edge_removing(const Hypergraph& g, EdgeId e) override {
+        // Swap-remove from the posting so removal does not scan it
+        const auto& edge = g.edge_at(e);
+        auto relation = storage.relations.value.find(to_lower(edge.relation));
+        auto position = relation_position.find(edge.id);
+        if (relation != storage.relations.value.end() && position != relation_position.end()) {
+            auto& ids = relation->second;
+            size_t index = position->second;
+            relation_position.erase(position);
+            if (index + 1 != ids.size()) {
+                ids[index] = std::move(ids.back());
+                relation_position[ids[index]] = index;
+            }
+            ids.pop_back();
+            if (ids.empty()) storage.relations.value.erase(relation);
+        }
+        touch_edge(g, e, -1);
+        --edges;
+    }
+
+    void on_edge_updating(const Hypergraph& g, EdgeId e) override { on_edge_removing(g, e); }
+    void on_edge_updated(const Hypergraph& g, EdgeId e) override { on_edge_added(g, e); }
+
+    void on_cleared(const Hypergraph&) override {
+        storage.relations.value.clear();
+        storage.labels.value.clear();
+        relation_position.clear();
+        degree_of.clear();
+        ranked.clear();
+        pending = {};
+        storage.cooccurrence = CooccurrenceIndex();
+        nodes = edges = 0;
+        degrees_dirty = true;
+        components_stale = true;
+    }
+
+    void on_detached() override { graph = nullptr; }
+
+    // ---- Helpers ----
+
+    void set_degree(const std::string& id, int degree) {
+        auto [it, inserted] = degree_of.emplace(id, degree);
+        if (!inserted) {
+            ranked.erase(*it);
+            it->second = degree;
+        }
+        ranked.insert(*it);
+        degrees_dirty = true;
+    }
+
+    // Members' degrees and co-occurring pairs of one edge, added or removed
+    void touch_edge(const Hypergraph& g, EdgeId e, int delta) {
+        for (NodeId n : g.edge_node_ids(e)) {
+            const auto& id = g.node_at(n).id;
+            auto degree = degree_of.find(id);
+            set_degree(id, (degree != degree_of.end() ? degree->second : 0) + delta);
+        }
+        std::vector<std::string_view> members;
+        for (NodeId n : g.edge_source_ids(e)) members.push_back(g.node_at(n).id);
+        for (NodeId n : g.edge_target_ids(e)) members.push_back(g.node_at(n).id);
+        pending.add_edge(members, delta);
+        cooccurrence_dirty = true;
+        components_stale = true;
+    }
+
+    // ---- Refreshes, run on read ----
+
+    void refresh_degrees() {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!degrees_dirty) return;
+        storage.degrees.value.assign(ranked.begin(), ranked.end());
+        degrees_dirty = false;
+    }
+
+    void refresh_cooccurrence() {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!cooccurrence_dirty) return;
+        if (!pending.empty()) storage.cooccurrence = storage.cooccurrence.updated(pending);
+        pending = {};
+        cooccurrence_dirty = false;
+    }
+
+    void refresh_components() {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!components_stale) return;
+        if (!graph) {
+            throw std::runtime_error("S-components are out of date and the graph the index followed is gone");
+        }
+        storage.components.value = graph->find_s_connected_components_multi(s_values);
+        components_stale = false;
+    }
+};
+
+HypergraphIndex::Storage::~Storage() {
+    if (tracker && tracker->graph) tracker->graph->remove_observer(tracker.get());
+}
+
+HypergraphIndex::HypergraphIndex() : storage_(std::make_shared<Storage>()) {}
+
+// ==========================================
+// Build
+// ==========================================
+
+void HypergraphIndex::build(const Hypergraph& graph, const std::vector<int>& s_values, size_t num_threads) {
+    // Timestamp
+    auto now = std::chrono::system_clock::now();
+    auto time = std::chrono::system_clock::to_time_t(now);
+    std::stringstream ss;
+    ss << std::put_time(std::gmtime(&time), "%Y-%m-%dT%H:%M:%SZ");
+    created_utc = ss.str();
+
+    node_count = graph.num_nodes();
+    edge_count = graph.num_edges();
+
+    // Fresh storage: copies made before the rebuild keep their tables
+    storage_ = std::make_shared<Storage>();
+    auto& relation_to_edges = storage_->relations.value;
+    auto& label_to_nodes = storage_->labels.value;
+    auto& degree_ranked_nodes = storage_->degrees.value;
+
+    // Build relation index
+    for (const auto& edge : graph.edges_view()) {
+        // Normalize relation to lowercase
+        relation_to_edges[to_lower(edge.relation)].push_back(edge.id);
+    }
+
+    // Build label index and degree ranking
+    degree_ranked_nodes.reserve(graph.num_nodes());
+    for (const auto& node : graph.nodes_view()) {
+        label_to_nodes[to_lower(node.label)].push_back(node.id);
+        degree_ranked_nodes.emplace_back(node.id, node.degree);
+    }
+
+    // Sort by degree descending
+    std::sort(degree_ranked_nodes.begin(), degree_ranked_nodes.end(), RankOrder());
+
+    // Compute s-components for every requested s in one pass
+    storage_->components.value = graph.find_s_connected_components_multi(s_values);
+
+    // Build co-occurrence index (for entities only)
+    storage_->cooccurrence = CooccurrenceIndex::build(graph, num_threads);
+}
+
+// ==========================================
+// Accessors
+// ==========================================
+
+const HypergraphIndex::Postings& HypergraphIndex::relation_to_edges() const {
+    auto& s = *storage_;
+    return s.get(s.relations, [&](Postings& out) {
+        s.read_postings(RelationKeys, RelationOffsets, RelationValues, out);
+    });
+}
+
+const HypergraphIndex::Postings& HypergraphIndex::label_to_nodes() const {
+    auto& s = *storage_;
+    return s.get(s.labels, [&](Postings& out) {
+        s.read_postings(LabelKeys, LabelOffsets, LabelValues, out);
+    });
+}
+
+const HypergraphIndex::SComponents& HypergraphIndex::s_components() const {
+    auto& s = *storage_;
+    if (s.tracker && s.tracker->components_stale) s.tracker->refresh_components();
+    return s.get(s.components, [&](SComponents& out) { s.read_components(out); });
+}
+
+const std::vector<std::pair<std::string, int>>& HypergraphIndex::degree_ranked_nodes() const {
+    auto& s = *storage_;
+    if (s.tracker && s.tracker->degrees_dirty) s.tracker->refresh_degrees();
+    return s.get(s.degrees, [&](std::vector<std::pair<std::string, int>>& out) {
+        out.reserve(s.degree_nodes.size);
+        for (size_t i = 0; i < s.degree_nodes.size; ++i) {
+            out.emplace_back(s.string(s.degree_nodes[i]), s.degree_values[i]);
+        }
+    });
+}
+
+const CooccurrenceIndex& HypergraphIndex::cooccurrence() const {
+    auto& s = *storage_;
+    if (s.tracker && s.tracker->cooccurrence_dirty) s.tracker->refresh_cooccurrence();
+    return s.cooccurrence;
+}
+
+CooccurrenceIndex::Entity HypergraphIndex::cooccurrence_entity(const std::string& id) const {
+    thread_local std::string normalized_id;
+    Hypergraph::normalize_node_id(id, normalized_id);
+    return cooccurrence().find(normalized_id);
+}
+
+int HypergraphIndex::get_cooccurrence(const std::string& a, const std::string& b) const {
+    // Normalize IDs to match how the graph stores them
+    return cooccurrence().count(cooccurrence_entity(a), cooccurrence_entity(b));
+}
+
+std::vector<std::pair<std::string, int>> HypergraphIndex::get_top_cooccurring(const std::string& id,
+                                                                               size_t k) const {
+    const auto& cooc = cooccurrence();
+    std::vector<std::pair<std::string, int>> result;
+    for (const auto& [partner, count] : cooc.top_partners(cooccurrence_entity(id), k)) {
+        result.emplace_back(cooc.name(partner), count);
+    }
+    return result;
+}
+
+std::vector<std::string> HypergraphIndex::get_top_hubs(size_t k) const {
+    std::vector<std::string> result;
+    const auto& s = *storage_;
+    if (s.tracker) {
+        for (auto it = s.tracker->ranked.begin(); it != s.tracker->ranked.end() && result.size() < k; ++it) {
+            result.push_back(it->first);
+        }
+        return result;
+    }
+    if (s.file) {
+        for (size_t i = 0; i < std::min(k, s.degree_nodes.size); ++i) {
+            result.emplace_back(s.string(s.degree_nodes[i]));
+        }
+        return result;
+    }
+    const auto& ranked = s.degrees.value;
+    for (size_t i = 0; i < std::min(k, ranked.size()); ++i) {
+        result.push_back(ranked[i].first);
+    }
+    return result;
+}
+
+std::vector<std::string> HypergraphIndex::find_nodes_by_prefix(const std::string& prefix) const {
+    std::vector<std::string> result;
+    std::string lower_prefix = to_lower(prefix);
+    for (const auto& [label, ids] : label_to_nodes()) {
+        if (label.rfind(lower_prefix, 0) == 0) {
+            result.insert(result.end(), ids.begin(), ids.end());
+        }
+    }
+    return result;
+}
+
+// ==========================================
+// JSON
+// ==========================================
+
+void HypergraphIndex::save_to_json(const std::string& path, const JsonWriteOptions& options) const {
+    JsonOutputFile file(path, options);
+    JsonWriter writer(file.stream(), options.compact);
+    writer.begin_object();
+
+    writer.key("meta").begin_object();
+    writer.member("created_utc", created_utc);
+    writer.member("source_graph_path", source_graph_path);
+    auto [nodes, edges] = current_counts();
+    writer.member("node_count", nodes);
+    writer.member("edge_count", edges);
+    writer.end_object();
+
+    // Relation index
+    writer.member("relation_to_edges", relation_to_edges());
+
+    // Label index
+    writer.member("label_to_nodes", label_to_nodes());
+
+    // S-components (sets written as arrays)
+    writer.key("s_components").begin_object();
+    for (const auto& [s, comps] : s_components()) {
+        writer.key(std::to_string(s)).begin_array();
+        for (const auto& comp : comps) {
+            writer.array(comp);
+        }
+        writer.end_array();
+    }
+    writer.end_object();
+
+    // Degree ranking
+    writer.key("degree_ranked_nodes").begin_array();
+    for (const auto& [id, degree] : degree_ranked_nodes()) {
+        writer.begin_array();
+        writer.value(id);
+        writer.value(degree);
+        writer.end_array();
+    }
+    writer.end_array();
+
+    // Co-occurrence, keyed "min_id|max_id"
+    const auto& cooc = cooccurrence();
+    writer.key("entity_cooccurrence").begin_object();
+    std::string pair_key;
+    cooc.for_each_pair([&](CooccurrenceIndex::Entity a, CooccurrenceIndex::Entity b, int count) {
+        pair_key.assign(cooc.name(a));
+        pair_key += '|';
+        pair_key += cooc.name(b);
+        writer.member(pair_key, count);
+    });
+    writer.end_object();
+
+    writer.end_object();
+    file.close();
+}
+
+HypergraphIndex HypergraphIndex::load_from_json(const std::string& path) {
+    if (!std::ifstream(path).is_open()) {
+        throw std::runtime_error("Cannot open index file: " + path);
+    }
+
+    auto input = open_json_input(path);
+    nlohmann::json j = nlohmann::json::parse(*input);
+
+    HypergraphIndex idx;
+    auto& storage = *idx.storage_;
+
+    // Meta
+    if (j.contains("meta")) {
+        idx.created_utc = j["meta"].value("created_utc", "");
+        idx.source_graph_path = j["meta"].value("source_graph_path", "");
+        idx.node_count = j["meta"].value("node_count", 0);
+        idx.edge_count = j["meta"].value("edge_count", 0);
+    }
+
+    // Relation index
+    if (j.contains("relation_to_edges")) {
+        storage.relations.value = j["relation_to_edges"].get<Postings>();
+    }
+
+    // Label index
+    if (j.contains("label_to_nodes")) {
+        storage.labels.value = j["label_to_nodes"].get<Postings>();
+    }
+
+    // S-components (convert vector back to set)
+    if (j.contains("s_components")) {
+        for (auto& [key, val] : j["s_components"].items()) {
+            int s = std::stoi(key);
+            std::vector<std::set<std::string>> comps;
+            for (const auto& comp_arr : val) {
+                auto vec = comp_arr.get<std::vector<std::string>>();
+                comps.push_back(std::set<std::string>(vec.begin(), vec.end()));
+            }
+            storage.components.value[s] = comps;
+        }
+    }
+
+    // Degree ranking
+    if (j.contains("degree_ranked_nodes")) {
+        for (const auto& item : j["degree_ranked_nodes"]) {
+            storage.degrees.value.emplace_back(item[0].get<std::string>(), item[1].get<int>());
+        }
+    }
+
+    // Co-occurrence. IDs may contain '|', so split each key where both
+    // halves are ranked nodes, falling back to the first separator
+    if (j.contains("entity_cooccurrence")) {
+        std::unordered_set<std::string_view> node_ids;
+        for (const auto& [id, degree] : storage.degrees.value) node_ids.insert(id);
+
+        std::vector<std::tuple<std::string, std::string, int>> pairs;
+        for (const auto& [key, count] : j["entity_cooccurrence"].items()) {
+            std::string_view text(key);
+            size_t split = text.find('|');
+            if (split == std::string_view::npos) {
+                throw std::runtime_error("Malformed co-occurrence key in index: " + key);
+            }
+            for (size_t pos = split; pos != std::string_view::npos; pos = text.find('|', pos + 1)) {
+                if (node_ids.count(text.substr(0, pos)) && node_ids.count(text.substr(pos + 1))) {
+                    split = pos;
+                    break;
+                }
+            }
+            pairs.emplace_back(key.substr(0, split), key.substr(split + 1), count.get<int>());
+        }
+        storage.cooccurrence = CooccurrenceIndex::from_pairs(pairs);
+    }
+
+    return idx;
+}
+
+// ==========================================
+// Binary
+// ==========================================
+
+void HypergraphIndex::save_to_binary(const std::string& path) const {
+    const auto& relations = relation_to_edges();
+    const auto& labels = label_to_nodes();
+    const auto& components = s_components();
+    const auto& ranked = degree_ranked_nodes();
+    const auto& cooc = cooccurrence();
+
+    // Every string is interned once; the table is sorted at the end and all
+    // index arrays are remapped, so readers can binary-search it
+    StringTableBuilder strings;
+    auto [nodes, edges] = current_counts();
+    std::vector<uint64_t> meta{nodes, edges, strings.intern(created_utc),
+                               strings.intern(source_graph_path)};
+
+    auto write_postings = [&](const Postings& postings, std::vector<uint32_t>& keys,
+                              std::vector<uint64_t>& offsets, std::vector<uint32_t>& values) {
+        offsets.push_back(0);
+        for (const auto& [key, list] : postings) {
+            keys.push_back(strings.intern(key));
+            for (const auto& value : list) values.push_back(strings.intern(value));
+            offsets.push_back(values.size());
+        }
+    };
+    std::vector<uint32_t> relation_keys, relation_values, label_keys, label_values;
+    std::vector<uint64_t> relation_offsets, label_offsets;
+    write_postings(relations, relation_keys, relation_offsets, relation_values);
+    write_postings(labels, label_keys, label_offsets, label_values);
+
+    std::vector<int32_t> s_values;
+    std::vector<uint64_t> component_ranges{0}, component_offsets{0};
+    std::vector<uint32_t> component_members;
+    for (const auto& [s, comps] : components) {
+        s_values.push_back(s);
+        for (const auto& comp : comps) {
+            for (const auto& edge_id : comp) component_members.push_back(strings.intern(edge_id));
+            component_offsets.push_back(component_members.size());
+        }
+        component_ranges.push_back(component_offsets.size() - 1);
+    }
+
+    std::vector<uint32_t> degree_nodes;
+    std::vector<int32_t> degree_values;
+    degree_nodes.reserve(ranked.size());
+    degree_values.reserve(ranked.size());
+    for (const auto& [id, degree] : ranked) {
+        degree_nodes.push_back(strings.intern(id));
+        degree_values.push_back(degree);
+    }
+
+    std::vector<uint32_t> cooccurrence_entities;
+    cooccurrence_entities.reserve(cooc.num_entities());
+    for (CooccurrenceIndex::Entity e = 0; e < cooc.num_entities(); ++e) {
+        cooccurrence_entities.push_back(strings.intern(std::string(cooc.name(e))));
+    }
+
+    auto remap = strings.sort();
+    auto apply = [&](std::vector<uint32_t>& indices) {
+        for (auto& index : indices) index = remap[index];
+    };
+    meta[2] = remap[meta[2]];
+    meta[3] = remap[meta[3]];
+    apply(relation_values);
+    apply(label_values);
+    apply(component_members);
+    apply(degree_nodes);
+    // Entities are in ID order, which the sorted table preserves
+    apply(cooccurrence_entities);
+
+    // Postings keys must be ascending for readers; reorder rows to match
+    auto sort_postings = [&](std::vector<uint32_t>& keys, std::vector<uint64_t>& offsets,
+                             std::vector<uint32_t>& values) {
+        std::vector<size_t> order(keys.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(),
+            [&](size_t x, size_t y) { return remap[keys[x]] < remap[keys[y]]; });
+        std::vector<uint32_t> sorted_keys, sorted_values;
+        std::vector<uint64_t> sorted_offsets{0};
+        sorted_keys.reserve(keys.size());
+        sorted_values.reserve(values.size());
+        for (size_t row : order) {
+            sorted_keys.push_back(remap[keys[row]]);
+            sorted_values.insert(sorted_values.end(), values.begin() + offsets[row],
+                                 values.begin() + offsets[row + 1]);
+            sorted_offsets.push_back(sorted_values.size());
+        }
+        keys = std::move(sorted_keys);
+        offsets = std::move(sorted_offsets);
+        values = std::move(sorted_values);
+    };
+    sort_postings(relation_keys, relation_offsets, relation_values);
+    sort_postings(label_keys, label_offsets, label_values);
+
+    // Members of each component were interned in string order, which the
+    // sorted table preserves, so they stay ascending
+
+    SectionFileWriter writer;
+    writer.add(Meta, meta);
+    writer.add(StringOffsets, strings.offsets());
+    writer.add(StringData, strings.data());
+    writer.add(RelationKeys, relation_keys);
+    writer.add(RelationOffsets, relation_offsets);
+    writer.add(RelationValues, relation_values);
+    writer.add(LabelKeys, label_keys);
+    writer.add(LabelOffsets, label_offsets);
+    writer.add(LabelValues, label_values);
+    writer.add(SValues, s_values);
+    writer.add(SComponentRanges, component_ranges);
+    writer.add(ComponentOffsets, component_offsets);
+    writer.add(ComponentMembers, component_members);
+    writer.add(DegreeNodes, degree_nodes);
+    writer.add(DegreeValues, degree_values);
+    writer.add(CooccurrenceEntities, cooccurrence_entities);
+    const auto& offsets = cooc.offset_array();
+    const auto& partners = cooc.partner_array();
+    const auto& counts = cooc.count_array();
+    writer.add_bytes(CooccurrenceOffsets, offsets.data, offsets.size * sizeof(uint64_t));
+    writer.add_bytes(CooccurrencePartners, partners.data, partners.size * sizeof(uint32_t));
+    writer.add_bytes(CooccurrenceCounts, counts.data, counts.size * sizeof(int32_t));
+    writer.write(path, INDEX_MAGIC, BINARY_VERSION);
+}
+
+HypergraphIndex HypergraphIndex::load_from_binary(const std::string& path) {
+    HypergraphIndex idx;
+    auto& s = *idx.storage_;
+    s.file = std::make_unique<SectionFile>(path, INDEX_MAGIC, BINARY_VERSION, "hypergraph index");
+
+    s.strings.offsets = s.file->section<uint64_t>(StringOffsets);
+    s.strings.data = s.file->section<char>(StringData);
+    s.strings.validate(*s.file);
+
+    auto meta = s.file->section<uint64_t>(Meta, 4);
+    idx.node_count = meta[0];
+    idx.edge_count = meta[1];
+    idx.created_utc = s.string(meta[2]);
+    idx.source_graph_path = s.string(meta[3]);
+
+    // Views used without materialization; the rest are read on first access
+    s.degree_nodes = s.file->section<uint32_t>(DegreeNodes);
+    s.degree_values = s.file->section<int32_t>(DegreeValues, s.degree_nodes.size);
+    s.cooccurrence = CooccurrenceIndex::from_sections(
+        *s.file, s.strings, s.file->section<uint32_t>(CooccurrenceEntities),
+        s.file->section<uint64_t>(CooccurrenceOffsets), s.file->section<uint32_t>(CooccurrencePartners),
+        s.file->section<int32_t>(CooccurrenceCounts));
+    return idx;
+}
+
+HypergraphIndex HypergraphIndex::load(const std::string& path) {
+    if (is_binary_index(path)) {
+        return load_from_binary(path);
+    }
+    return load_from_json(path);
+}
+
+bool HypergraphIndex::is_binary_index(const std::string& path) {
+    return SectionFile::has_magic(path, INDEX_MAGIC);
+}
+
+// ==========================================
+// Incremental maintenance
+// ==========================================
+
+void HypergraphIndex::attach(Hypergraph& graph) {
+    detach();
+    auto [nodes, edges] = current_counts();
+    if (nodes != graph.num_nodes() || edges != graph.num_edges()) {
+        throw std::runtime_error("Index does not describe this graph: it has " + std::to_string(nodes) +
+                                 " nodes and " + std::to_string(edges) + " edges, the graph " +
+                                 std::to_string(graph.num_nodes()) + " and " +
+                                 std::to_string(graph.num_edges()));
+    }
+
+    // The tracker edits materialized tables, so read every one now; a
+    // binary index then no longer needs (or holds open) its file
+    relation_to_edges();
+    label_to_nodes();
+    degree_ranked_nodes();
+    bool stale = storage_->tracker && storage_->tracker->components_stale;
+    if (!stale) s_components();
+
+    auto& s = *storage_;
+    if (s.file) {
+        s.cooccurrence = s.cooccurrence.updated({});
+        s.strings = {};
+        s.degree_nodes = {};
+        s.degree_values = {};
+        s.file.reset();
+    }
+
+    s.tracker = std::make_unique<Tracker>(s, graph);
+    s.tracker->components_stale = stale;
+    graph.add_observer(s.tracker.get());
+}
+
+void HypergraphIndex::detach() {
+    auto& s = *storage_;
+    if (!s.tracker) return;
+
+    auto [nodes, edges] = current_counts();
+    node_count = nodes;
+    edge_count = edges;
+    s.tracker->refresh_degrees();
+    s.tracker->refresh_cooccurrence();
+
+    // Without the graph, stale s-components cannot be recomputed; keep the
+    // tracker so s_components() keeps reporting that
+    if (!s.tracker->graph) return;
+    s.tracker->refresh_components();
+    s.tracker->graph->remove_observer(s.tracker.get());
+    s.tracker.reset();
+}
+
+bool HypergraphIndex::is_attached() const {
+    return storage_->tracker && storage_->tracker->graph;
+}
+
+std::pair<size_t, size_t> HypergraphIndex::current_counts() const {
+    const auto& s = *storage_;
+    if (s.tracker) return {s.tracker->nodes, s.tracker->edges};
+    return {node_count, edge_count};
+}
+
+void HypergraphIndex::print_summary() const {
+    std::cout << "HypergraphIndex Summary:\n";
+    std::cout << "  Created: " << created_utc << "\n";
+    auto [nodes, edges] = current_counts();
+    std::cout << "  Nodes: " << nodes << "\n";
+    std::cout << "  Edges: " << edges << "\n";
+    std::cout << "  Unique relations: " << relation_to_edges().size() << "\n";
+    std::cout << "  Unique labels: " << label_to_nodes().size() << "\n";
+    std::cout << "  S-components cached: ";
+    for (const auto& [s, comps] : s_components()) {
+        std::cout << "s=" << s << " (" << comps.size() << " components) ";
+    }
+    std::cout << "\n";
+    std::cout << "  Co-occurrence pairs: " << cooccurrence().num_pairs() << "\n";
+}
+
+} // namespace kg
@@ -0,0 +1,327 @@
+#include "llm/http_transport.hpp"
+#include <curl/curl.h>
+#include <algorithm>
+#include <stdexcept>
+
+namespace kg {
+
+namespace {
+
+// CURL write callback
+size_t write_callback(void* contents, size_t size, size_t nmemb, std::string* userp) {
+    size_t total_size = size * nmemb;
+    userp->append(static_cast<char*>(contents), total_size);
+    return total_size;
+}
+
+// CURL header callback: keeps the headers that control retries
+size_t header_callback(char* buffer, size_t size, size_t nitems, HttpResponse* response) {
+    size_t total_size = size * nitems;
+    std::string line(buffer, total_size);
+
+    size_t colon = line.find(':');
+    if (colon != std::string::npos) {
+        std::string name = line.substr(0, colon);
+        std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+
+        size_t first = line.find_first_not_of(" \t", colon + 1);
+        size_t last = line.find_last_not_of(" \t\r\n");
+        std::string value = (first == std::string::npos || last < first)
+            ? std::string() : line.substr(first, last - first + 1);
+
+        if (name == "retry-after") {
+            response->retry_after = value;
+        } else if (name == "retry-after-ms") {
+            response->retry_after_ms = value;
+        }
+    }
+    return total_size;
+}
+
+HttpResponse failed_response(const std::string& error) {
+    HttpResponse response;
+    response.error = error;
+    return response;
+}
+
+} // anonymous namespace
+
+struct HttpTransport::Transfer {
+    HttpRequest request;
+    Callback on_done;
+    HttpResponse response;
+    curl_slist* header_list = nullptr;
+
+    ~Transfer() {
+        if (header_list) {
+            curl_slist_free_all(header_list);
+        }
+    }
+};
+
+HttpTransport::HttpTransport() : HttpTransport(Options{}) {}
+
+HttpTransport::HttpTransport(const Options& options) : options_(options) {
+    // Global setup is not thread-safe, so run it once before any handle exists
+    static const CURLcode global_init = curl_global_init(CURL_GLOBAL_DEFAULT);
+    if (global_init != CURLE_OK) {
+        throw std::runtime_error("Failed to initialize CURL");
+    }
+
+    CURLM* multi = curl_multi_init();
+    if (!multi) {
+        throw std::runtime_error("Failed to initialize CURL multi handle");
+    }
+    curl_multi_setopt(multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+    curl_multi_setopt(multi, CURLMOPT_MAX_HOST_CONNECTIONS, options_.max_host_connections);
+    curl_multi_setopt(multi, CURLMOPT_MAXCONNECTS, options_.max_cached_connections);
+    multi_ = multi;
+
+    loop_ = std::thread(&HttpTransport::run, this);
+}
+
+HttpTransport::~HttpTransport() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake();
+    loop_.join();
+
+    for (void* handle : idle_handles_) {
+        curl_easy_cleanup(static_cast<CURL*>(handle));
+    }
+    curl_multi_cleanup(static_cast<CURLM*>(multi_));
+}
+
+void HttpTransport::post(HttpRequest request, Callback on_done) {
+    auto transfer = std::make_unique<Transfer>();
+    transfer->request = std::move(request);
+    transfer->on_done = std::move(on_done);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!stopping_) {
+            submitted_.push_back(std::move(transfer));
+            ++pending_;
+        }
+    }
+
+    if (transfer) {
+        transfer->on_done(failed_response("HTTP transport is shutting down"));
+        return;
+    }
+    wake();
+}
+
+std::future<HttpResponse> HttpTransport::post(HttpRequest request) {
+    auto promise = std::make_shared<std::promise<HttpResponse>>();
+    auto future = promise->get_future();
+    post(std::move(request), [promise](HttpResponse response) {
+        promise->set_value(std::move(response));
+    });
+    return future;
+}
+
+void HttpTransport::schedule(Clock::time_point when, Task task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!stopping_) {
+            timers_.emplace(when, std::move(task));
+            task = nullptr;
+        }
+    }
+
+    if (task) {
+        task(true);
+        return;
+    }
+    wake();
+}
+
+size_t HttpTransport::pending() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pending_;
+}
+
+bool HttpTransport::on_loop_thread() const {
+    return std::this_thread::get_id() == loop_.get_id();
+}
+
+HttpTransport& HttpTransport::shared() {
+    static HttpTransport transport;
+    return transport;
+}
+
+void HttpTransport::wake() {
+    curl_multi_wakeup(static_cast<CURLM*>(multi_));
+}
+
+void HttpTransport::start_transfer(std::unique_ptr<Transfer> transfer) {
+    CURL* curl = nullptr;
+    if (!idle_handles_.empty()) {
+        curl = static_cast<CURL*>(idle_handles_.back());
+        idle_handles_.pop_back();
+    } else {
+        curl = curl_easy_init();
+    }
+    if (!curl) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            --pending_;
+        }
+        transfer->on_done(failed_response("Failed to initialize CURL"));
+        return;
+    }
+
+    for (const auto& header : transfer->request.headers) {
+        transfer->header_list = curl_slist_append(transfer->header_list, header.c_str());
+    }
+    // Send bodies over 1 KB at once instead of waiting a round trip (or a
+    // full second, if the server ignores it) for "100 Continue"
+    transfer->header_list = curl_slist_append(transfer->header_list, "Expect:");
+
+    const HttpRequest& request = transfer->request;
+    curl_easy_setopt(curl, CURLOPT_URL, request.url.c_str());
+    curl_easy_setopt(curl, CURLOPT_POSTFIELDS, request.body.c_str());
+    curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE_LARGE, static_cast<curl_off_t>(request.body.size()));
+    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, transfer->header_list);
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, write_callback);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &transfer->response.body);
+    curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, header_callback);
+    curl_easy_setopt(curl, CURLOPT_HEADERDATA, &transfer->response);
+    curl_easy_setopt(curl, CURLOPT_TIMEOUT, static_cast<long>(request.timeout_seconds));
+    curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+    curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
+    if (options_.http2) {
+        curl_easy_setopt(curl, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS);
+        // Wait for an HTTP/2 connection to multiplex on rather than opening another
+        curl_easy_setopt(curl, CURLOPT_PIPEWAIT, 1L);
+    }
+
+    curl_multi_add_handle(static_cast<CURLM*>(multi_), curl);
+    running_[curl] = std::move(transfer);
+}
+
+void HttpTransport::finish_transfer(void* handle, int result) {
+    auto it = running_.find(handle);
+    std::unique_ptr<Transfer> transfer = std::move(it->second);
+    running_.erase(it);
+
+    CURL* curl = static_cast<CURL*>(handle);
+    if (result != CURLE_OK) {
+        transfer->response.error = curl_easy_strerror(static_cast<CURLcode>(result));
+    } else {
+        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &transfer->response.status);
+    }
+
+    // Connections live in the multi handle's cache; the easy handle is reused
+    curl_multi_remove_handle(static_cast<CURLM*>(multi_), curl);
+    curl_easy_reset(curl);
+    idle_handles_.push_back(curl);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        --pending_;
+    }
+    try {
+        transfer->on_done(std::move(transfer->response));
+    } catch (...) {
+        // A throwing callback must not take down the loop
+    }
+}
+
+void HttpTransport::run() {
+    CURLM* multi = static_cast<CURLM*>(multi_);
+
+    while (true) {
+        std::vector<std::unique_ptr<Transfer>> incoming;
+        std::vector<Task> due;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (stopping_) break;
+            incoming.swap(submitted_);
+            Clock::time_point now = Clock::now();
+            while (!timers_.empty() && timers_.begin()->first <= now) {
+                due.push_back(std::move(timers_.begin()->second));
+                timers_.erase(timers_.begin());
+            }
+        }
+
+        for (auto& transfer : incoming) {
+            start_transfer(std::move(transfer));
+        }
+        for (auto& task : due) {
+            try {
+                task(false);
+            } catch (...) {
+            }
+        }
+
+        int still_running = 0;
+        curl_multi_perform(multi, &still_running);
+
+        int queued = 0;
+        while (CURLMsg* message = curl_multi_info_read(multi, &queued)) {
+            if (message->msg == CURLMSG_DONE) {
+                finish_transfer(message->easy_handle, message->data.result);
+            }
+        }
+
+        // Sleep until socket activity, curl's next timeout, the next timer
+        // or a wake() from another thread
+        long timeout_ms = 1000;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!submitted_.empty() || stopping_) {
+                timeout_ms = 0;
+            } else if (!timers_.empty()) {
+                auto until = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    timers_.begin()->first - Clock::now()).count();
+                timeout_ms = std::clamp<long>(until + 1, 0, timeout_ms);
+            }
+        }
+        long curl_timeout = -1;
+        curl_multi_timeout(multi, &curl_timeout);
+        if (curl_timeout >= 0) {
+            timeout_ms = std::min(timeout_ms, curl_timeout);
+        }
+        curl_multi_poll(multi, nullptr, 0, static_cast<int>(timeout_ms), nullptr);
+    }
+
+    // Fail whatever is still pending, and cancel the timers
+    std::vector<Callback> abandoned;
+    std::vector<Task> cancelled;
+    for (auto& [handle, transfer] : running_) {
+        curl_multi_remove_handle(multi, static_cast<CURL*>(handle));
+        curl_easy_cleanup(static_cast<CURL*>(handle));
+        abandoned.push_back(std::move(transfer->on_done));
+    }
+    running_.clear();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& transfer : submitted_) {
+            abandoned.push_back(std::move(transfer->on_done));
+        }
+        submitted_.clear();
+        for (auto& [when, task] : timers_) {
+            cancelled.push_back(std::move(task));
+        }
+        timers_.clear();
+        pending_ = 0;
+    }
+    for (auto& on_done : abandoned) {
+        try {
+            on_done(failed_response("HTTP transport shut down"));
+        } catch (...) {
+        }
+    }
+    for (auto& task : cancelled) {
+        try {
+            task(true);
+        } catch (...) {
+        }
+    }
+}
+
+} // namespace kg
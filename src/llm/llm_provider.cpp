@@ -1,4 +1,5 @@
 #include "llm/llm_provider.hpp"
+#include "llm/http_transport.hpp"
 #include <nlohmann/json.hpp>
 #include <curl/curl.h>
 #include <iostream>
@@ -9,76 +10,201 @@
 #include <cstdlib>
 #include <stdexcept>
 #include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <ctime>
 
 using json = nlohmann::json;
 
 namespace kg {
 
 // ============================================================================
-// Helper Functions for HTTP Requests
+// Retry Helpers and Async Calls
 // ============================================================================
 
 namespace {
 
-// CURL write callback
-size_t write_callback(void* contents, size_t size, size_t nmemb, std::string* userp) {
-    size_t total_size = size * nmemb;
-    userp->append(static_cast<char*>(contents), total_size);
-    return total_size;
+// Seconds in a "13", "13.5" or "13s" duration, or -1
+double parse_seconds(const std::string& value) {
+    char* end = nullptr;
+    double seconds = std::strtod(value.c_str(), &end);
+    if (end == value.c_str() || seconds < 0 || (*end != '\0' && std::string(end) != "s")) {
+        return -1.0;
+    }
+    return seconds;
 }
 
-// Make HTTP POST request with CURL
-std::string http_post(
-    const std::string& url,
-    const std::string& json_payload,
-    const std::vector<std::string>& headers,
-    int timeout_seconds = 60
-) {
-    CURL* curl = curl_easy_init();
-    if (!curl) {
-        throw std::runtime_error("Failed to initialize CURL");
+/**
+ * @brief Wait requested by a failed response, or a negative duration
+ *
+ * Reads OpenAI's retry-after-ms, the standard Retry-After (seconds or an
+ * HTTP date) and the retryDelay of a Gemini RetryInfo error detail.
+ */
+std::chrono::milliseconds parse_retry_after(const HttpResponse& response) {
+    using std::chrono::milliseconds;
+
+    double ms = parse_seconds(response.retry_after_ms);
+    if (ms >= 0) {
+        return milliseconds(static_cast<long long>(ms));
     }
 
-    std::string response;
-    struct curl_slist* header_list = nullptr;
+    if (!response.retry_after.empty()) {
+        double seconds = parse_seconds(response.retry_after);
+        if (seconds >= 0) {
+            return milliseconds(static_cast<long long>(std::ceil(seconds * 1000.0)));
+        }
+        time_t at = curl_getdate(response.retry_after.c_str(), nullptr);
+        if (at != -1) {
+            return milliseconds(std::max<long long>(0, (at - std::time(nullptr)) * 1000LL));
+        }
+    }
 
-    // Add headers
-    for (const auto& header : headers) {
-        header_list = curl_slist_append(header_list, header.c_str());
+    json j = json::parse(response.body, nullptr, false);
+    if (j.is_object() && j.contains("error") && j["error"].is_object() &&
+        j["error"].contains("details") && j["error"]["details"].is_array()) {
+        for (const auto& detail : j["error"]["details"]) {
+            if (detail.is_object() && detail.contains("retryDelay") && detail["retryDelay"].is_string()) {
+                double seconds = parse_seconds(detail["retryDelay"].get<std::string>());
+                if (seconds >= 0) {
+                    return milliseconds(static_cast<long long>(std::ceil(seconds * 1000.0)));
+                }
+            }
+        }
     }
 
-    curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-    curl_easy_setopt(curl, CURLOPT_POSTFIELDS, json_payload.c_str());
-    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, header_list);
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, write_callback);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response);
-    curl_easy_setopt(curl, CURLOPT_TIMEOUT, timeout_seconds);
+    return milliseconds(-1);
+}
 
-    CURLcode res = curl_easy_perform(curl);
+// Throttling, timeouts, conflicts and server errors may succeed later;
+// other client errors (bad request, auth, unknown model) will not
+bool is_retryable_status(long status) {
+    return status == 408 || status == 409 || status == 429 || status >= 500;
+}
 
-    if (header_list) {
-        curl_slist_free_all(header_list);
-    }
+LLMResponse error_response(const std::string& message) {
+    LLMResponse response;
+    response.success = false;
+    response.error_message = message;
+    return response;
+}
+
+/**
+ * @brief One chat call: waits for budget, sends, retries and reports
+ *
+ * After start() every step runs on the transport's loop thread. Budget
+ * waits and backoff are scheduled timers, so no thread blocks on them.
+ */
+struct AsyncCall : std::enable_shared_from_this<AsyncCall> {
+    HttpTransport* transport = nullptr;
+    HttpRequest request;
+    int estimated_tokens = 0;
+    int max_retries = 0;
+    bool verbose = false;
+    std::string operation_name;
+    std::shared_ptr<RateLimiter> limiter;
+    std::shared_ptr<ResponseCache> cache;
+    std::string cache_key;
+    std::function<LLMResponse(const std::string&)> parse;
+    std::function<void(LLMResponse)> on_done;
+
+    int attempt = 0;
+    std::chrono::steady_clock::time_point sent;
+
+    void start() {
+        auto self = shared_from_this();
+        auto now = std::chrono::steady_clock::now();
+        if (limiter) {
+            auto wait = limiter->try_acquire(estimated_tokens);
+            if (wait > RateLimiter::Clock::duration::zero()) {
+                transport->schedule(now + wait, [self](bool cancelled) { self->resume(cancelled); });
+                return;
+            }
+        }
 
-    if (res != CURLE_OK) {
-        std::string error = curl_easy_strerror(res);
-        curl_easy_cleanup(curl);
-        throw std::runtime_error("CURL request failed: " + error);
+        ++attempt;
+        sent = now;
+        transport->post(request, [self](HttpResponse response) {
+            self->finished(std::move(response));
+        });
     }
 
-    long http_code = 0;
-    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &http_code);
-    curl_easy_cleanup(curl);
+    void finished(HttpResponse http) {
+        auto now = std::chrono::steady_clock::now();
 
-    if (http_code < 200 || http_code >= 300) {
-        throw std::runtime_error(
-            "HTTP request failed with code " + std::to_string(http_code) +
-            ": " + response
-        );
+        if (http.ok()) {
+            LLMResponse response = parse(http.body);
+            response.latency_ms = std::chrono::duration_cast<std::chrono::milliseconds>(now - sent).count();
+            if (limiter) {
+                limiter->reconcile(estimated_tokens, response.total_tokens);
+            }
+
+            if (verbose && response.success) {
+                std::cout << "  Tokens: " << response.total_tokens
+                          << " (prompt: " << response.prompt_tokens
+                          << ", completion: " << response.completion_tokens << ")" << std::endl;
+                std::cout << "  Latency: " << response.latency_ms << " ms" << std::endl;
+            }
+
+            finish(std::move(response));
+            return;
+        }
+
+        std::string error;
+        std::chrono::milliseconds delay(0);
+        if (!http.error.empty()) {
+            error = "CURL request failed: " + http.error;
+            delay = RateLimiter::backoff_delay(attempt);
+        } else {
+            error = "HTTP request failed with code " + std::to_string(http.status) + ": " + http.body;
+            if (!is_retryable_status(http.status)) {
+                finish(error_response("Request failed: " + error));
+                return;
+            }
+
+            auto requested = parse_retry_after(http);
+            delay = requested.count() >= 0
+                ? RateLimiter::with_jitter(requested)
+                : RateLimiter::backoff_delay(attempt);
+
+            // Throttling is account-wide, so hold every caller of the budget
+            if (http.status == 429 && limiter) {
+                limiter->pause_for(delay);
+                delay = std::chrono::milliseconds(0);
+            }
+        }
+
+        if (attempt >= max_retries) {
+            finish(error_response("Failed after " + std::to_string(max_retries) + " attempts: " + error));
+            return;
+        }
+
+        if (verbose) {
+            std::cerr << "Attempt " << attempt << " failed for " << operation_name
+                      << ": " << error << ". Retrying..." << std::endl;
+        }
+
+        auto self = shared_from_this();
+        transport->schedule(now + delay, [self](bool cancelled) { self->resume(cancelled); });
     }
 
-    return response;
-}
+    // A timer fired, or was cancelled because the transport shut down
+    void resume(bool cancelled) {
+        if (cancelled) {
+            finish(error_response("Request failed: HTTP transport shut down"));
+        } else {
+            start();
+        }
+    }
+
+    void finish(LLMResponse response) {
+        if (cache) {
+            cache->put(cache_key, response);
+            response.metadata["cache"] = "miss";
+            response.metadata["cache_key"] = cache_key;
+        }
+        on_done(std::move(response));
+    }
+};
 
 } // anonymous namespace
 
@@ -107,38 +233,135 @@ std::vector<ExtractedRelation> LLMProvider::parse_extraction_response(
     return parse_relations_json(json_response);
 }
 
-template<typename Func>
-LLMResponse LLMProvider::retry_call(Func&& func, const std::string& operation_name) {
-    int attempts = 0;
-    while (attempts < config_.max_retries) {
-        try {
-            return func();
-        } catch (const std::exception& e) {
-            attempts++;
-            if (attempts >= config_.max_retries) {
-                LLMResponse error_response;
-                error_response.success = false;
-                error_response.error_message = std::string("Failed after ") +
-                    std::to_string(config_.max_retries) + " attempts: " + e.what();
-                return error_response;
-            }
+void LLMProvider::chat_async(
+    const std::vector<Message>& messages,
+    std::function<void(LLMResponse)> on_done
+) {
+    on_done(chat(messages));
+}
 
-            if (config_.verbose) {
-                std::cerr << "Attempt " << attempts << " failed for " << operation_name
-                          << ": " << e.what() << ". Retrying..." << std::endl;
-            }
+std::future<LLMResponse> LLMProvider::chat_async(const std::vector<Message>& messages) {
+    auto promise = std::make_shared<std::promise<LLMResponse>>();
+    auto future = promise->get_future();
+    chat_async(messages, [promise](LLMResponse response) {
+        promise->set_value(std::move(response));
+    });
+    return future;
+}
 
-            // Exponential backoff
-            std::this_thread::sleep_for(
-                std::chrono::seconds(static_cast<int>(std::pow(2, attempts - 1)))
-            );
+std::future<ExtractionResult> LLMProvider::extract_relations_async(
+    const std::string& text,
+    const std::string& chunk_id,
+    const std::string& system_prompt
+) {
+    auto promise = std::make_shared<std::promise<ExtractionResult>>();
+    auto future = promise->get_future();
+    chat_async(extraction_messages(text, system_prompt), [this, promise, chunk_id](LLMResponse response) {
+        ExtractionResult result;
+        result.chunk_id = chunk_id;
+        finish_extraction(result, std::move(response));
+        promise->set_value(std::move(result));
+    });
+    return future;
+}
+
+std::string LLMProvider::extraction_key(
+    const std::string& text,
+    const std::string& system_prompt
+) const {
+    json payload;
+    payload["temperature"] = config_.temperature;
+    payload["max_tokens"] = config_.max_tokens;
+    payload["messages"] = json::array();
+    for (const auto& msg : extraction_messages(text, system_prompt)) {
+        payload["messages"].push_back({{"role", msg.role_string()}, {"content", msg.content}});
+    }
+    return ResponseCache::make_key(get_provider_name(), config_.model, payload.dump());
+}
+
+std::vector<Message> LLMProvider::extraction_messages(
+    const std::string& text,
+    const std::string& system_prompt
+) const {
+    std::vector<Message> messages;
+
+    if (!system_prompt.empty()) {
+        messages.push_back(Message(Message::Role::System, system_prompt));
+    } else {
+        messages.push_back(Message(
+            Message::Role::System,
+            PromptTemplates::relation_extraction_system_prompt()
+        ));
+    }
+
+    messages.push_back(Message(
+        Message::Role::User,
+        PromptTemplates::relation_extraction_user_prompt(text)
+    ));
+
+    return messages;
+}
+
+void LLMProvider::finish_extraction(ExtractionResult& result, LLMResponse llm_response) const {
+    result.llm_response = std::move(llm_response);
+
+    if (!result.llm_response.success) {
+        result.success = false;
+        result.error_message = result.llm_response.error_message;
+        return;
+    }
+
+    // Parse extracted relations
+    try {
+        result.relations = parse_extraction_response(result.llm_response.content);
+        result.success = true;
+    } catch (const std::exception& e) {
+        result.success = false;
+        result.error_message = std::string("Failed to parse relations: ") + e.what();
+
+        // Don't answer the next attempt with the same unusable reply
+        auto key = result.llm_response.metadata.find("cache_key");
+        if (response_cache_ && key != result.llm_response.metadata.end()) {
+            response_cache_->erase(key->second);
+        }
+    }
+}
+
+void LLMProvider::send_async(
+    HttpRequest request,
+    int estimated_tokens,
+    const std::string& operation_name,
+    std::function<LLMResponse(const std::string&)> parse,
+    std::function<void(LLMResponse)> on_done
+) {
+    std::string cache_key;
+    if (response_cache_) {
+        cache_key = ResponseCache::make_key(get_provider_name(), config_.model, request.body);
+        if (auto cached = response_cache_->get(cache_key)) {
+            cached->metadata["cache_key"] = cache_key;
+            on_done(std::move(*cached));
+            return;
         }
     }
 
-    LLMResponse error_response;
-    error_response.success = false;
-    error_response.error_message = "Max retries exceeded";
-    return error_response;
+    if (config_.max_retries <= 0) {
+        on_done(error_response("Max retries exceeded"));
+        return;
+    }
+
+    auto call = std::make_shared<AsyncCall>();
+    call->transport = &HttpTransport::shared();
+    call->request = std::move(request);
+    call->estimated_tokens = estimated_tokens;
+    call->max_retries = config_.max_retries;
+    call->verbose = config_.verbose;
+    call->operation_name = operation_name;
+    call->limiter = rate_limiter_;
+    call->cache = response_cache_;
+    call->cache_key = std::move(cache_key);
+    call->parse = std::move(parse);
+    call->on_done = std::move(on_done);
+    call->start();
 }
 
 // ============================================================================
@@ -151,10 +374,10 @@ OpenAIProvider::OpenAIProvider(const std::string& api_key, const std::string& mo
     config_.api_base_url = "https://api.openai.com/v1";
 }
 
-std::string OpenAIProvider::make_request(
+HttpRequest OpenAIProvider::make_request(
     const std::string& endpoint,
     const std::string& json_payload
-) {
+) const {
     std::string url = config_.api_base_url + endpoint;
 
     std::vector<std::string> headers = {
@@ -162,7 +385,12 @@ std::string OpenAIProvider::make_request(
         "Authorization: Bearer " + config_.api_key
     };
 
-    return http_post(url, json_payload, headers, config_.timeout_seconds);
+    HttpRequest request;
+    request.url = url;
+    request.body = json_payload;
+    request.headers = std::move(headers);
+    request.timeout_seconds = config_.timeout_seconds;
+    return request;
 }
 
 std::string OpenAIProvider::build_chat_payload(const std::vector<Message>& messages) {
@@ -222,35 +450,31 @@ LLMResponse OpenAIProvider::complete(const std::string& prompt) {
 }
 
 LLMResponse OpenAIProvider::chat(const std::vector<Message>& messages) {
-    auto start_time = std::chrono::high_resolution_clock::now();
-
-    auto call_api = [&]() -> LLMResponse {
-        std::string payload = build_chat_payload(messages);
-
-        if (config_.verbose) {
-            std::cout << "OpenAI API Request to " << config_.model << std::endl;
-        }
-
-        std::string response_str = make_request("/chat/completions", payload);
-        LLMResponse response = parse_response(response_str);
-
-        auto end_time = std::chrono::high_resolution_clock::now();
-        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
-            end_time - start_time
-        );
-        response.latency_ms = duration.count();
+    // The reply is delivered on the loop thread, so waiting there never ends
+    if (HttpTransport::shared().on_loop_thread()) {
+        return error_response("chat() called on the HTTP loop thread; use chat_async()");
+    }
+    return chat_async(messages).get();
+}
 
-        if (config_.verbose && response.success) {
-            std::cout << "  Tokens: " << response.total_tokens
-                      << " (prompt: " << response.prompt_tokens
-                      << ", completion: " << response.completion_tokens << ")" << std::endl;
-            std::cout << "  Latency: " << response.latency_ms << " ms" << std::endl;
-        }
+void OpenAIProvider::chat_async(
+    const std::vector<Message>& messages,
+    std::function<void(LLMResponse)> on_done
+) {
+    HttpRequest request = make_request("/chat/completions", build_chat_payload(messages));
 
-        return response;
-    };
+    if (config_.verbose) {
+        std::cout << "OpenAI API Request to " << config_.model << std::endl;
+    }
 
-    return retry_call(call_api, "OpenAI chat");
+    int estimated_tokens = RateLimiter::estimate_tokens(messages, config_.max_tokens);
+    send_async(
+        std::move(request),
+        estimated_tokens,
+        "OpenAI chat",
+        [this](const std::string& body) { return parse_response(body); },
+        std::move(on_done)
+    );
 }
 
 ExtractionResult OpenAIProvider::extract_relations(
@@ -260,43 +484,7 @@ ExtractionResult OpenAIProvider::extract_relations(
 ) {
     ExtractionResult result;
     result.chunk_id = chunk_id;
-
-    // Build messages
-    std::vector<Message> messages;
-
-    if (!system_prompt.empty()) {
-        messages.push_back(Message(Message::Role::System, system_prompt));
-    } else {
-        messages.push_back(Message(
-            Message::Role::System,
-            PromptTemplates::relation_extraction_system_prompt()
-        ));
-    }
-
-    messages.push_back(Message(
-        Message::Role::User,
-        PromptTemplates::relation_extraction_user_prompt(text)
-    ));
-
-    // Call API
-    LLMResponse llm_response = chat(messages);
-    result.llm_response = llm_response;
-
-    if (!llm_response.success) {
-        result.success = false;
-        result.error_message = llm_response.error_message;
-        return result;
-    }
-
-    // Parse extracted relations
-    try {
-        result.relations = parse_extraction_response(llm_response.content);
-        result.success = true;
-    } catch (const std::exception& e) {
-        result.success = false;
-        result.error_message = std::string("Failed to parse relations: ") + e.what();
-    }
-
+    finish_extraction(result, chat(extraction_messages(text, system_prompt)));
     return result;
 }
 
@@ -310,17 +498,22 @@ GeminiProvider::GeminiProvider(const std::string& api_key, const std::string& mo
     config_.api_base_url = "https://generativelanguage.googleapis.com/v1";
 }
 
-std::string GeminiProvider::make_request(
+HttpRequest GeminiProvider::make_request(
     const std::string& endpoint,
     const std::string& json_payload
-) {
+) const {
     std::string url = config_.api_base_url + endpoint + "?key=" + config_.api_key;
 
     std::vector<std::string> headers = {
         "Content-Type: application/json"
     };
 
-    return http_post(url, json_payload, headers, config_.timeout_seconds);
+    HttpRequest request;
+    request.url = url;
+    request.body = json_payload;
+    request.headers = std::move(headers);
+    request.timeout_seconds = config_.timeout_seconds;
+    return request;
 }
 
 std::string GeminiProvider::build_gemini_payload(const std::vector<Message>& messages) {
@@ -407,36 +600,32 @@ LLMResponse GeminiProvider::complete(const std::string& prompt) {
 }
 
 LLMResponse GeminiProvider::chat(const std::vector<Message>& messages) {
-    auto start_time = std::chrono::high_resolution_clock::now();
-
-    auto call_api = [&]() -> LLMResponse {
-        std::string payload = build_gemini_payload(messages);
-
-        if (config_.verbose) {
-            std::cout << "Gemini API Request to " << config_.model << std::endl;
-        }
-
-        std::string endpoint = "/models/" + config_.model + ":generateContent";
-        std::string response_str = make_request(endpoint, payload);
-        LLMResponse response = parse_response(response_str);
-
-        auto end_time = std::chrono::high_resolution_clock::now();
-        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
-            end_time - start_time
-        );
-        response.latency_ms = duration.count();
+    // The reply is delivered on the loop thread, so waiting there never ends
+    if (HttpTransport::shared().on_loop_thread()) {
+        return error_response("chat() called on the HTTP loop thread; use chat_async()");
+    }
+    return chat_async(messages).get();
+}
 
-        if (config_.verbose && response.success) {
-            std::cout << "  Tokens: " << response.total_tokens
-                      << " (prompt: " << response.prompt_tokens
-                      << ", completion: " << response.completion_tokens << ")" << std::endl;
-            std::cout << "  Latency: " << response.latency_ms << " ms" << std::endl;
-        }
+void GeminiProvider::chat_async(
+    const std::vector<Message>& messages,
+    std::function<void(LLMResponse)> on_done
+) {
+    std::string endpoint = "/models/" + config_.model + ":generateContent";
+    HttpRequest request = make_request(endpoint, build_gemini_payload(messages));
 
-        return response;
-    };
+    if (config_.verbose) {
+        std::cout << "Gemini API Request to " << config_.model << std::endl;
+    }
 
-    return retry_call(call_api, "Gemini chat");
+    int estimated_tokens = RateLimiter::estimate_tokens(messages, config_.max_tokens);
+    send_async(
+        std::move(request),
+        estimated_tokens,
+        "Gemini chat",
+        [this](const std::string& body) { return parse_response(body); },
+        std::move(on_done)
+    );
 }
 
 ExtractionResult GeminiProvider::extract_relations(
@@ -446,43 +635,7 @@ ExtractionResult GeminiProvider::extract_relations(
 ) {
     ExtractionResult result;
     result.chunk_id = chunk_id;
-
-    // Build messages
-    std::vector<Message> messages;
-
-    if (!system_prompt.empty()) {
-        messages.push_back(Message(Message::Role::System, system_prompt));
-    } else {
-        messages.push_back(Message(
-            Message::Role::System,
-            PromptTemplates::relation_extraction_system_prompt()
-        ));
-    }
-
-    messages.push_back(Message(
-        Message::Role::User,
-        PromptTemplates::relation_extraction_user_prompt(text)
-    ));
-
-    // Call API
-    LLMResponse llm_response = chat(messages);
-    result.llm_response = llm_response;
-
-    if (!llm_response.success) {
-        result.success = false;
-        result.error_message = llm_response.error_message;
-        return result;
-    }
-
-    // Parse extracted relations
-    try {
-        result.relations = parse_extraction_response(llm_response.content);
-        result.success = true;
-    } catch (const std::exception& e) {
-        result.success = false;
-        result.error_message = std::string("Failed to parse relations: ") + e.what();
-    }
-
+    finish_extraction(result, chat(extraction_messages(text, system_prompt)));
     return result;
 }
 
@@ -494,16 +647,42 @@ std::unique_ptr<LLMProvider> LLMProviderFactory::create(
     ProviderType type,
     const LLMConfig& config
 ) {
+    std::unique_ptr<LLMProvider> provider;
+    std::string limiter_key;
     switch (type) {
         case ProviderType::OpenAI:
-            return std::make_unique<OpenAIProvider>(config.api_key, config.model);
+            provider = std::make_unique<OpenAIProvider>(config.api_key, config.model);
+            limiter_key = "openai/" + config.model;
+            break;
 
         case ProviderType::Gemini:
-            return std::make_unique<GeminiProvider>(config.api_key, config.model);
+            provider = std::make_unique<GeminiProvider>(config.api_key, config.model);
+            limiter_key = "gemini/" + config.model;
+            break;
 
         default:
             throw std::invalid_argument("Unknown provider type");
     }
+
+    LLMConfig provider_config = config;
+    if (provider_config.api_base_url.empty()) {
+        provider_config.api_base_url = provider->get_config().api_base_url;
+    }
+    provider->set_config(provider_config);
+
+    // Extraction, discovery and reporting create their own providers; they
+    // share one budget per provider and model
+    auto limiter = RateLimiter::shared(limiter_key);
+    if (config.requests_per_minute > 0 || config.tokens_per_minute > 0) {
+        limiter->set_limits(config.requests_per_minute, config.tokens_per_minute);
+    }
+    provider->set_rate_limiter(std::move(limiter));
+
+    if (!config.cache_directory.empty()) {
+        provider->set_response_cache(std::make_shared<ResponseCache>(config.cache_directory));
+    }
+
+    return provider;
 }
 
 std::unique_ptr<LLMProvider> LLMProviderFactory::create(
@@ -638,6 +817,18 @@ std::unique_ptr<LLMProvider> LLMProviderFactory::create_from_config_file(
             config.max_retries = config_json["max_retries"];
         }
 
+        if (config_json.contains("requests_per_minute")) {
+            config.requests_per_minute = config_json["requests_per_minute"];
+        }
+
+        if (config_json.contains("tokens_per_minute")) {
+            config.tokens_per_minute = config_json["tokens_per_minute"];
+        }
+
+        if (config_json.contains("cache_directory")) {
+            config.cache_directory = config_json["cache_directory"];
+        }
+
         if (config_json.contains("verbose")) {
             config.verbose = config_json["verbose"];
         }
@@ -0,0 +1,189 @@
+#include "llm/rate_limiter.hpp"
+#include "llm/llm_provider.hpp"
+#include <algorithm>
+#include <map>
+#include <random>
+
+namespace kg {
+
+namespace {
+
+std::mt19937_64& jitter_engine() {
+    thread_local std::mt19937_64 engine{std::random_device{}()};
+    return engine;
+}
+
+// Time for a bucket refilling per_minute units a minute to gain `missing` units
+RateLimiter::Clock::duration time_to_refill(double missing, int per_minute) {
+    auto wait = std::chrono::duration<double>(missing * 60.0 / per_minute);
+    return std::chrono::ceil<RateLimiter::Clock::duration>(wait);
+}
+
+// Fill of a newly limited bucket: one second of budget, at least one unit,
+// so calls ramp up at the refill rate instead of spending a minute at once
+double initial_fill(int per_minute) {
+    return per_minute > 0 ? std::max(1.0, per_minute / 60.0) : 0.0;
+}
+
+} // anonymous namespace
+
+RateLimiter::RateLimiter(int requests_per_minute, int tokens_per_minute)
+    : requests_per_minute_(std::max(0, requests_per_minute)),
+      tokens_per_minute_(std::max(0, tokens_per_minute)),
+      requests_available_(initial_fill(requests_per_minute_)),
+      tokens_available_(initial_fill(tokens_per_minute_)),
+      last_refill_(Clock::now()),
+      paused_until_(last_refill_) {}
+
+void RateLimiter::refill(Clock::time_point now) {
+    // last_refill_ is in the future while a pause holds the buckets empty
+    if (now <= last_refill_) return;
+
+    double minutes = std::chrono::duration<double>(now - last_refill_).count() / 60.0;
+    if (requests_per_minute_ > 0) {
+        requests_available_ = std::min<double>(
+            requests_per_minute_, requests_available_ + minutes * requests_per_minute_);
+    }
+    if (tokens_per_minute_ > 0) {
+        tokens_available_ = std::min<double>(
+            tokens_per_minute_, tokens_available_ + minutes * tokens_per_minute_);
+    }
+    last_refill_ = now;
+}
+
+void RateLimiter::set_limits(int requests_per_minute, int tokens_per_minute) {
+    requests_per_minute = std::max(0, requests_per_minute);
+    tokens_per_minute = std::max(0, tokens_per_minute);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    refill(Clock::now());
+
+    // A bucket that was unlimited starts nearly empty; a shrunk one is clamped
+    requests_available_ = requests_per_minute_ == 0
+        ? initial_fill(requests_per_minute)
+        : std::min<double>(requests_available_, requests_per_minute);
+    tokens_available_ = tokens_per_minute_ == 0
+        ? initial_fill(tokens_per_minute)
+        : std::min<double>(tokens_available_, tokens_per_minute);
+
+    requests_per_minute_ = requests_per_minute;
+    tokens_per_minute_ = tokens_per_minute;
+    changed_.notify_all();
+}
+
+int RateLimiter::requests_per_minute() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return requests_per_minute_;
+}
+
+int RateLimiter::tokens_per_minute() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return tokens_per_minute_;
+}
+
+RateLimiter::Clock::duration RateLimiter::take_or_wait(int estimated_tokens, Clock::time_point now) {
+    if (now < paused_until_) {
+        return paused_until_ - now;
+    }
+    refill(now);
+
+    Clock::duration wait = Clock::duration::zero();
+    if (requests_per_minute_ > 0 && requests_available_ < 1.0) {
+        wait = std::max(wait, time_to_refill(1.0 - requests_available_, requests_per_minute_));
+    }
+    if (tokens_per_minute_ > 0) {
+        double needed = std::min(estimated_tokens, tokens_per_minute_);
+        if (tokens_available_ < needed) {
+            wait = std::max(wait, time_to_refill(needed - tokens_available_, tokens_per_minute_));
+        }
+    }
+
+    if (wait == Clock::duration::zero()) {
+        if (requests_per_minute_ > 0) requests_available_ -= 1.0;
+        if (tokens_per_minute_ > 0) tokens_available_ -= estimated_tokens;
+    }
+    return wait;
+}
+
+void RateLimiter::acquire(int estimated_tokens) {
+    estimated_tokens = std::max(0, estimated_tokens);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        Clock::duration wait = take_or_wait(estimated_tokens, Clock::now());
+        if (wait == Clock::duration::zero()) return;
+
+        // Woken early by set_limits(), pause_for() or a refund
+        changed_.wait_for(lock, wait);
+    }
+}
+
+RateLimiter::Clock::duration RateLimiter::try_acquire(int estimated_tokens) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return take_or_wait(std::max(0, estimated_tokens), Clock::now());
+}
+
+void RateLimiter::reconcile(int estimated_tokens, int actual_tokens) {
+    if (actual_tokens <= 0) return;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (tokens_per_minute_ == 0) return;
+
+    tokens_available_ = std::min<double>(
+        tokens_per_minute_, tokens_available_ + std::max(0, estimated_tokens) - actual_tokens);
+    if (actual_tokens < estimated_tokens) {
+        changed_.notify_all();
+    }
+}
+
+void RateLimiter::pause_for(std::chrono::milliseconds delay) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Clock::time_point now = Clock::now();
+    refill(now);
+
+    paused_until_ = std::max(paused_until_, now + delay);
+    requests_available_ = std::min(requests_available_, 0.0);
+    tokens_available_ = std::min(tokens_available_, 0.0);
+    last_refill_ = std::max(last_refill_, paused_until_);
+    changed_.notify_all();
+}
+
+int RateLimiter::estimate_tokens(const std::vector<Message>& messages, int max_completion_tokens) {
+    size_t chars = 0;
+    for (const auto& message : messages) {
+        // A few tokens of role and framing per message
+        chars += message.content.size() + 16;
+    }
+    return static_cast<int>(chars / 4) + std::max(0, max_completion_tokens);
+}
+
+std::chrono::milliseconds RateLimiter::backoff_delay(
+    int attempt,
+    std::chrono::milliseconds base,
+    std::chrono::milliseconds cap
+) {
+    int shift = std::clamp(attempt - 1, 0, 30);
+    long long ceiling = std::min<long long>(cap.count(), base.count() * (1LL << shift));
+    std::uniform_int_distribution<long long> pick(0, std::max(0LL, ceiling));
+    return std::chrono::milliseconds(pick(jitter_engine()));
+}
+
+std::chrono::milliseconds RateLimiter::with_jitter(std::chrono::milliseconds delay) {
+    long long spread = std::min<long long>(1000, delay.count() / 10);
+    std::uniform_int_distribution<long long> pick(0, std::max(0LL, spread));
+    return delay + std::chrono::milliseconds(pick(jitter_engine()));
+}
+
+std::shared_ptr<RateLimiter> RateLimiter::shared(const std::string& key) {
+    static std::mutex registry_mutex;
+    static std::map<std::string, std::shared_ptr<RateLimiter>> registry;
+
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    auto& limiter = registry[key];
+    if (!limiter) {
+        limiter = std::make_shared<RateLimiter>();
+    }
+    return limiter;
+}
+
+} // namespace kg
@@ -0,0 +1,301 @@
+#include "llm/response_cache.hpp"
+#include "llm/llm_provider.hpp"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <unistd.h>
+
+using json = nlohmann::json;
+namespace fs = std::filesystem;
+
+namespace kg {
+
+namespace {
+
+// ============================================================================
+// SHA-256 (FIPS 180-4)
+// ============================================================================
+
+class Sha256 {
+public:
+    void update(const void* data, size_t size) {
+        const auto* bytes = static_cast<const uint8_t*>(data);
+        length_ += size;
+        while (size > 0) {
+            size_t take = std::min(size, block_.size() - used_);
+            std::copy(bytes, bytes + take, block_.begin() + used_);
+            used_ += take;
+            bytes += take;
+            size -= take;
+            if (used_ == block_.size()) {
+                compress();
+                used_ = 0;
+            }
+        }
+    }
+
+    std::string hex_digest() {
+        uint64_t bits = length_ * 8;
+        uint8_t pad = 0x80;
+        update(&pad, 1);
+        pad = 0;
+        while (used_ != 56) {
+            update(&pad, 1);
+        }
+        uint8_t length_bytes[8];
+        for (int i = 0; i < 8; ++i) {
+            length_bytes[i] = static_cast<uint8_t>(bits >> (56 - 8 * i));
+        }
+        update(length_bytes, 8);
+
+        static const char* digits = "0123456789abcdef";
+        std::string hex;
+        hex.reserve(64);
+        for (uint32_t word : state_) {
+            for (int shift = 28; shift >= 0; shift -= 4) {
+                hex += digits[(word >> shift) & 0xF];
+            }
+        }
+        return hex;
+    }
+
+private:
+    std::array<uint32_t, 8> state_ = {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+        0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+    };
+    std::array<uint8_t, 64> block_{};
+    size_t used_ = 0;
+    uint64_t length_ = 0;
+
+    static uint32_t rotr(uint32_t x, int n) { return (x >> n) | (x << (32 - n)); }
+
+    void compress() {
+        static const uint32_t k[64] = {
+            0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+            0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+            0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+            0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+            0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+            0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+            0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+            0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+        };
+
+        uint32_t w[64];
+        for (int i = 0; i < 16; ++i) {
+            w[i] = (uint32_t(block_[4 * i]) << 24) | (uint32_t(block_[4 * i + 1]) << 16) |
+                   (uint32_t(block_[4 * i + 2]) << 8) | uint32_t(block_[4 * i + 3]);
+        }
+        for (int i = 16; i < 64; ++i) {
+            uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+            uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+
+        uint32_t a = state_[0], b = state_[1], c = state_[2], d = state_[3];
+        uint32_t e = state_[4], f = state_[5], g = state_[6], h = state_[7];
+        for (int i = 0; i < 64; ++i) {
+            uint32_t s1 = rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25);
+            uint32_t choose = (e & f) ^ (~e & g);
+            uint32_t t1 = h + s1 + choose + k[i] + w[i];
+            uint32_t s0 = rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22);
+            uint32_t majority = (a & b) ^ (a & c) ^ (b & c);
+            uint32_t t2 = s0 + majority;
+            h = g; g = f; f = e; e = d + t1;
+            d = c; c = b; b = a; a = t1 + t2;
+        }
+        state_[0] += a; state_[1] += b; state_[2] += c; state_[3] += d;
+        state_[4] += e; state_[5] += f; state_[6] += g; state_[7] += h;
+    }
+};
+
+// Length-prefix each field so ("ab", "c") and ("a", "bc") hash differently
+void hash_field(Sha256& hash, const std::string& field) {
+    std::string length = std::to_string(field.size()) + ":";
+    hash.update(length.data(), length.size());
+    hash.update(field.data(), field.size());
+}
+
+std::optional<LLMResponse> parse_entry(const std::string& key, const json& j) {
+    if (!j.is_object() || j.value("key", "") != key || !j.contains("content") || !j["content"].is_string()) {
+        return std::nullopt;
+    }
+    LLMResponse response;
+    response.content = j["content"].get<std::string>();
+    response.model = j.value("model", "");
+    response.prompt_tokens = j.value("prompt_tokens", 0);
+    response.completion_tokens = j.value("completion_tokens", 0);
+    response.total_tokens = j.value("total_tokens", 0);
+    response.success = true;
+    response.metadata["cache"] = "hit";
+    return response;
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// ResponseCache
+// ============================================================================
+
+ResponseCache::ResponseCache(const std::string& directory) : directory_(directory) {
+    std::error_code ec;
+    fs::create_directories(directory_, ec);
+    if (ec) {
+        throw std::runtime_error("Cannot create LLM cache directory " + directory_ + ": " + ec.message());
+    }
+}
+
+ResponseCache::~ResponseCache() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    changed_.notify_all();
+    if (writer_.joinable()) {
+        writer_.join();
+    }
+}
+
+std::string ResponseCache::make_key(
+    const std::string& provider,
+    const std::string& model,
+    const std::string& payload
+) {
+    Sha256 hash;
+    hash_field(hash, provider);
+    hash_field(hash, model);
+    hash_field(hash, payload);
+    return hash.hex_digest();
+}
+
+std::string ResponseCache::entry_path(const std::string& key) const {
+    return directory_ + "/" + key.substr(0, 2) + "/" + key + ".json";
+}
+
+std::optional<LLMResponse> ResponseCache::get(const std::string& key) {
+    std::optional<LLMResponse> response;
+    bool queued = false;
+    {
+        // Entries not yet written (or removed) are answered from the queue
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = pending_.find(key);
+        if (it != pending_.end()) {
+            queued = true;
+            if (!it->second.erased) {
+                response = parse_entry(key, json::parse(it->second.serialized, nullptr, false));
+            }
+        }
+    }
+    if (!response && !queued) {
+        std::ifstream file(entry_path(key));
+        if (file) {
+            response = parse_entry(key, json::parse(file, nullptr, false));
+        }
+    }
+    ++(response ? hits_ : misses_);
+    return response;
+}
+
+void ResponseCache::put(const std::string& key, const LLMResponse& response) {
+    if (!response.success) return;
+
+    json j;
+    j["key"] = key;
+    j["model"] = response.model;
+    j["content"] = response.content;
+    j["prompt_tokens"] = response.prompt_tokens;
+    j["completion_tokens"] = response.completion_tokens;
+    j["total_tokens"] = response.total_tokens;
+
+    enqueue(key, j.dump(), false);
+}
+
+void ResponseCache::erase(const std::string& key) {
+    enqueue(key, "", true);
+}
+
+void ResponseCache::enqueue(const std::string& key, std::string serialized, bool erased) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        PendingEntry& entry = pending_[key];
+        entry.version = ++next_version_;
+        entry.serialized = std::move(serialized);
+        entry.erased = erased;
+        queue_.push_back(key);
+        if (!writer_.joinable()) {
+            writer_ = std::thread(&ResponseCache::run_writer, this);
+        }
+    }
+    changed_.notify_all();
+}
+
+void ResponseCache::flush() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    changed_.wait(lock, [this]() { return queue_.empty() && !writing_; });
+}
+
+void ResponseCache::run_writer() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        changed_.wait(lock, [this]() { return !queue_.empty() || stopping_; });
+        if (queue_.empty()) break;
+
+        std::string key = std::move(queue_.front());
+        queue_.pop_front();
+        auto it = pending_.find(key);
+        if (it != pending_.end()) {     // Otherwise written from an earlier queue slot
+            PendingEntry entry = it->second;
+
+            writing_ = true;
+            lock.unlock();
+            if (entry.erased) {
+                std::error_code ec;
+                fs::remove(entry_path(key), ec);
+            } else {
+                write_entry(key, entry.serialized);
+            }
+            lock.lock();
+            writing_ = false;
+
+            // Keep the entry if it was put again while being written
+            it = pending_.find(key);
+            if (it != pending_.end() && it->second.version == entry.version) {
+                pending_.erase(it);
+            }
+        }
+        changed_.notify_all();
+    }
+}
+
+void ResponseCache::write_entry(const std::string& key, const std::string& serialized) {
+    std::string path = entry_path(key);
+    std::error_code ec;
+    fs::create_directories(fs::path(path).parent_path(), ec);
+
+    // Unique temporary name per writer, then an atomic rename into place
+    std::ostringstream tmp;
+    tmp << path << ".tmp." << getpid() << "." << std::this_thread::get_id();
+    {
+        std::ofstream file(tmp.str(), std::ios::binary | std::ios::trunc);
+        if (!file) return;
+        file << serialized;
+        if (!file) {
+            file.close();
+            fs::remove(tmp.str(), ec);
+            return;
+        }
+    }
+    fs::rename(tmp.str(), path, ec);
+    if (ec) {
+        fs::remove(tmp.str(), ec);
+    }
+}
+
+} // namespace kg
@@ -262,9 +262,9 @@ int cmd_index(const Args& args) {
     auto s_values = args.get("s-components", "2,3,4").as_int_list();
 
     std::cout << "Loading hypergraph from: " << input_path << "\n";
-    Hypergraph graph = Hypergraph::load_from_json(input_path);
+    Hypergraph graph = Hypergraph::load(input_path);
 
-    auto stats = graph.compute_statistics();
+    auto stats = graph.compute_statistics(StatisticsTier::Cheap);
     std::cout << "Loaded " << stats.num_nodes << " nodes and " << stats.num_edges << " edges\n";
 
     std::cout << "Building index...\n";
@@ -284,10 +284,10 @@ int cmd_index(const Args& args) {
 
     std::string index_path = output_dir;
     if (index_path.back() != '/') index_path += "/";
-    index_path += "hypergraph_index.json";
+    index_path += "hypergraph_index.kgi";
 
     std::cout << "Saving index to: " << index_path << "\n";
-    index.save_to_json(index_path);
+    index.save_to_binary(index_path);
 
     index.print_summary();
 
@@ -304,20 +304,24 @@ int cmd_discover(const Args& args) {
     std::string run_id = args.get("run-id", "").value;
 
     std::cout << "Loading hypergraph from: " << input_path << "\n";
-    Hypergraph graph = Hypergraph::load_from_json(input_path);
+    Hypergraph graph = Hypergraph::load(input_path);
 
-    auto stats = graph.compute_statistics();
+    auto stats = graph.compute_statistics(StatisticsTier::Cheap);
     std::cout << "Loaded " << stats.num_nodes << " nodes and " << stats.num_edges << " edges\n";
 
     // Load or build index
     HypergraphIndex index;
     if (!index_path.empty() && fs::exists(index_path)) {
         // If index_path is a directory, append the default filename
+        // (binary index, else an index written by older versions)
         if (fs::is_directory(index_path)) {
-            index_path = (fs::path(index_path) / "hypergraph_index.json").string();
+            fs::path binary_index = fs::path(index_path) / "hypergraph_index.kgi";
+            index_path = fs::exists(binary_index)
+                ? binary_index.string()
+                : (fs::path(index_path) / "hypergraph_index.json").string();
         }
         std::cout << "Loading index from: " << index_path << "\n";
-        index = HypergraphIndex::load_from_json(index_path);
+        index = HypergraphIndex::load(index_path);
     } else {
         std::cout << "Building index (no cached index provided)...\n";
         index.build(graph, {2, 3, 4});
@@ -377,9 +381,9 @@ int cmd_render(const Args& args) {
     std::string title = args.get("title", "Knowledge Graph").value;
 
     std::cout << "Loading hypergraph from: " << input_path << "\n";
-    Hypergraph graph = Hypergraph::load_from_json(input_path);
+    Hypergraph graph = Hypergraph::load(input_path);
 
-    auto stats = graph.compute_statistics();
+    auto stats = graph.compute_statistics(StatisticsTier::Cheap);
     std::cout << "Loaded " << stats.num_nodes << " nodes and " << stats.num_edges << " edges\n";
 
     // Ensure output directory exists
@@ -455,9 +459,9 @@ int cmd_report(const Args& args) {
     int max_examples = args.get("max-examples", "5").as_int();
 
     std::cout << "Loading hypergraph from: " << input_path << "\n";
-    Hypergraph graph = Hypergraph::load_from_json(input_path);
+    Hypergraph graph = Hypergraph::load(input_path);
 
-    auto stats = graph.compute_statistics();
+    auto stats = graph.compute_statistics(StatisticsTier::Cheap);
     std::cout << "Loaded " << stats.num_nodes << " nodes and " << stats.num_edges << " edges\n";
 
     std::cout << "Loading insights from: " << insights_path << "\n";
@@ -571,10 +575,22 @@ int cmd_report(const Args& args) {
 int cmd_stats(const Args& args) {
     std::string input_path = args.require("input");
 
+    // Statistics only look at topology and relations
+    JsonLoadOptions projection;
+    projection.embeddings = false;
+    projection.node_properties = false;
+    projection.edge_properties = false;
+    projection.provenance = false;
+
     std::cout << "Loading hypergraph from: " << input_path << "\n";
-    Hypergraph graph = Hypergraph::load_from_json(input_path);
+    Hypergraph graph = Hypergraph::load(input_path, projection);
+
+    StatisticsOptions options;
+    options.overlap_sample_threshold = static_cast<size_t>(std::max(0, args.get("sample-above", "200000").as_int()));
+    options.overlap_sample_size = static_cast<size_t>(std::max(0, args.get("sample-size", "20000").as_int()));
+    options.num_threads = static_cast<size_t>(std::max(0, args.get("threads", "0").as_int()));
 
-    auto stats = graph.compute_statistics();
+    auto stats = graph.compute_statistics(options);
 
     std::cout << "\nHypergraph Statistics:\n";
     std::cout << "  Nodes: " << stats.num_nodes << "\n";
@@ -585,6 +601,23 @@ int cmd_stats(const Args& args) {
     std::cout << "  Max edge size: " << stats.max_edge_size << "\n";
     std::cout << "  Duplicate edges: " << stats.num_duplicate_edges << "\n";
 
+    if (stats.overlap_estimated) {
+        std::cout << "  Edge pairs sharing >=1 node: ~" << stats.num_pairs_overlap_1
+                  << " (+/- " << static_cast<size_t>(stats.overlap_1_margin) << ")\n";
+        std::cout << "  Edge pairs sharing >=2 nodes: ~" << stats.num_pairs_overlap_2
+                  << " (+/- " << static_cast<size_t>(stats.overlap_2_margin) << ")\n";
+        std::cout << "  Edge pairs sharing >=3 nodes: ~" << stats.num_pairs_overlap_3
+                  << " (+/- " << static_cast<size_t>(stats.overlap_3_margin) << ")\n";
+        std::cout << "  Max edge intersection (sampled): " << stats.max_edge_intersection << "\n";
+        std::cout << "  (overlaps estimated from " << stats.overlap_sample_size
+                  << " sampled edges, 95% confidence)\n";
+    } else {
+        std::cout << "  Edge pairs sharing >=1 node: " << stats.num_pairs_overlap_1 << "\n";
+        std::cout << "  Edge pairs sharing >=2 nodes: " << stats.num_pairs_overlap_2 << "\n";
+        std::cout << "  Edge pairs sharing >=3 nodes: " << stats.num_pairs_overlap_3 << "\n";
+        std::cout << "  Max edge intersection: " << stats.max_edge_intersection << "\n";
+    }
+
     // Top hubs
     auto hubs = graph.get_top_hubs(10);
     std::cout << "\nTop 10 Hubs:\n";
@@ -597,6 +630,105 @@ int cmd_stats(const Args& args) {
     return 0;
 }
 
+// ============== kg dedup ==============
+int cmd_dedup(const Args& args) {
+    std::string input_path = args.require("input");
+    std::string output_path = args.get("output", "").value;
+    double threshold = args.get("threshold", "0.95").as_double(0.95);
+
+    AnnConfig ann;
+    ann.method = ann_method_from_string(args.get("index", "hnsw").value);
+    ann.max_neighbors = static_cast<size_t>(std::max(0, args.get("max-neighbors", "32").as_int()));
+    ann.hnsw_ef_search = static_cast<size_t>(std::max(1, args.get("ef", "64").as_int()));
+    ann.num_threads = static_cast<size_t>(std::max(0, args.get("threads", "0").as_int()));
+
+    std::cout << "Loading hypergraph from: " << input_path << "\n";
+    Hypergraph graph = Hypergraph::load(input_path);
+
+    if (args.has("report")) {
+        // Largest group of same-dimension embeddings is what the index sees
+        std::map<size_t, std::vector<std::vector<float>>> by_dimension;
+        for (const auto& node : graph.get_all_nodes()) {
+            if (!node.embedding.empty()) {
+                by_dimension[node.embedding.size()].push_back(node.embedding);
+            }
+        }
+        const std::vector<std::vector<float>>* vectors = nullptr;
+        for (const auto& [dimension, group] : by_dimension) {
+            if (!vectors || group.size() > vectors->size()) vectors = &group;
+        }
+
+        if (vectors) {
+            auto report = evaluate_vector_index(*vectors, ann,
+                static_cast<size_t>(std::max(1, args.get("queries", "200").as_int())), 10);
+            std::cout << "\nANN recall/latency (" << report.method << ", "
+                      << report.num_vectors << " x " << report.dimension << "):\n";
+            std::cout << report.to_json().dump(2) << "\n";
+        } else {
+            std::cout << "\nNo node embeddings found; nothing to evaluate\n";
+        }
+    }
+
+    // An index built for the input follows the merges instead of being rebuilt
+    std::string update_index = args.get("update-index", "").value;
+    HypergraphIndex index;
+    if (!update_index.empty()) {
+        std::cout << "Loading index from: " << update_index << "\n";
+        index = HypergraphIndex::load(update_index);
+        index.attach(graph);
+    }
+
+    size_t before = graph.num_nodes();
+    auto start = std::chrono::steady_clock::now();
+    size_t merged = graph.merge_similar_nodes(threshold, ann);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "\nMerged " << merged << " of " << before << " nodes at threshold "
+              << threshold << " in " << seconds << "s\n";
+
+    if (!output_path.empty()) {
+        graph.export_to_json(output_path);
+        std::cout << "Saved deduplicated graph to: " << output_path << "\n";
+    }
+
+    if (!update_index.empty()) {
+        if (!output_path.empty()) index.source_graph_path = output_path;
+        index.save_to_binary(update_index);
+        std::cout << "Updated index: " << update_index << "\n";
+    }
+
+    return 0;
+}
+
+// ============== kg convert ==============
+int cmd_convert(const Args& args) {
+    std::string input_path = args.require("input");
+    std::string output_path = args.require("output");
+
+    auto start = std::chrono::steady_clock::now();
+    Hypergraph graph = Hypergraph::load(input_path);
+    double load_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Loaded " << graph.num_nodes() << " nodes, " << graph.num_edges()
+              << " edges from " << input_path << " in " << load_seconds << "s\n";
+
+    JsonWriteOptions json_options;
+    json_options.compact = args.has("compact");
+
+    start = std::chrono::steady_clock::now();
+    fs::path output_file(output_path);
+    if (output_file.extension() == ".gz") output_file.replace_extension();
+    if (output_file.extension() == ".json") {
+        graph.export_to_json(output_path, true, json_options);
+    } else {
+        graph.export_to_binary(output_path);
+    }
+    double save_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Wrote " << output_path << " (" << fs::file_size(output_path) << " bytes) in "
+              << save_seconds << "s\n";
+
+    return 0;
+}
+
 // ============== kg run (Full Pipeline) ==============
 int cmd_run(const Args& args) {
     std::string input_path = args.get("input", "").value;
@@ -688,8 +820,17 @@ int cmd_run(const Args& args) {
             }
         }
     } else {
-        // Fresh run from stage 1
-        run_id = generate_run_id();
+        // Stage 1: a fresh run, or an interrupted one whose extraction
+        // journal lets already extracted chunks be skipped
+        if (!existing_run_dir.empty()) {
+            run_dir = existing_run_dir;
+            if (run_dir.back() == '/') {
+                run_dir.pop_back();
+            }
+            run_id = fs::path(run_dir).filename().string();
+        } else {
+            run_id = generate_run_id();
+        }
 
         std::cout << "Run ID: " << run_id << "\n";
         std::cout << "Input:  " << input_path << "\n";
@@ -707,9 +848,11 @@ int cmd_run(const Args& args) {
         }
 
         // Create run output directory
-        run_dir = output_base;
-        if (run_dir.back() != '/') run_dir += "/";
-        run_dir += run_id;
+        if (run_dir.empty()) {
+            run_dir = output_base;
+            if (run_dir.back() != '/') run_dir += "/";
+            run_dir += run_id;
+        }
         fs::create_directories(run_dir);
 
         std::cout << "\nOutput: " << run_dir << "/\n";
@@ -725,7 +868,7 @@ int cmd_run(const Args& args) {
     // Define paths for all artifacts
     std::string graph_path = run_dir + "/graph.json";
     std::string graph_raw_path = run_dir + "/graph_raw.json";
-    std::string index_path = run_dir + "/index.json";
+    std::string index_path = run_dir + "/index.kgi";
     std::string insights_path = run_dir + "/insights.json";
 
     // Declare variables used across stages
@@ -763,6 +906,13 @@ int cmd_run(const Args& args) {
         pipeline_config.output_directory = run_dir;
         pipeline_config.save_intermediate = true;
         pipeline_config.save_extractions = true;
+        if (args.has("no-cache")) {
+            pipeline_config.enable_llm_cache = false;
+            pipeline_config.journal_resume = false;
+        }
+        if (args.has("no-resume")) {
+            pipeline_config.journal_resume = false;
+        }
 
         // Validate config
         std::string config_error;
@@ -790,7 +940,7 @@ int cmd_run(const Args& args) {
             return 1;
         }
 
-        graph_stats = graph.compute_statistics();
+        graph_stats = graph.compute_statistics(StatisticsTier::Cheap);
         std::cout << "\n  Extracted: " << graph_stats.num_nodes << " entities, "
                   << graph_stats.num_edges << " relationships\n";
 
@@ -823,8 +973,8 @@ int cmd_run(const Args& args) {
         }
 
         std::cout << "  Loading: graph.json\n";
-        graph = Hypergraph::load_from_json(graph_path);
-        graph_stats = graph.compute_statistics();
+        graph = Hypergraph::load(graph_path);
+        graph_stats = graph.compute_statistics(StatisticsTier::Cheap);
         std::cout << "  Loaded: " << graph_stats.num_nodes << " entities, "
                   << graph_stats.num_edges << " relationships\n";
     }
@@ -850,7 +1000,7 @@ int cmd_run(const Args& args) {
         merge_aliases(graph, preprocess_stats);
         preprocess_ran = true;
 
-        graph_stats = graph.compute_statistics();
+        graph_stats = graph.compute_statistics(StatisticsTier::Cheap);
         graph.export_to_json(graph_path, true);
 
         std::cout << "  Normalized relations: " << preprocess_stats.relations_normalized << "\n";
@@ -873,9 +1023,9 @@ int cmd_run(const Args& args) {
         index.source_graph_path = graph_path;
         index.build(graph, {2, 3, 4});
 
-        index.save_to_json(index_path);
+        index.save_to_binary(index_path);
         std::cout << "  S-components computed for s = 2, 3, 4\n";
-        std::cout << "  Saved: index.json\n";
+        std::cout << "  Saved: index.kgi\n";
     } else {
         // Load existing index
         std::cout << "\n";
@@ -883,14 +1033,18 @@ int cmd_run(const Args& args) {
         std::cout << "  Stage 2: Building Index [SKIPPED - loading existing]\n";
         std::cout << "----------------------------------------------------------------------\n";
 
+        // Runs made by older versions stored the index as JSON
+        if (!fs::exists(index_path) && fs::exists(run_dir + "/index.json")) {
+            index_path = run_dir + "/index.json";
+        }
         if (!fs::exists(index_path)) {
             std::cerr << "Error: Required file not found: " << index_path << "\n";
             return 1;
         }
 
-        std::cout << "  Loading: index.json\n";
-        index = HypergraphIndex::load_from_json(index_path);
-        std::cout << "  Loaded index with " << index.s_components.size() << " s-component sets\n";
+        std::cout << "  Loading: " << fs::path(index_path).filename().string() << "\n";
+        index = HypergraphIndex::load(index_path);
+        std::cout << "  Loaded index with " << index.s_components().size() << " s-component sets\n";
     }
     std::cout << "  Stage 2 time: " << format_duration(std::chrono::steady_clock::now() - stage2_start) << "\n";
 
@@ -1122,7 +1276,7 @@ int cmd_run(const Args& args) {
         manifest["preprocess"]["relations_normalized"] = preprocess_stats.relations_normalized;
         manifest["preprocess"]["nodes_merged"] = preprocess_stats.nodes_merged;
     }
-    manifest["artifacts"]["index"] = "index.json";
+    manifest["artifacts"]["index"] = "index.kgi";
     manifest["artifacts"]["insights"] = "insights.json";
     manifest["artifacts"]["augmentation"] = "augmentation.json";
     manifest["artifacts"]["visualizations"]["baseline"] = "graph.html";
@@ -1149,7 +1303,7 @@ int cmd_run(const Args& args) {
     if (preprocess) {
         readme << "    graph_raw.json       - Raw graph prior to preprocessing\n";
     }
-    readme << "    index.json           - S-component index\n";
+    readme << "    index.kgi            - S-component index (binary)\n";
     readme << "    insights.json        - Discovered insights\n";
     readme << "    augmentation.json    - Augmentation overlay data\n";
     readme << "    extraction_stats.json - Pipeline statistics\n";
@@ -1212,7 +1366,7 @@ int main(int argc, char** argv) {
         "index",
         "Build indices and caches for a hypergraph",
         {
-            {"input", "i", "Input hypergraph JSON file", "", true, false},
+            {"input", "i", "Input hypergraph (JSON or binary snapshot)", "", true, false},
             {"output", "o", "Output directory for index files", "index/", false, false},
             {"s-components", "s", "Comma-separated s-values for s-components", "2,3,4", false, false}
         },
@@ -1224,7 +1378,7 @@ int main(int argc, char** argv) {
         "discover",
         "Run discovery operators to find insights",
         {
-            {"input", "i", "Input hypergraph JSON file", "", true, false},
+            {"input", "i", "Input hypergraph (JSON or binary snapshot)", "", true, false},
             {"index", "x", "Index directory (optional, will build if not provided)", "", false, false},
             {"output", "o", "Output path for insights JSON", "", true, false},
             {"operators", "p", "Operators: bridges,completions,motifs,substitutions,contradictions,entity_resolution,core_periphery,text_similarity,argument_support,active_learning,method_outcome,centrality,community_detection,k_core,k_truss,claim_stance,relation_induction,analogical_transfer,uncertainty_sampling,counterfactual,hyperedge_prediction,diffusion,surprise,rules,community,pathrank,embedding,author_chain,hypotheses (or 'all')", "bridges,completions,motifs", false, false},
@@ -1238,7 +1392,7 @@ int main(int argc, char** argv) {
         "render",
         "Export graph visualization with optional augmentation",
         {
-            {"input", "i", "Input hypergraph JSON file", "", true, false},
+            {"input", "i", "Input hypergraph (JSON or binary snapshot)", "", true, false},
             {"insights", "n", "Insights JSON file (optional, for augmented view)", "", false, false},
             {"output", "o", "Output directory for HTML and JSON files", "", true, false},
             {"title", "t", "Title for the visualization", "Knowledge Graph", false, false}
@@ -1251,17 +1405,51 @@ int main(int argc, char** argv) {
         "stats",
         "Print statistics about a hypergraph",
         {
-            {"input", "i", "Input hypergraph JSON file", "", true, false}
+            {"input", "i", "Input hypergraph (JSON or binary snapshot)", "", true, false},
+            {"sample-above", "a", "Estimate pairwise overlaps when the graph has more edges than this (0 = always exact)", "200000", false, false},
+            {"sample-size", "n", "Edges sampled for the overlap estimate", "20000", false, false},
+            {"threads", "j", "Worker threads for overlap counting (0 = all cores)", "0", false, false}
         },
         cmd_stats
     });
 
+    // kg dedup
+    cli.register_command({
+        "dedup",
+        "Merge nodes with similar embeddings",
+        {
+            {"input", "i", "Input hypergraph (JSON or binary snapshot)", "", true, false},
+            {"output", "o", "Output path for the deduplicated graph JSON", "", false, false},
+            {"threshold", "t", "Cosine similarity threshold for merging", "0.95", false, false},
+            {"index", "x", "Neighbour search: hnsw or exact", "hnsw", false, false},
+            {"max-neighbors", "k", "Neighbours considered per node (0 = unbounded)", "32", false, false},
+            {"ef", "e", "HNSW search candidate list size", "64", false, false},
+            {"threads", "j", "Worker threads for neighbour queries (0 = all cores)", "0", false, false},
+            {"report", "r", "Print recall@10 and latency of the index against brute force", "", false, true},
+            {"queries", "q", "Queries used for the recall report", "200", false, false},
+            {"update-index", "u", "Binary index built for the input, updated in place with the merges", "", false, false}
+        },
+        cmd_dedup
+    });
+
+    // kg convert
+    cli.register_command({
+        "convert",
+        "Convert a hypergraph between JSON and the binary snapshot format",
+        {
+            {"input", "i", "Input hypergraph (JSON or binary snapshot)", "", true, false},
+            {"output", "o", "Output path (.json / .json.gz writes JSON, anything else a binary snapshot, e.g. .kgb)", "", true, false},
+            {"compact", "c", "Write JSON without indentation", "", false, true}
+        },
+        cmd_convert
+    });
+
     // kg report
     cli.register_command({
         "report",
         "Generate a natural language report from insights",
         {
-            {"input", "i", "Input hypergraph JSON file", "", true, false},
+            {"input", "i", "Input hypergraph (JSON or binary snapshot)", "", true, false},
             {"insights", "n", "Insights JSON file", "", true, false},
             {"output", "o", "Output path for report (.md or .html)", "", true, false},
             {"format", "f", "Output format: auto, markdown, html (default: auto from extension)", "auto", false, false},
@@ -1284,8 +1472,10 @@ int main(int argc, char** argv) {
             {"title", "t", "Title for reports and visualizations", "", false, false},
             {"max-examples", "m", "Max examples per insight type in reports", "10", false, false},
             {"from-stage", "f", "Start from stage (1=extract, 2=index, 3=discover, 4=render, 5=report)", "1", false, false},
-            {"run-dir", "d", "Existing run directory to resume (required if from-stage > 1)", "", false, false},
-            {"preprocess", "P", "Normalize relations and merge aliases before indexing", "", false, true}
+            {"run-dir", "d", "Existing run directory to resume (required if from-stage > 1; with stage 1, skips chunks already extracted there)", "", false, false},
+            {"preprocess", "P", "Normalize relations and merge aliases before indexing", "", false, true},
+            {"no-cache", "", "Send every chunk to the LLM instead of reusing cached responses or the journal", "", false, true},
+            {"no-resume", "", "Start a fresh extraction journal instead of skipping chunks already in it", "", false, true}
         },
         cmd_run
     });
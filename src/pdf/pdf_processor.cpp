@@ -410,6 +410,7 @@ std::string PDFProcessor::clean_text(const std::string& raw_text) const {
 
 PDFDocument PDFProcessor::load_pdf(const std::string& file_path) {
 #ifndef HAVE_POPPLER
+    (void)file_path;
     throw std::runtime_error("Poppler support not available. Rebuild with Poppler.");
 #else
     if (verbose_) {
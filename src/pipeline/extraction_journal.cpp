@@ -0,0 +1,212 @@
+#include "pipeline/extraction_journal.hpp"
+#include <nlohmann/json.hpp>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <unistd.h>
+
+using json = nlohmann::json;
+namespace fs = std::filesystem;
+
+namespace kg {
+
+namespace {
+
+std::string entry_key(const std::string& document_id, const std::string& chunk_id) {
+    return document_id + "\n" + chunk_id;
+}
+
+json result_to_json(
+    const std::string& document_id,
+    const std::string& request_key,
+    const ExtractionResult& result
+) {
+    json j;
+    j["document_id"] = document_id;
+    j["chunk_id"] = result.chunk_id;
+    j["request_key"] = request_key;
+    j["model"] = result.llm_response.model;
+    j["prompt_tokens"] = result.llm_response.prompt_tokens;
+    j["completion_tokens"] = result.llm_response.completion_tokens;
+    j["total_tokens"] = result.llm_response.total_tokens;
+
+    j["relations"] = json::array();
+    for (const auto& rel : result.relations) {
+        json rel_json;
+        rel_json["sources"] = rel.sources;
+        rel_json["relation"] = rel.relation;
+        rel_json["targets"] = rel.targets;
+        rel_json["confidence"] = rel.confidence;
+        if (!rel.source_text.empty()) rel_json["source_text"] = rel.source_text;
+        if (!rel.properties.empty()) rel_json["properties"] = rel.properties;
+        j["relations"].push_back(rel_json);
+    }
+    return j;
+}
+
+ExtractionResult result_from_json(const json& j) {
+    ExtractionResult result;
+    result.chunk_id = j.at("chunk_id").get<std::string>();
+    result.success = true;
+    result.llm_response.success = true;
+    result.llm_response.model = j.value("model", "");
+    result.llm_response.prompt_tokens = j.value("prompt_tokens", 0);
+    result.llm_response.completion_tokens = j.value("completion_tokens", 0);
+    result.llm_response.total_tokens = j.value("total_tokens", 0);
+    result.llm_response.metadata["journal"] = "resumed";
+
+    for (const auto& rel_json : j.at("relations")) {
+        ExtractedRelation rel;
+        rel.sources = rel_json.at("sources").get<std::vector<std::string>>();
+        rel.relation = rel_json.at("relation").get<std::string>();
+        rel.targets = rel_json.at("targets").get<std::vector<std::string>>();
+        rel.confidence = rel_json.value("confidence", 1.0);
+        rel.source_text = rel_json.value("source_text", "");
+        if (rel_json.contains("properties")) {
+            rel.properties = rel_json["properties"].get<std::map<std::string, std::string>>();
+        }
+        result.relations.push_back(std::move(rel));
+    }
+    return result;
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// ExtractionJournal
+// ============================================================================
+
+ExtractionJournal::ExtractionJournal(const std::string& path)
+    : ExtractionJournal(path, Options{}) {}
+
+ExtractionJournal::ExtractionJournal(const std::string& path, const Options& options)
+    : path_(path), options_(options) {
+    fs::path parent = fs::path(path_).parent_path();
+    if (!parent.empty()) {
+        std::error_code ec;
+        fs::create_directories(parent, ec);
+    }
+
+    if (options_.resume) {
+        load();
+    } else {
+        std::error_code ec;
+        fs::resize_file(path_, 0, ec);
+    }
+
+    fd_ = ::open(path_.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (fd_ < 0) {
+        throw std::runtime_error("Cannot open extraction journal " + path_ + ": " + std::strerror(errno));
+    }
+}
+
+ExtractionJournal::~ExtractionJournal() {
+    if (fd_ >= 0) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        sync_locked();
+        ::close(fd_);
+    }
+}
+
+void ExtractionJournal::load() {
+    std::ifstream file(path_, std::ios::binary);
+    if (!file) return;
+
+    std::ostringstream contents;
+    contents << file.rdbuf();
+    const std::string data = contents.str();
+
+    // Only newline-terminated lines were written completely
+    size_t complete = 0;
+    size_t start = 0;
+    for (size_t end = data.find('\n'); end != std::string::npos; end = data.find('\n', start)) {
+        json j = json::parse(data.begin() + start, data.begin() + end, nullptr, false);
+        start = end + 1;
+        complete = start;
+
+        if (!j.is_object() || !j.contains("chunk_id") || !j.contains("relations")) continue;
+        try {
+            Entry entry;
+            entry.request_key = j.value("request_key", "");
+            entry.result = result_from_json(j);
+            entries_[entry_key(j.value("document_id", ""), entry.result.chunk_id)] = std::move(entry);
+        } catch (const json::exception&) {
+            // Malformed record: the chunk is extracted again
+        }
+    }
+    recovered_ = entries_.size();
+
+    // Cut a line torn by a crash so the next append starts on a fresh line
+    if (complete < data.size()) {
+        std::error_code ec;
+        fs::resize_file(path_, complete, ec);
+    }
+}
+
+std::optional<ExtractionResult> ExtractionJournal::lookup(
+    const std::string& document_id,
+    const std::string& chunk_id,
+    const std::string& request_key
+) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(entry_key(document_id, chunk_id));
+    if (it == entries_.end() || it->second.request_key != request_key) {
+        return std::nullopt;
+    }
+    return it->second.result;
+}
+
+void ExtractionJournal::append(
+    const std::string& document_id,
+    const std::string& request_key,
+    const ExtractionResult& result
+) {
+    if (!result.success) return;
+
+    std::string line = result_to_json(document_id, request_key, result).dump() + "\n";
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // O_APPEND makes each write land at the end; loop over short writes
+    size_t written = 0;
+    while (written < line.size()) {
+        ssize_t n = ::write(fd_, line.data() + written, line.size() - written);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            throw std::runtime_error("Cannot write extraction journal " + path_ + ": " + std::strerror(errno));
+        }
+        written += static_cast<size_t>(n);
+    }
+    ++appended_;
+
+    auto now = std::chrono::steady_clock::now();
+    if (unsynced_++ == 0) {
+        first_unsynced_ = now;
+    }
+    if ((options_.sync_every > 0 && unsynced_ >= options_.sync_every) ||
+        now - first_unsynced_ >= options_.sync_interval) {
+        sync_locked();
+    }
+}
+
+void ExtractionJournal::sync() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    sync_locked();
+}
+
+void ExtractionJournal::sync_locked() {
+    if (unsynced_ == 0) return;
+    ::fsync(fd_);
+    unsynced_ = 0;
+}
+
+size_t ExtractionJournal::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return recovered_ + appended_;
+}
+
+} // namespace kg
@@ -5,6 +5,8 @@
 #include <chrono>
 #include <thread>
 #include <algorithm>
+#include <deque>
+#include <future>
 #include <cctype>
 #include <cstdlib>
 #include <sys/stat.h>
@@ -115,6 +117,21 @@ PipelineConfig PipelineConfig::from_json_file(const std::string& path) {
         config.llm_timeout_seconds = j["timeout_seconds"];
     }
 
+    if (j.contains("llm_requests_per_minute")) {
+        config.llm_requests_per_minute = j["llm_requests_per_minute"];
+    } else if (j.contains("requests_per_minute")) {
+        config.llm_requests_per_minute = j["requests_per_minute"];
+    }
+
+    if (j.contains("llm_tokens_per_minute")) {
+        config.llm_tokens_per_minute = j["llm_tokens_per_minute"];
+    } else if (j.contains("tokens_per_minute")) {
+        config.llm_tokens_per_minute = j["tokens_per_minute"];
+    }
+
+    if (j.contains("enable_llm_cache")) config.enable_llm_cache = j["enable_llm_cache"];
+    if (j.contains("llm_cache_directory")) config.llm_cache_directory = j["llm_cache_directory"];
+
     // Chunking config
     if (j.contains("chunking_strategy")) config.chunking_strategy = j["chunking_strategy"];
     if (j.contains("chunk_size")) config.chunk_size = j["chunk_size"];
@@ -127,10 +144,12 @@ PipelineConfig PipelineConfig::from_json_file(const std::string& path) {
     if (j.contains("batch_size")) config.batch_size = j["batch_size"];
     if (j.contains("rate_limit_delay_ms")) config.rate_limit_delay_ms = j["rate_limit_delay_ms"];
     if (j.contains("parallel_processing")) config.parallel_processing = j["parallel_processing"];
+    if (j.contains("max_concurrent_requests")) config.max_concurrent_requests = j["max_concurrent_requests"];
 
     // Deduplication config
     if (j.contains("enable_deduplication")) config.enable_deduplication = j["enable_deduplication"];
     if (j.contains("similarity_threshold")) config.similarity_threshold = j["similarity_threshold"];
+    if (j.contains("dedup_index")) config.dedup_index = j["dedup_index"];
 
     // Output config
     if (j.contains("output_directory")) config.output_directory = j["output_directory"];
@@ -138,6 +157,13 @@ PipelineConfig PipelineConfig::from_json_file(const std::string& path) {
     if (j.contains("save_extractions")) config.save_extractions = j["save_extractions"];
     if (j.contains("verbose")) config.verbose = j["verbose"];
 
+    // Resume config
+    if (j.contains("enable_journal")) config.enable_journal = j["enable_journal"];
+    if (j.contains("journal_path")) config.journal_path = j["journal_path"];
+    if (j.contains("journal_resume")) config.journal_resume = j["journal_resume"];
+    if (j.contains("journal_sync_every")) config.journal_sync_every = j["journal_sync_every"];
+    if (j.contains("journal_sync_interval_ms")) config.journal_sync_interval_ms = j["journal_sync_interval_ms"];
+
     // Custom prompt
     if (j.contains("custom_system_prompt")) config.custom_system_prompt = j["custom_system_prompt"];
 
@@ -155,6 +181,10 @@ void PipelineConfig::to_json_file(const std::string& path) const {
     j["llm_max_tokens"] = llm_max_tokens;
     j["llm_max_retries"] = llm_max_retries;
     j["llm_timeout_seconds"] = llm_timeout_seconds;
+    j["llm_requests_per_minute"] = llm_requests_per_minute;
+    j["llm_tokens_per_minute"] = llm_tokens_per_minute;
+    j["enable_llm_cache"] = enable_llm_cache;
+    j["llm_cache_directory"] = llm_cache_directory;
 
     // Chunking config
     j["chunking_strategy"] = chunking_strategy;
@@ -168,10 +198,12 @@ void PipelineConfig::to_json_file(const std::string& path) const {
     j["batch_size"] = batch_size;
     j["rate_limit_delay_ms"] = rate_limit_delay_ms;
     j["parallel_processing"] = parallel_processing;
+    j["max_concurrent_requests"] = max_concurrent_requests;
 
     // Deduplication config
     j["enable_deduplication"] = enable_deduplication;
     j["similarity_threshold"] = similarity_threshold;
+    j["dedup_index"] = dedup_index;
 
     // Output config
     j["output_directory"] = output_directory;
@@ -179,6 +211,13 @@ void PipelineConfig::to_json_file(const std::string& path) const {
     j["save_extractions"] = save_extractions;
     j["verbose"] = verbose;
 
+    // Resume config
+    j["enable_journal"] = enable_journal;
+    j["journal_path"] = journal_path;
+    j["journal_resume"] = journal_resume;
+    j["journal_sync_every"] = journal_sync_every;
+    j["journal_sync_interval_ms"] = journal_sync_interval_ms;
+
     // Custom prompt
     if (!custom_system_prompt.empty()) {
         j["custom_system_prompt"] = custom_system_prompt;
@@ -239,11 +278,31 @@ bool PipelineConfig::validate(std::string& error_message) const {
         return false;
     }
 
+    if (llm_requests_per_minute < 0 || llm_tokens_per_minute < 0) {
+        error_message = "LLM rate budgets must not be negative";
+        return false;
+    }
+
+    if (max_concurrent_requests < 1) {
+        error_message = "Max concurrent requests must be at least 1";
+        return false;
+    }
+
+    if (journal_sync_every < 0 || journal_sync_interval_ms < 0) {
+        error_message = "Journal sync settings must not be negative";
+        return false;
+    }
+
     if (similarity_threshold < 0.0 || similarity_threshold > 1.0) {
         error_message = "Similarity threshold must be between 0.0 and 1.0";
         return false;
     }
 
+    if (dedup_index != "hnsw" && dedup_index != "exact") {
+        error_message = "Dedup index must be 'hnsw' or 'exact'";
+        return false;
+    }
+
     return true;
 }
 
@@ -266,7 +325,15 @@ void PipelineStatistics::print_summary() const {
     std::cout << "  API calls: " << extraction_calls << "\n";
     std::cout << "  Successes: " << extraction_successes << "\n";
     std::cout << "  Failures: " << extraction_failures << "\n";
-    std::cout << "  Relations extracted: " << total_relations_extracted << "\n\n";
+    std::cout << "  Relations extracted: " << total_relations_extracted << "\n";
+    if (llm_cache_hits > 0 || llm_cache_misses > 0) {
+        std::cout << "  Cache hits: " << llm_cache_hits
+                  << " (misses: " << llm_cache_misses << ")\n";
+    }
+    if (chunks_resumed > 0) {
+        std::cout << "  Resumed from journal: " << chunks_resumed << " chunks\n";
+    }
+    std::cout << "\n";
 
     std::cout << "Token Usage:\n";
     std::cout << "  Prompt tokens: " << total_prompt_tokens << "\n";
@@ -286,6 +353,10 @@ void PipelineStatistics::print_summary() const {
         std::cout << "  Nodes before dedup: " << nodes_before_dedup << "\n";
         std::cout << "  Nodes merged: " << nodes_merged << "\n";
     }
+    if (duplicate_edges_removed > 0 || self_loops_removed > 0) {
+        std::cout << "  Duplicate edges removed: " << duplicate_edges_removed << "\n";
+        std::cout << "  Self-loops removed: " << self_loops_removed << "\n";
+    }
 
     std::cout << "\n" << std::string(70, '=') << "\n\n";
 }
@@ -302,6 +373,9 @@ json PipelineStatistics::to_json() const {
     j["extraction_successes"] = extraction_successes;
     j["extraction_failures"] = extraction_failures;
     j["total_relations_extracted"] = total_relations_extracted;
+    j["llm_cache_hits"] = llm_cache_hits;
+    j["llm_cache_misses"] = llm_cache_misses;
+    j["chunks_resumed"] = chunks_resumed;
 
     j["total_prompt_tokens"] = total_prompt_tokens;
     j["total_completion_tokens"] = total_completion_tokens;
@@ -316,6 +390,8 @@ json PipelineStatistics::to_json() const {
     j["final_edges"] = final_edges;
     j["nodes_before_dedup"] = nodes_before_dedup;
     j["nodes_merged"] = nodes_merged;
+    j["duplicate_edges_removed"] = duplicate_edges_removed;
+    j["self_loops_removed"] = self_loops_removed;
 
     return j;
 }
@@ -347,6 +423,14 @@ void ExtractionPipeline::initialize_components() {
     llm_config.max_tokens = config_.llm_max_tokens;
     llm_config.max_retries = config_.llm_max_retries;
     llm_config.timeout_seconds = config_.llm_timeout_seconds;
+    llm_config.requests_per_minute = config_.llm_requests_per_minute;
+    llm_config.tokens_per_minute = config_.llm_tokens_per_minute;
+    if (llm_config.requests_per_minute == 0 && config_.rate_limit_delay_ms > 0) {
+        llm_config.requests_per_minute = (60000 + config_.rate_limit_delay_ms - 1) / config_.rate_limit_delay_ms;
+    }
+    if (config_.enable_llm_cache) {
+        llm_config.cache_directory = config_.llm_cache_directory;
+    }
     llm_config.verbose = config_.verbose;
 
     llm_provider_ = LLMProviderFactory::create(config_.llm_provider, llm_config);
@@ -360,6 +444,25 @@ void ExtractionPipeline::initialize_components() {
     #else
         mkdir(config_.output_directory.c_str(), 0755);
     #endif
+
+    // Open (or reopen) the extraction journal
+    journal_.reset();
+    if (config_.enable_journal) {
+        std::string path = config_.journal_path.empty()
+            ? config_.output_directory + "/extraction_journal.jsonl"
+            : config_.journal_path;
+
+        ExtractionJournal::Options options;
+        options.sync_every = static_cast<size_t>(config_.journal_sync_every);
+        options.sync_interval = std::chrono::milliseconds(config_.journal_sync_interval_ms);
+        options.resume = config_.journal_resume;
+        journal_ = std::make_unique<ExtractionJournal>(path, options);
+
+        if (config_.verbose && journal_->recovered() > 0) {
+            std::cout << "Resuming: " << journal_->recovered()
+                      << " chunks already extracted in " << path << "\n";
+        }
+    }
 }
 
 std::unique_ptr<ChunkingStrategy> ExtractionPipeline::create_chunking_strategy() {
@@ -396,16 +499,20 @@ Hypergraph ExtractionPipeline::process_pdf(const std::string& pdf_path) {
     PDFDocument doc = pdf_processor_->load_pdf(pdf_path);
     auto pdf_end = std::chrono::high_resolution_clock::now();
 
-    stats_.documents_processed++;
-    stats_.total_pages += doc.metadata.num_pages;
-    stats_.pdf_processing_time_seconds += std::chrono::duration<double>(
-        pdf_end - pdf_start
-    ).count();
+    {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        stats_.documents_processed++;
+        stats_.total_pages += doc.metadata.num_pages;
+        stats_.pdf_processing_time_seconds += std::chrono::duration<double>(
+            pdf_end - pdf_start
+        ).count();
+    }
 
     // Process document
     Hypergraph graph = process_document(doc);
 
     auto end_time = std::chrono::high_resolution_clock::now();
+    std::lock_guard<std::mutex> lock(stats_mutex_);
     stats_.total_time_seconds += std::chrono::duration<double>(
         end_time - start_time
     ).count();
@@ -418,7 +525,10 @@ Hypergraph ExtractionPipeline::process_document(const PDFDocument& doc) {
 
     // Chunk document
     auto chunks = pdf_processor_->chunk_document(doc, *chunking_strategy_);
-    stats_.total_chunks += chunks.size();
+    {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        stats_.total_chunks += chunks.size();
+    }
 
     if (config_.verbose) {
         std::cout << "Created " << chunks.size() << " chunks from "
@@ -433,9 +543,12 @@ Hypergraph ExtractionPipeline::process_document(const PDFDocument& doc) {
     Hypergraph graph = build_graph_from_results(extraction_results, doc.document_id);
     auto graph_end = std::chrono::high_resolution_clock::now();
 
-    stats_.graph_building_time_seconds += std::chrono::duration<double>(
-        graph_end - graph_start
-    ).count();
+    {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        stats_.graph_building_time_seconds += std::chrono::duration<double>(
+            graph_end - graph_start
+        ).count();
+    }
 
     // Save intermediate
     if (config_.save_intermediate) {
@@ -449,48 +562,62 @@ std::vector<ExtractionResult> ExtractionPipeline::extract_from_chunks(
     const std::vector<TextChunk>& chunks,
     const std::string& document_id
 ) {
-    std::vector<ExtractionResult> results;
-
-    for (size_t i = 0; i < chunks.size(); ++i) {
-        report_progress("Extracting", i + 1, chunks.size(), chunks[i].chunk_id);
-
-        auto llm_start = std::chrono::high_resolution_clock::now();
+    std::vector<ExtractionResult> results(chunks.size());
+
+    // A journalled chunk is reused only if it would be sent the same request
+    std::vector<std::string> request_keys;
+    if (journal_) {
+        request_keys.reserve(chunks.size());
+        for (const auto& chunk : chunks) {
+            request_keys.push_back(llm_provider_->extraction_key(chunk.text, config_.custom_system_prompt));
+        }
+    }
 
-        // Extract relations
-        ExtractionResult result = llm_provider_->extract_relations(
-            chunks[i].text,
-            chunks[i].chunk_id,
-            config_.custom_system_prompt
-        );
+    size_t window = config_.parallel_processing
+        ? static_cast<size_t>(std::max(1, config_.max_concurrent_requests))
+        : 1;
 
-        auto llm_end = std::chrono::high_resolution_clock::now();
-        stats_.llm_time_seconds += std::chrono::duration<double>(
-            llm_end - llm_start
-        ).count();
+    // Keep up to `window` calls in flight on the provider's async transport
+    // and collect them in chunk order, so results land in their chunk's slot
+    std::deque<std::pair<size_t, std::future<ExtractionResult>>> in_flight;
+    size_t completed = 0;
+    auto collect_oldest = [&]() {
+        size_t i = in_flight.front().first;
+        results[i] = in_flight.front().second.get();
+        in_flight.pop_front();
 
-        // Update statistics
-        stats_.extraction_calls++;
-        if (result.success) {
-            stats_.extraction_successes++;
-            stats_.total_relations_extracted += result.relations.size();
+        if (journal_) {
+            journal_->append(document_id, request_keys[i], results[i]);
+        }
+        record_extraction(results[i], chunks[i], results[i].llm_response.latency_ms / 1000.0);
+        report_progress("Extracting", static_cast<int>(++completed), chunks.size(), chunks[i].chunk_id);
+    };
 
-            stats_.total_prompt_tokens += result.llm_response.prompt_tokens;
-            stats_.total_completion_tokens += result.llm_response.completion_tokens;
-            stats_.total_tokens += result.llm_response.total_tokens;
-        } else {
-            stats_.extraction_failures++;
-            if (config_.verbose) {
-                std::cerr << "Extraction failed for " << chunks[i].chunk_id
-                          << ": " << result.error_message << "\n";
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        const auto& chunk = chunks[i];
+        if (journal_) {
+            if (auto journalled = journal_->lookup(document_id, chunk.chunk_id, request_keys[i])) {
+                results[i] = std::move(*journalled);
+                record_extraction(results[i], chunk, 0.0);
+                report_progress("Extracting", static_cast<int>(++completed), chunks.size(), chunk.chunk_id);
+                continue;
             }
         }
 
-        results.push_back(result);
-
-        // Rate limiting
-        if (i < chunks.size() - 1) {
-            apply_rate_limit();
+        if (in_flight.size() >= window) {
+            collect_oldest();
         }
+        in_flight.emplace_back(i, llm_provider_->extract_relations_async(
+            chunk.text,
+            chunk.chunk_id,
+            config_.custom_system_prompt
+        ));
+    }
+    while (!in_flight.empty()) {
+        collect_oldest();
+    }
+    if (journal_) {
+        journal_->sync();
     }
 
     // Save extraction results
@@ -501,11 +628,54 @@ std::vector<ExtractionResult> ExtractionPipeline::extract_from_chunks(
     return results;
 }
 
+void ExtractionPipeline::record_extraction(
+    const ExtractionResult& result,
+    const TextChunk& chunk,
+    double seconds
+) {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+
+    // Extracted by an earlier run: no call was made this time
+    if (result.llm_response.metadata.count("journal")) {
+        stats_.chunks_resumed++;
+        stats_.total_relations_extracted += result.relations.size();
+        return;
+    }
+
+    stats_.llm_time_seconds += seconds;
+
+    // Update statistics
+    stats_.extraction_calls++;
+    auto cache = result.llm_response.metadata.find("cache");
+    bool cache_hit = cache != result.llm_response.metadata.end() && cache->second == "hit";
+    if (cache != result.llm_response.metadata.end()) {
+        (cache_hit ? stats_.llm_cache_hits : stats_.llm_cache_misses)++;
+    }
+
+    if (result.success) {
+        stats_.extraction_successes++;
+        stats_.total_relations_extracted += result.relations.size();
+
+        if (!cache_hit) {
+            stats_.total_prompt_tokens += result.llm_response.prompt_tokens;
+            stats_.total_completion_tokens += result.llm_response.completion_tokens;
+            stats_.total_tokens += result.llm_response.total_tokens;
+        }
+    } else {
+        stats_.extraction_failures++;
+        if (config_.verbose) {
+            std::cerr << "Extraction failed for " << chunk.chunk_id
+                      << ": " << result.error_message << "\n";
+        }
+    }
+}
+
 Hypergraph ExtractionPipeline::build_graph_from_results(
     const std::vector<ExtractionResult>& results,
     const std::string& document_id
 ) {
-    Hypergraph graph;
+    // Collected first so the graph normalizes every node label in one batch
+    std::vector<HyperEdge> edges;
 
     for (const auto& result : results) {
         if (!result.success) continue;
@@ -530,10 +700,12 @@ Hypergraph ExtractionPipeline::build_graph_from_results(
             // Copy properties
             edge.properties = rel.properties;
 
-            graph.add_hyperedge(edge);
+            edges.push_back(std::move(edge));
         }
     }
 
+    Hypergraph graph;
+    graph.add_hyperedges(std::move(edges));
     return graph;
 }
 
@@ -547,7 +719,10 @@ Hypergraph ExtractionPipeline::process_pdfs(const std::vector<std::string>& pdf_
             Hypergraph graph = process_pdf(pdf_paths[i]);
             graphs.push_back(std::move(graph));
         } catch (const std::exception& e) {
-            stats_.documents_failed++;
+            {
+                std::lock_guard<std::mutex> lock(stats_mutex_);
+                stats_.documents_failed++;
+            }
             if (config_.verbose) {
                 std::cerr << "Failed to process " << pdf_paths[i]
                           << ": " << e.what() << "\n";
@@ -602,58 +777,71 @@ Hypergraph ExtractionPipeline::merge_graphs(const std::vector<Hypergraph>& graph
 
         // Apply deduplication if enabled
         if (config_.enable_deduplication) {
-            auto stats = result.compute_statistics();
-            stats_.nodes_before_dedup = stats.num_nodes;
+            int before = static_cast<int>(result.num_nodes());
 
-            // Note: merge_similar_nodes requires embeddings
-            // For now, we skip this step
-            // In future: add embedding generation and call:
-            // result.merge_similar_nodes(config_.similarity_threshold);
+            // Only nodes carrying embeddings take part; the index keeps
+            // this near-linear instead of comparing every pair
+            AnnConfig ann;
+            ann.method = ann_method_from_string(config_.dedup_index);
+            result.merge_similar_nodes(config_.similarity_threshold, ann);
 
-            auto final_stats = result.compute_statistics();
-            stats_.nodes_merged = stats_.nodes_before_dedup - final_stats.num_nodes;
+            std::lock_guard<std::mutex> lock(stats_mutex_);
+            stats_.nodes_before_dedup = before;
+            stats_.nodes_merged = before - static_cast<int>(result.num_nodes());
         }
 
-        auto final_stats = result.compute_statistics();
-        stats_.final_nodes = final_stats.num_nodes;
-        stats_.final_edges = final_stats.num_edges;
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        stats_.final_nodes = static_cast<int>(result.num_nodes());
+        stats_.final_edges = static_cast<int>(result.num_edges());
 
         return result;
     }
 
-    // Merge multiple graphs by adding all edges
+    // Merge multiple graphs, streaming edges through the destination's
+    // signature index so duplicates across documents are dropped on insert
     Hypergraph result;
     for (const auto& g : graphs) {
-        // Get all hyperedges from each graph and add to result
-        auto edges = g.get_all_edges();
-        for (const auto& edge : edges) {
-            result.add_hyperedge(edge);
-        }
+        auto merged = result.merge(g, config_.enable_deduplication);
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        stats_.duplicate_edges_removed += static_cast<int>(merged.duplicate_edges);
+        stats_.self_loops_removed += static_cast<int>(merged.self_loops);
     }
 
     // Apply deduplication
     if (config_.enable_deduplication) {
-        auto stats = result.compute_statistics();
-        stats_.nodes_before_dedup = stats.num_nodes;
+        int before = static_cast<int>(result.num_nodes());
 
-        // Future: add embedding-based deduplication here
+        AnnConfig ann;
+        ann.method = ann_method_from_string(config_.dedup_index);
+        result.merge_similar_nodes(config_.similarity_threshold, ann);
 
-        auto final_stats = result.compute_statistics();
-        stats_.nodes_merged = stats_.nodes_before_dedup - final_stats.num_nodes;
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        stats_.nodes_before_dedup = before;
+        stats_.nodes_merged = before - static_cast<int>(result.num_nodes());
     }
 
-    auto final_stats = result.compute_statistics();
-    stats_.final_nodes = final_stats.num_nodes;
-    stats_.final_edges = final_stats.num_edges;
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    stats_.final_nodes = static_cast<int>(result.num_nodes());
+    stats_.final_edges = static_cast<int>(result.num_edges());
 
     return result;
 }
 
+void ExtractionPipeline::set_llm_provider(std::unique_ptr<LLMProvider> provider) {
+    llm_provider_ = std::move(provider);
+}
+
 void ExtractionPipeline::set_progress_callback(ProgressCallback callback) {
     progress_callback_ = callback;
 }
 
+PipelineStatistics ExtractionPipeline::get_statistics() const {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    return stats_;
+}
+
 void ExtractionPipeline::reset_statistics() {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
     stats_ = PipelineStatistics();
 }
 
@@ -732,14 +920,6 @@ void ExtractionPipeline::save_extraction_results(
     }
 }
 
-void ExtractionPipeline::apply_rate_limit() {
-    if (config_.rate_limit_delay_ms > 0) {
-        std::this_thread::sleep_for(
-            std::chrono::milliseconds(config_.rate_limit_delay_ms)
-        );
-    }
-}
-
 // ============================================================================
 // Utility Functions
 // ============================================================================
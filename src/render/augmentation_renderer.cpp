@@ -41,7 +41,7 @@ bool AugmentationRenderer::nodes_already_connected(const std::string& node_a, co
     if (norm_a == norm_b) return true;  // Same node after normalization
 
     // Get edges incident to node_a
-    auto edges = graph_.get_incident_edges(norm_a);
+    auto edges = graph_.incident_view(norm_a);
     for (const auto& edge : edges) {
         // Check if node_b is in this edge's sources or targets
         for (const auto& src : edge.sources) {
@@ -1191,7 +1191,7 @@ void AugmentationRenderer::export_augmented_html(
     }
 
     // Compute statistics
-    auto stats = graph_.compute_statistics();
+    auto stats = graph_.compute_statistics(StatisticsTier::Cheap);
     int max_degree = static_cast<int>(stats.max_node_degree);
 
     // Calculate optimal minimum degree for initial display
@@ -1206,7 +1206,7 @@ void AugmentationRenderer::export_augmented_html(
     if (num_edges > MAX_INITIAL_EDGES) {
         // Build degree distribution (nodes grouped by degree)
         std::map<int, int> nodes_at_degree;
-        for (const auto& node : graph_.get_all_nodes()) {
+        for (const auto& node : graph_.nodes_view()) {
             nodes_at_degree[node.degree]++;
             if (node.degree > max_degree) max_degree = node.degree;
         }
@@ -1243,7 +1243,7 @@ void AugmentationRenderer::export_augmented_html(
     int idx = 0;
 
     // Add entity nodes
-    for (const auto& node : graph_.get_all_nodes()) {
+    for (const auto& node : graph_.nodes_view()) {
         nlohmann::json n;
         n["id"] = node.id;
         n["label"] = node.label;
@@ -1255,7 +1255,7 @@ void AugmentationRenderer::export_augmented_html(
 
     // Add hyperedge nodes and links
     int edge_idx = 0;
-    for (const auto& edge : graph_.get_all_edges()) {
+    for (const auto& edge : graph_.edges_view()) {
         std::string edge_node_id = "edge_" + std::to_string(edge_idx);
 
         nlohmann::json en;
@@ -0,0 +1,442 @@
+#include "util/json_stream.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace kg {
+
+namespace {
+
+constexpr size_t STREAM_BUFFER_SIZE = 1 << 16;
+
+bool has_gz_suffix(const std::string& path) {
+    return path.size() > 3 && path.compare(path.size() - 3, 3, ".gz") == 0;
+}
+
+/**
+ * @brief istream that owns its stream buffer
+ */
+class OwningInputStream : public std::istream {
+public:
+    explicit OwningInputStream(std::unique_ptr<std::streambuf> buffer)
+        : std::istream(buffer.get()), buffer_(std::move(buffer)) {}
+
+private:
+    std::unique_ptr<std::streambuf> buffer_;
+};
+
+#ifdef HAVE_ZLIB
+
+class GzipOutputBuffer : public std::streambuf {
+public:
+    GzipOutputBuffer(const std::string& path, int level) : buffer_(STREAM_BUFFER_SIZE) {
+        std::string mode = "wb" + std::to_string(std::clamp(level, 1, 9));
+        file_ = gzopen(path.c_str(), mode.c_str());
+        if (!file_) {
+            throw std::runtime_error("Failed to open file for writing: " + path);
+        }
+        gzbuffer(file_, STREAM_BUFFER_SIZE);
+        setp(buffer_.data(), buffer_.data() + buffer_.size());
+    }
+
+    ~GzipOutputBuffer() override { close(); }
+
+    bool close() {
+        if (!file_) return ok_;
+        flush_buffer();
+        ok_ = gzclose(file_) == Z_OK && ok_;
+        file_ = nullptr;
+        return ok_;
+    }
+
+protected:
+    int overflow(int ch) override {
+        if (!flush_buffer()) return traits_type::eof();
+        if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+            *pptr() = traits_type::to_char_type(ch);
+            pbump(1);
+        }
+        return traits_type::not_eof(ch);
+    }
+
+    int sync() override { return flush_buffer() ? 0 : -1; }
+
+private:
+    bool flush_buffer() {
+        auto pending = static_cast<unsigned>(pptr() - pbase());
+        if (pending > 0 && file_ && gzwrite(file_, pbase(), pending) != static_cast<int>(pending)) {
+            ok_ = false;
+        }
+        setp(buffer_.data(), buffer_.data() + buffer_.size());
+        return ok_;
+    }
+
+    gzFile file_ = nullptr;
+    std::vector<char> buffer_;
+    bool ok_ = true;
+};
+
+class GzipInputBuffer : public std::streambuf {
+public:
+    explicit GzipInputBuffer(const std::string& path) : path_(path), buffer_(STREAM_BUFFER_SIZE) {
+        file_ = gzopen(path.c_str(), "rb");
+        if (!file_) {
+            throw std::runtime_error("Failed to open file for reading: " + path);
+        }
+        gzbuffer(file_, STREAM_BUFFER_SIZE);
+    }
+
+    ~GzipInputBuffer() override {
+        if (file_) gzclose(file_);
+    }
+
+protected:
+    int_type underflow() override {
+        if (gptr() < egptr()) return traits_type::to_int_type(*gptr());
+        int n = gzread(file_, buffer_.data(), static_cast<unsigned>(buffer_.size()));
+        if (n < 0) {
+            int code = 0;
+            throw std::runtime_error("Corrupt gzip stream in " + path_ + ": " + gzerror(file_, &code));
+        }
+        if (n == 0) return traits_type::eof();
+        setg(buffer_.data(), buffer_.data(), buffer_.data() + n);
+        return traits_type::to_int_type(*gptr());
+    }
+
+private:
+    std::string path_;
+    gzFile file_ = nullptr;
+    std::vector<char> buffer_;
+};
+
+#endif // HAVE_ZLIB
+
+} // anonymous namespace
+
+// ==========================================
+// JsonWriter
+// ==========================================
+
+JsonWriter::JsonWriter(std::ostream& out, bool compact) : out_(out), compact_(compact) {}
+
+void JsonWriter::newline_indent(size_t depth) {
+    if (compact_) return;
+    static const std::string spaces(64, ' ');
+    out_.put('\n');
+    for (size_t remaining = depth * 2; remaining > 0;) {
+        size_t chunk = std::min(remaining, spaces.size());
+        out_.write(spaces.data(), static_cast<std::streamsize>(chunk));
+        remaining -= chunk;
+    }
+}
+
+void JsonWriter::before_value() {
+    if (stack_.empty()) {
+        if (wrote_root_) throw std::logic_error("JsonWriter: more than one top-level value");
+        wrote_root_ = true;
+        return;
+    }
+
+    Scope& scope = stack_.back();
+    if (scope.is_object) {
+        if (!expecting_value_) throw std::logic_error("JsonWriter: object member written without a key");
+        expecting_value_ = false;
+        return;
+    }
+
+    if (scope.count++ > 0) out_.put(',');
+    newline_indent(stack_.size());
+}
+
+JsonWriter& JsonWriter::key(std::string_view name) {
+    if (stack_.empty() || !stack_.back().is_object || expecting_value_) {
+        throw std::logic_error("JsonWriter: key outside an object");
+    }
+    if (stack_.back().count++ > 0) out_.put(',');
+    newline_indent(stack_.size());
+    write_string(name);
+    out_.write(compact_ ? ":" : ": ", compact_ ? 1 : 2);
+    expecting_value_ = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::begin_object() {
+    before_value();
+    out_.put('{');
+    stack_.push_back({true});
+    return *this;
+}
+
+JsonWriter& JsonWriter::end_object() {
+    if (stack_.empty() || !stack_.back().is_object || expecting_value_) {
+        throw std::logic_error("JsonWriter: unbalanced end_object");
+    }
+    size_t count = stack_.back().count;
+    stack_.pop_back();
+    if (count > 0) newline_indent(stack_.size());
+    out_.put('}');
+    return *this;
+}
+
+JsonWriter& JsonWriter::begin_array() {
+    before_value();
+    out_.put('[');
+    stack_.push_back({false});
+    return *this;
+}
+
+JsonWriter& JsonWriter::end_array() {
+    if (stack_.empty() || stack_.back().is_object) {
+        throw std::logic_error("JsonWriter: unbalanced end_array");
+    }
+    size_t count = stack_.back().count;
+    stack_.pop_back();
+    if (count > 0) newline_indent(stack_.size());
+    out_.put(']');
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(std::string_view text) {
+    before_value();
+    write_string(text);
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(bool flag) {
+    before_value();
+    return flag ? write_raw("true", 4) : write_raw("false", 5);
+}
+
+JsonWriter& JsonWriter::null() {
+    before_value();
+    return write_raw("null", 4);
+}
+
+JsonWriter& JsonWriter::value(double number) {
+    before_value();
+    if (!std::isfinite(number)) return write_raw("null", 4);
+
+    char buffer[32];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer) - 2, number);
+    // Keep the value a float on re-read ("1" would parse as an integer)
+    if (std::find_if(buffer, result.ptr, [](char c) { return c == '.' || c == 'e'; }) == result.ptr) {
+        *result.ptr++ = '.';
+        *result.ptr++ = '0';
+    }
+    return write_raw(buffer, static_cast<size_t>(result.ptr - buffer));
+}
+
+JsonWriter& JsonWriter::value(float number) {
+    before_value();
+    if (!std::isfinite(number)) return write_raw("null", 4);
+
+    char buffer[32];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer) - 2, number);
+    if (std::find_if(buffer, result.ptr, [](char c) { return c == '.' || c == 'e'; }) == result.ptr) {
+        *result.ptr++ = '.';
+        *result.ptr++ = '0';
+    }
+    return write_raw(buffer, static_cast<size_t>(result.ptr - buffer));
+}
+
+JsonWriter& JsonWriter::write_integer(int64_t number) {
+    before_value();
+    char buffer[24];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), number);
+    return write_raw(buffer, static_cast<size_t>(result.ptr - buffer));
+}
+
+JsonWriter& JsonWriter::write_unsigned(uint64_t number) {
+    before_value();
+    char buffer[24];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), number);
+    return write_raw(buffer, static_cast<size_t>(result.ptr - buffer));
+}
+
+JsonWriter& JsonWriter::write_raw(const char* data, size_t size) {
+    out_.write(data, static_cast<std::streamsize>(size));
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(const nlohmann::json& j) {
+    switch (j.type()) {
+        case nlohmann::json::value_t::object:
+            begin_object();
+            for (const auto& [k, v] : j.items()) {
+                key(k);
+                value(v);
+            }
+            return end_object();
+        case nlohmann::json::value_t::array:
+            begin_array();
+            for (const auto& v : j) value(v);
+            return end_array();
+        case nlohmann::json::value_t::string:
+            return value(std::string_view(j.get_ref<const std::string&>()));
+        case nlohmann::json::value_t::boolean:
+            return value(j.get<bool>());
+        case nlohmann::json::value_t::number_integer:
+            return write_integer(j.get<int64_t>());
+        case nlohmann::json::value_t::number_unsigned:
+            return write_unsigned(j.get<uint64_t>());
+        case nlohmann::json::value_t::number_float:
+            return value(j.get<double>());
+        default:
+            return null();
+    }
+}
+
+void JsonWriter::write_string(std::string_view text) {
+    static const char* hex = "0123456789abcdef";
+    static const char replacement[] = "\xEF\xBF\xBD";  // U+FFFD for invalid UTF-8
+
+    out_.put('"');
+    const auto* data = reinterpret_cast<const unsigned char*>(text.data());
+    size_t n = text.size();
+    size_t run = 0;                                    // Start of the pending verbatim run
+
+    auto flush_run = [&](size_t end) {
+        if (end > run) out_.write(text.data() + run, static_cast<std::streamsize>(end - run));
+    };
+
+    size_t i = 0;
+    while (i < n) {
+        unsigned char c = data[i];
+        if (c >= 0x20 && c != '"' && c != '\\' && c < 0x80) {
+            ++i;
+            continue;
+        }
+
+        if (c >= 0x80) {
+            // Validate one UTF-8 sequence; valid ones stay in the verbatim run
+            size_t length = 0;
+            unsigned char lo = 0x80, hi = 0xBF;
+            if (c >= 0xC2 && c <= 0xDF) length = 2;
+            else if (c >= 0xE0 && c <= 0xEF) {
+                length = 3;
+                if (c == 0xE0) lo = 0xA0;
+                if (c == 0xED) hi = 0x9F;
+            } else if (c >= 0xF0 && c <= 0xF4) {
+                length = 4;
+                if (c == 0xF0) lo = 0x90;
+                if (c == 0xF4) hi = 0x8F;
+            }
+
+            bool valid = length > 0 && i + length <= n;
+            for (size_t k = 1; valid && k < length; ++k) {
+                unsigned char b = data[i + k];
+                valid = k == 1 ? (b >= lo && b <= hi) : (b >= 0x80 && b <= 0xBF);
+            }
+            if (valid) {
+                i += length;
+                continue;
+            }
+            flush_run(i);
+            out_.write(replacement, 3);
+            run = ++i;
+            continue;
+        }
+
+        flush_run(i);
+        switch (c) {
+            case '"': out_.write("\\\"", 2); break;
+            case '\\': out_.write("\\\\", 2); break;
+            case '\b': out_.write("\\b", 2); break;
+            case '\f': out_.write("\\f", 2); break;
+            case '\n': out_.write("\\n", 2); break;
+            case '\r': out_.write("\\r", 2); break;
+            case '\t': out_.write("\\t", 2); break;
+            default: {
+                char escape[6] = {'\\', 'u', '0', '0', hex[c >> 4], hex[c & 0xF]};
+                out_.write(escape, 6);
+            }
+        }
+        run = ++i;
+    }
+    flush_run(n);
+    out_.put('"');
+}
+
+// ==========================================
+// Files
+// ==========================================
+
+JsonOutputFile::JsonOutputFile(const std::string& path, const JsonWriteOptions& options) : path_(path) {
+    if (options.gzip || has_gz_suffix(path)) {
+#ifdef HAVE_ZLIB
+        buffer_ = std::make_unique<GzipOutputBuffer>(path, options.gzip_level);
+#else
+        throw std::runtime_error("gzip output requested but this build has no zlib: " + path);
+#endif
+    } else {
+        auto file = std::make_unique<std::filebuf>();
+        if (!file->open(path, std::ios::out | std::ios::binary | std::ios::trunc)) {
+            throw std::runtime_error("Failed to open file for writing: " + path);
+        }
+        buffer_ = std::move(file);
+    }
+    stream_ = std::make_unique<std::ostream>(buffer_.get());
+}
+
+JsonOutputFile::~JsonOutputFile() {
+    if (buffer_) {
+        try {
+            close();
+        } catch (...) {
+            // Destructors cannot report; callers that care call close()
+        }
+    }
+}
+
+void JsonOutputFile::close() {
+    if (!buffer_) return;
+    stream_->flush();
+    bool ok = stream_->good();
+
+#ifdef HAVE_ZLIB
+    if (auto* gzip = dynamic_cast<GzipOutputBuffer*>(buffer_.get())) {
+        ok = gzip->close() && ok;
+    }
+#endif
+    if (auto* file = dynamic_cast<std::filebuf*>(buffer_.get())) {
+        ok = file->close() != nullptr && ok;
+    }
+
+    stream_.reset();
+    buffer_.reset();
+    if (!ok) {
+        throw std::runtime_error("Failed to write file: " + path_);
+    }
+}
+
+bool is_gzip_file(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    unsigned char magic[2] = {};
+    file.read(reinterpret_cast<char*>(magic), 2);
+    return file.gcount() == 2 && magic[0] == 0x1f && magic[1] == 0x8b;
+}
+
+std::unique_ptr<std::istream> open_json_input(const std::string& path) {
+    if (is_gzip_file(path)) {
+#ifdef HAVE_ZLIB
+        return std::make_unique<OwningInputStream>(std::make_unique<GzipInputBuffer>(path));
+#else
+        throw std::runtime_error("gzip input but this build has no zlib: " + path);
+#endif
+    }
+
+    auto file = std::make_unique<std::filebuf>();
+    if (!file->open(path, std::ios::in | std::ios::binary)) {
+        throw std::runtime_error("Failed to open file for reading: " + path);
+    }
+    return std::make_unique<OwningInputStream>(std::move(file));
+}
+
+} // namespace kg
@@ -0,0 +1,264 @@
+#include "util/section_file.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace kg {
+
+namespace {
+
+constexpr uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint32_t num_sections;
+    uint32_t reserved;
+};
+
+struct SectionEntry {
+    uint32_t id;
+    uint32_t reserved;
+    uint64_t offset;
+    uint64_t size;                                     // Bytes
+};
+
+constexpr uint64_t align8(uint64_t value) {
+    return (value + 7) & ~uint64_t(7);
+}
+
+} // anonymous namespace
+
+// ==========================================
+// MappedFile
+// ==========================================
+
+MappedFile::MappedFile(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open file for reading: " + path);
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Failed to stat file: " + path);
+    }
+    size_ = static_cast<size_t>(info.st_size);
+    if (size_ == 0) {
+        ::close(fd);
+        return;
+    }
+
+    void* data = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED) {
+        throw std::runtime_error("Failed to map file: " + path);
+    }
+    data_ = static_cast<const char*>(data);
+}
+
+MappedFile::~MappedFile() {
+    if (data_) munmap(const_cast<char*>(data_), size_);
+}
+
+// ==========================================
+// SectionFile
+// ==========================================
+
+SectionFile::SectionFile(const std::string& path, const Magic& magic, uint32_t version, const char* kind)
+    : mapping_(std::make_shared<MappedFile>(path)), kind_(kind) {
+    if (mapping_->size() < sizeof(FileHeader)) {
+        throw std::runtime_error("Not a " + kind_ + " (too short): " + path);
+    }
+
+    FileHeader header;
+    std::memcpy(&header, mapping_->data(), sizeof(header));
+    if (std::memcmp(header.magic, magic, sizeof(header.magic)) != 0) {
+        throw std::runtime_error("Not a " + kind_ + ": " + path);
+    }
+    if (header.byte_order != BYTE_ORDER_MARK) {
+        throw std::runtime_error(kind_ + " was written with a different byte order: " + path);
+    }
+    if (header.version != version) {
+        throw std::runtime_error("Unsupported " + kind_ + " version " +
+                                 std::to_string(header.version) + ": " + path);
+    }
+    if (sizeof(FileHeader) + uint64_t(header.num_sections) * sizeof(SectionEntry) > mapping_->size()) {
+        corrupt("table of contents is truncated");
+    }
+
+    const char* toc = mapping_->data() + sizeof(FileHeader);
+    for (uint32_t i = 0; i < header.num_sections; ++i) {
+        SectionEntry entry;
+        std::memcpy(&entry, toc + i * sizeof(SectionEntry), sizeof(entry));
+        if (entry.offset > mapping_->size() || entry.size > mapping_->size() - entry.offset) {
+            corrupt("section " + std::to_string(entry.id) + " is out of bounds");
+        }
+        sections_[entry.id] = {entry.offset, entry.size};
+    }
+}
+
+bool SectionFile::has_magic(const std::string& path, const Magic& magic) {
+    std::ifstream file(path, std::ios::binary);
+    char head[sizeof(Magic)] = {};
+    file.read(head, sizeof(head));
+    return file.gcount() == sizeof(head) && std::memcmp(head, magic, sizeof(head)) == 0;
+}
+
+bool SectionFile::has_section(uint32_t id) const {
+    return sections_.count(id) > 0;
+}
+
+std::pair<const char*, size_t> SectionFile::raw_section(uint32_t id, size_t alignment,
+                                                        size_t element_size) const {
+    auto it = sections_.find(id);
+    if (it == sections_.end()) {
+        corrupt("missing section " + std::to_string(id));
+    }
+    const Entry& entry = it->second;
+    if (entry.offset % alignment != 0 || entry.size % element_size != 0) {
+        corrupt("section " + std::to_string(id) + " is misaligned");
+    }
+    return {mapping_->data() + entry.offset, static_cast<size_t>(entry.size)};
+}
+
+void SectionFile::corrupt(const std::string& what) const {
+    throw std::runtime_error("Corrupt " + kind_ + ": " + what);
+}
+
+void SectionFile::count_mismatch(uint32_t id, size_t actual, size_t expected) const {
+    corrupt("section " + std::to_string(id) + " has " + std::to_string(actual) +
+            " entries, expected " + std::to_string(expected));
+}
+
+// ==========================================
+// SectionFileWriter
+// ==========================================
+
+void SectionFileWriter::add_bytes(uint32_t id, const void* data, size_t size) {
+    sections_.push_back({id, static_cast<const char*>(data), size});
+}
+
+void SectionFileWriter::write(const std::string& path, const SectionFile::Magic& magic,
+                              uint32_t version) const {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open file for writing: " + path);
+    }
+
+    FileHeader header{};
+    std::memcpy(header.magic, magic, sizeof(header.magic));
+    header.version = version;
+    header.byte_order = BYTE_ORDER_MARK;
+    header.num_sections = static_cast<uint32_t>(sections_.size());
+
+    std::vector<SectionEntry> toc;
+    uint64_t offset = align8(sizeof(FileHeader) + sections_.size() * sizeof(SectionEntry));
+    for (const auto& section : sections_) {
+        toc.push_back({section.id, 0, offset, section.size});
+        offset = align8(offset + section.size);
+    }
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(toc.data()),
+               static_cast<std::streamsize>(toc.size() * sizeof(SectionEntry)));
+
+    static const char padding[8] = {};
+    uint64_t written = sizeof(FileHeader) + toc.size() * sizeof(SectionEntry);
+    for (size_t i = 0; i < sections_.size(); ++i) {
+        file.write(padding, static_cast<std::streamsize>(toc[i].offset - written));
+        file.write(sections_[i].data, static_cast<std::streamsize>(sections_[i].size));
+        written = toc[i].offset + sections_[i].size;
+    }
+    file.write(padding, static_cast<std::streamsize>(align8(written) - written));
+
+    if (!file) {
+        throw std::runtime_error("Failed to write file: " + path);
+    }
+}
+
+// ==========================================
+// String tables
+// ==========================================
+
+StringTableBuilder::StringTableBuilder() {
+    intern(std::string());
+}
+
+uint32_t StringTableBuilder::intern(const std::string& value) {
+    // Look up before inserting: emplace would allocate a node for every repeat
+    auto it = index_.find(value);
+    if (it != index_.end()) return it->second;
+
+    uint32_t index = static_cast<uint32_t>(offsets_.size() - 1);
+    index_.emplace(value, index);
+    data_.insert(data_.end(), value.begin(), value.end());
+    offsets_.push_back(data_.size());
+    return index;
+}
+
+std::vector<uint32_t> StringTableBuilder::sort() {
+    size_t count = size();
+    auto view = [&](uint32_t i) {
+        return std::string_view(data_.data() + offsets_[i], offsets_[i + 1] - offsets_[i]);
+    };
+
+    std::vector<uint32_t> order(count);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return view(a) < view(b); });
+
+    std::vector<uint32_t> remap(count);
+    std::vector<uint64_t> offsets{0};
+    std::vector<char> data;
+    offsets.reserve(count + 1);
+    data.reserve(data_.size());
+    for (uint32_t rank = 0; rank < count; ++rank) {
+        auto text = view(order[rank]);
+        data.insert(data.end(), text.begin(), text.end());
+        offsets.push_back(data.size());
+        remap[order[rank]] = rank;
+    }
+    for (auto& [text, index] : index_) index = remap[index];
+
+    offsets_ = std::move(offsets);
+    data_ = std::move(data);
+    return remap;
+}
+
+uint32_t StringTableView::find(std::string_view value) const {
+    size_t lo = 0, hi = size();
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if ((*this)[static_cast<uint32_t>(mid)] < value) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if (lo < size() && (*this)[static_cast<uint32_t>(lo)] == value) {
+        return static_cast<uint32_t>(lo);
+    }
+    return static_cast<uint32_t>(size());
+}
+
+void StringTableView::validate(const SectionFile& file) const {
+    if (offsets.empty() || offsets[0] != 0 || offsets[offsets.size - 1] != data.size) {
+        file.corrupt("string offsets do not span their data");
+    }
+    for (size_t i = 0; i + 1 < offsets.size; ++i) {
+        if (offsets[i] > offsets[i + 1]) {
+            file.corrupt("string offsets are not monotonic");
+        }
+    }
+}
+
+} // namespace kg
@@ -0,0 +1,672 @@
+#include "util/vector_math.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <stdexcept>
+#include <vector>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define KG_VEC_X86 1
+#include <immintrin.h>
+#endif
+
+namespace kg {
+namespace vec {
+
+namespace {
+
+/**
+ * Per-ISA kernel table. Only the primitive reductions and updates are
+ * specialised; batched variants are built on top of these in one place.
+ */
+struct Kernels {
+    Isa isa;
+    float (*dot)(const float*, const float*, size_t);
+    void (*cosine_parts)(const float*, const float*, size_t, float&, float&, float&);
+    float (*l1)(const float*, const float*, size_t);
+    float (*l2_squared)(const float*, const float*, size_t);
+    void (*axpy)(float, const float*, float*, size_t);
+    void (*scale)(float, float*, size_t);
+};
+
+// ==========================================
+// Scalar fallback
+// ==========================================
+
+// Four independent accumulators so the compiler can pipeline the adds
+// without reassociating (which it may not do for floats on its own).
+
+float dot_scalar(const float* a, const float* b, size_t n) {
+    float s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        s0 += a[i] * b[i];
+        s1 += a[i + 1] * b[i + 1];
+        s2 += a[i + 2] * b[i + 2];
+        s3 += a[i + 3] * b[i + 3];
+    }
+    for (; i < n; ++i) s0 += a[i] * b[i];
+    return (s0 + s1) + (s2 + s3);
+}
+
+void cosine_parts_scalar(const float* a, const float* b, size_t n,
+                         float& ab, float& aa, float& bb) {
+    float sab = 0, saa = 0, sbb = 0;
+    for (size_t i = 0; i < n; ++i) {
+        sab += a[i] * b[i];
+        saa += a[i] * a[i];
+        sbb += b[i] * b[i];
+    }
+    ab = sab;
+    aa = saa;
+    bb = sbb;
+}
+
+float l1_scalar(const float* a, const float* b, size_t n) {
+    float s = 0;
+    for (size_t i = 0; i < n; ++i) s += std::fabs(a[i] - b[i]);
+    return s;
+}
+
+float l2_squared_scalar(const float* a, const float* b, size_t n) {
+    float s0 = 0, s1 = 0;
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        float d0 = a[i] - b[i];
+        float d1 = a[i + 1] - b[i + 1];
+        s0 += d0 * d0;
+        s1 += d1 * d1;
+    }
+    for (; i < n; ++i) {
+        float d = a[i] - b[i];
+        s0 += d * d;
+    }
+    return s0 + s1;
+}
+
+void axpy_scalar(float alpha, const float* x, float* y, size_t n) {
+    for (size_t i = 0; i < n; ++i) y[i] += alpha * x[i];
+}
+
+void scale_scalar(float alpha, float* a, size_t n) {
+    for (size_t i = 0; i < n; ++i) a[i] *= alpha;
+}
+
+constexpr Kernels kScalar = {
+    Isa::Scalar, dot_scalar, cosine_parts_scalar, l1_scalar,
+    l2_squared_scalar, axpy_scalar, scale_scalar
+};
+
+#ifdef KG_VEC_X86
+
+// ==========================================
+// SSE2
+// ==========================================
+
+__attribute__((target("sse2")))
+inline float hsum128(__m128 v) {
+    __m128 shuf = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1));
+    __m128 sums = _mm_add_ps(v, shuf);
+    shuf = _mm_movehl_ps(shuf, sums);
+    sums = _mm_add_ss(sums, shuf);
+    return _mm_cvtss_f32(sums);
+}
+
+__attribute__((target("sse2")))
+float dot_sse(const float* a, const float* b, size_t n) {
+    __m128 acc0 = _mm_setzero_ps(), acc1 = _mm_setzero_ps();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+        acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(a + i + 4), _mm_loadu_ps(b + i + 4)));
+    }
+    for (; i + 4 <= n; i += 4) {
+        acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+    }
+    float s = hsum128(_mm_add_ps(acc0, acc1));
+    for (; i < n; ++i) s += a[i] * b[i];
+    return s;
+}
+
+__attribute__((target("sse2")))
+void cosine_parts_sse(const float* a, const float* b, size_t n,
+                      float& ab, float& aa, float& bb) {
+    __m128 sab = _mm_setzero_ps(), saa = _mm_setzero_ps(), sbb = _mm_setzero_ps();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 va = _mm_loadu_ps(a + i);
+        __m128 vb = _mm_loadu_ps(b + i);
+        sab = _mm_add_ps(sab, _mm_mul_ps(va, vb));
+        saa = _mm_add_ps(saa, _mm_mul_ps(va, va));
+        sbb = _mm_add_ps(sbb, _mm_mul_ps(vb, vb));
+    }
+    ab = hsum128(sab);
+    aa = hsum128(saa);
+    bb = hsum128(sbb);
+    for (; i < n; ++i) {
+        ab += a[i] * b[i];
+        aa += a[i] * a[i];
+        bb += b[i] * b[i];
+    }
+}
+
+__attribute__((target("sse2")))
+float l1_sse(const float* a, const float* b, size_t n) {
+    const __m128 sign = _mm_set1_ps(-0.0f);
+    __m128 acc = _mm_setzero_ps();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 d = _mm_sub_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i));
+        acc = _mm_add_ps(acc, _mm_andnot_ps(sign, d));
+    }
+    float s = hsum128(acc);
+    for (; i < n; ++i) s += std::fabs(a[i] - b[i]);
+    return s;
+}
+
+__attribute__((target("sse2")))
+float l2_squared_sse(const float* a, const float* b, size_t n) {
+    __m128 acc = _mm_setzero_ps();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 d = _mm_sub_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i));
+        acc = _mm_add_ps(acc, _mm_mul_ps(d, d));
+    }
+    float s = hsum128(acc);
+    for (; i < n; ++i) {
+        float d = a[i] - b[i];
+        s += d * d;
+    }
+    return s;
+}
+
+__attribute__((target("sse2")))
+void axpy_sse(float alpha, const float* x, float* y, size_t n) {
+    __m128 va = _mm_set1_ps(alpha);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        _mm_storeu_ps(y + i, _mm_add_ps(_mm_loadu_ps(y + i), _mm_mul_ps(va, _mm_loadu_ps(x + i))));
+    }
+    for (; i < n; ++i) y[i] += alpha * x[i];
+}
+
+__attribute__((target("sse2")))
+void scale_sse(float alpha, float* a, size_t n) {
+    __m128 va = _mm_set1_ps(alpha);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        _mm_storeu_ps(a + i, _mm_mul_ps(va, _mm_loadu_ps(a + i)));
+    }
+    for (; i < n; ++i) a[i] *= alpha;
+}
+
+constexpr Kernels kSse = {
+    Isa::SSE, dot_sse, cosine_parts_sse, l1_sse, l2_squared_sse, axpy_sse, scale_sse
+};
+
+// ==========================================
+// AVX2 + FMA
+// ==========================================
+
+__attribute__((target("avx2,fma")))
+inline float hsum256(__m256 v) {
+    __m128 lo = _mm256_castps256_ps128(v);
+    __m128 hi = _mm256_extractf128_ps(v, 1);
+    return hsum128(_mm_add_ps(lo, hi));
+}
+
+__attribute__((target("avx2,fma")))
+float dot_avx2(const float* a, const float* b, size_t n) {
+    __m256 acc0 = _mm256_setzero_ps(), acc1 = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), acc0);
+        acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8), acc1);
+    }
+    for (; i + 8 <= n; i += 8) {
+        acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), acc0);
+    }
+    float s = hsum256(_mm256_add_ps(acc0, acc1));
+    for (; i < n; ++i) s += a[i] * b[i];
+    return s;
+}
+
+__attribute__((target("avx2,fma")))
+void cosine_parts_avx2(const float* a, const float* b, size_t n,
+                       float& ab, float& aa, float& bb) {
+    __m256 sab = _mm256_setzero_ps(), saa = _mm256_setzero_ps(), sbb = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 va = _mm256_loadu_ps(a + i);
+        __m256 vb = _mm256_loadu_ps(b + i);
+        sab = _mm256_fmadd_ps(va, vb, sab);
+        saa = _mm256_fmadd_ps(va, va, saa);
+        sbb = _mm256_fmadd_ps(vb, vb, sbb);
+    }
+    ab = hsum256(sab);
+    aa = hsum256(saa);
+    bb = hsum256(sbb);
+    for (; i < n; ++i) {
+        ab += a[i] * b[i];
+        aa += a[i] * a[i];
+        bb += b[i] * b[i];
+    }
+}
+
+__attribute__((target("avx2,fma")))
+float l1_avx2(const float* a, const float* b, size_t n) {
+    const __m256 sign = _mm256_set1_ps(-0.0f);
+    __m256 acc = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 d = _mm256_sub_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i));
+        acc = _mm256_add_ps(acc, _mm256_andnot_ps(sign, d));
+    }
+    float s = hsum256(acc);
+    for (; i < n; ++i) s += std::fabs(a[i] - b[i]);
+    return s;
+}
+
+__attribute__((target("avx2,fma")))
+float l2_squared_avx2(const float* a, const float* b, size_t n) {
+    __m256 acc0 = _mm256_setzero_ps(), acc1 = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256 d0 = _mm256_sub_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i));
+        __m256 d1 = _mm256_sub_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8));
+        acc0 = _mm256_fmadd_ps(d0, d0, acc0);
+        acc1 = _mm256_fmadd_ps(d1, d1, acc1);
+    }
+    for (; i + 8 <= n; i += 8) {
+        __m256 d = _mm256_sub_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i));
+        acc0 = _mm256_fmadd_ps(d, d, acc0);
+    }
+    float s = hsum256(_mm256_add_ps(acc0, acc1));
+    for (; i < n; ++i) {
+        float d = a[i] - b[i];
+        s += d * d;
+    }
+    return s;
+}
+
+__attribute__((target("avx2,fma")))
+void axpy_avx2(float alpha, const float* x, float* y, size_t n) {
+    __m256 va = _mm256_set1_ps(alpha);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        _mm256_storeu_ps(y + i, _mm256_fmadd_ps(va, _mm256_loadu_ps(x + i), _mm256_loadu_ps(y + i)));
+    }
+    for (; i < n; ++i) y[i] += alpha * x[i];
+}
+
+__attribute__((target("avx2,fma")))
+void scale_avx2(float alpha, float* a, size_t n) {
+    __m256 va = _mm256_set1_ps(alpha);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        _mm256_storeu_ps(a + i, _mm256_mul_ps(va, _mm256_loadu_ps(a + i)));
+    }
+    for (; i < n; ++i) a[i] *= alpha;
+}
+
+constexpr Kernels kAvx2 = {
+    Isa::AVX2, dot_avx2, cosine_parts_avx2, l1_avx2, l2_squared_avx2, axpy_avx2, scale_avx2
+};
+
+// ==========================================
+// AVX-512F
+// ==========================================
+
+// Tails use masked loads, so there is no scalar remainder loop.
+
+// Reduce through memory rather than _mm512_reduce_add_ps, whose GCC 12
+// expansion trips -Wuninitialized on its internal undefined vectors
+__attribute__((target("avx512f,avx2,fma")))
+inline float hsum512(__m512 v) {
+    alignas(64) float lanes[16];
+    _mm512_store_ps(lanes, v);
+    return hsum256(_mm256_add_ps(_mm256_load_ps(lanes), _mm256_load_ps(lanes + 8)));
+}
+
+__attribute__((target("avx512f,avx2,fma")))
+inline __mmask16 tail_mask(size_t remaining) {
+    return static_cast<__mmask16>((1u << remaining) - 1u);
+}
+
+__attribute__((target("avx512f,avx2,fma")))
+float dot_avx512(const float* a, const float* b, size_t n) {
+    __m512 acc0 = _mm512_setzero_ps(), acc1 = _mm512_setzero_ps();
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        acc0 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i), acc0);
+        acc1 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i + 16), _mm512_loadu_ps(b + i + 16), acc1);
+    }
+    for (; i + 16 <= n; i += 16) {
+        acc0 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i), acc0);
+    }
+    if (i < n) {
+        __mmask16 m = tail_mask(n - i);
+        acc1 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(m, a + i), _mm512_maskz_loadu_ps(m, b + i), acc1);
+    }
+    return hsum512(_mm512_add_ps(acc0, acc1));
+}
+
+__attribute__((target("avx512f,avx2,fma")))
+void cosine_parts_avx512(const float* a, const float* b, size_t n,
+                         float& ab, float& aa, float& bb) {
+    __m512 sab = _mm512_setzero_ps(), saa = _mm512_setzero_ps(), sbb = _mm512_setzero_ps();
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m512 va = _mm512_loadu_ps(a + i);
+        __m512 vb = _mm512_loadu_ps(b + i);
+        sab = _mm512_fmadd_ps(va, vb, sab);
+        saa = _mm512_fmadd_ps(va, va, saa);
+        sbb = _mm512_fmadd_ps(vb, vb, sbb);
+    }
+    if (i < n) {
+        __mmask16 m = tail_mask(n - i);
+        __m512 va = _mm512_maskz_loadu_ps(m, a + i);
+        __m512 vb = _mm512_maskz_loadu_ps(m, b + i);
+        sab = _mm512_fmadd_ps(va, vb, sab);
+        saa = _mm512_fmadd_ps(va, va, saa);
+        sbb = _mm512_fmadd_ps(vb, vb, sbb);
+    }
+    ab = hsum512(sab);
+    aa = hsum512(saa);
+    bb = hsum512(sbb);
+}
+
+__attribute__((target("avx512f,avx2,fma")))
+float l1_avx512(const float* a, const float* b, size_t n) {
+    __m512 acc = _mm512_setzero_ps();
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m512 d = _mm512_sub_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i));
+        acc = _mm512_add_ps(acc, _mm512_abs_ps(d));
+    }
+    if (i < n) {
+        __mmask16 m = tail_mask(n - i);
+        __m512 d = _mm512_sub_ps(_mm512_maskz_loadu_ps(m, a + i), _mm512_maskz_loadu_ps(m, b + i));
+        acc = _mm512_add_ps(acc, _mm512_abs_ps(d));
+    }
+    return hsum512(acc);
+}
+
+__attribute__((target("avx512f,avx2,fma")))
+float l2_squared_avx512(const float* a, const float* b, size_t n) {
+    __m512 acc0 = _mm512_setzero_ps(), acc1 = _mm512_setzero_ps();
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m512 d0 = _mm512_sub_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i));
+        __m512 d1 = _mm512_sub_ps(_mm512_loadu_ps(a + i + 16), _mm512_loadu_ps(b + i + 16));
+        acc0 = _mm512_fmadd_ps(d0, d0, acc0);
+        acc1 = _mm512_fmadd_ps(d1, d1, acc1);
+    }
+    for (; i + 16 <= n; i += 16) {
+        __m512 d = _mm512_sub_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i));
+        acc0 = _mm512_fmadd_ps(d, d, acc0);
+    }
+    if (i < n) {
+        __mmask16 m = tail_mask(n - i);
+        __m512 d = _mm512_sub_ps(_mm512_maskz_loadu_ps(m, a + i), _mm512_maskz_loadu_ps(m, b + i));
+        acc1 = _mm512_fmadd_ps(d, d, acc1);
+    }
+    return hsum512(_mm512_add_ps(acc0, acc1));
+}
+
+__attribute__((target("avx512f,avx2,fma")))
+void axpy_avx512(float alpha, const float* x, float* y, size_t n) {
+    __m512 va = _mm512_set1_ps(alpha);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        _mm512_storeu_ps(y + i, _mm512_fmadd_ps(va, _mm512_loadu_ps(x + i), _mm512_loadu_ps(y + i)));
+    }
+    if (i < n) {
+        __mmask16 m = tail_mask(n - i);
+        __m512 r = _mm512_fmadd_ps(va, _mm512_maskz_loadu_ps(m, x + i), _mm512_maskz_loadu_ps(m, y + i));
+        _mm512_mask_storeu_ps(y + i, m, r);
+    }
+}
+
+__attribute__((target("avx512f,avx2,fma")))
+void scale_avx512(float alpha, float* a, size_t n) {
+    __m512 va = _mm512_set1_ps(alpha);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        _mm512_storeu_ps(a + i, _mm512_mul_ps(va, _mm512_loadu_ps(a + i)));
+    }
+    if (i < n) {
+        __mmask16 m = tail_mask(n - i);
+        _mm512_mask_storeu_ps(a + i, m, _mm512_mul_ps(va, _mm512_maskz_loadu_ps(m, a + i)));
+    }
+}
+
+constexpr Kernels kAvx512 = {
+    Isa::AVX512, dot_avx512, cosine_parts_avx512, l1_avx512, l2_squared_avx512,
+    axpy_avx512, scale_avx512
+};
+
+#endif // KG_VEC_X86
+
+// ==========================================
+// Dispatch
+// ==========================================
+
+bool cpu_supports(Isa isa) {
+    switch (isa) {
+        case Isa::Scalar:
+            return true;
+#ifdef KG_VEC_X86
+        case Isa::SSE:
+            return __builtin_cpu_supports("sse2");
+        case Isa::AVX2:
+            return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+        case Isa::AVX512:
+            return __builtin_cpu_supports("avx512f");
+#endif
+        default:
+            return false;
+    }
+}
+
+const Kernels* kernels_for(Isa isa) {
+    switch (isa) {
+#ifdef KG_VEC_X86
+        case Isa::SSE: return &kSse;
+        case Isa::AVX2: return &kAvx2;
+        case Isa::AVX512: return &kAvx512;
+#endif
+        default: return &kScalar;
+    }
+}
+
+const Kernels* initial_kernels() {
+    Isa isa = detected_isa();
+    if (const char* env = std::getenv("KG_SIMD")) {
+        std::string name(env);
+        for (Isa candidate : {Isa::Scalar, Isa::SSE, Isa::AVX2, Isa::AVX512}) {
+            if (name == isa_name(candidate) && cpu_supports(candidate)) {
+                isa = candidate;
+            }
+        }
+    }
+    return kernels_for(isa);
+}
+
+std::atomic<const Kernels*>& active_kernels() {
+    static std::atomic<const Kernels*> kernels{initial_kernels()};
+    return kernels;
+}
+
+inline const Kernels& k() {
+    return *active_kernels().load(std::memory_order_relaxed);
+}
+
+inline float cosine_from_parts(float ab, float aa, float bb) {
+    if (aa <= 0.0f || bb <= 0.0f) return 0.0f;
+    return ab / std::sqrt(aa * bb);
+}
+
+// Rows of b processed per tile in the many-vs-many kernels, sized so a
+// tile of 256-float rows stays within L2 while every row of a streams past
+constexpr size_t kTileRows = 64;
+
+} // anonymous namespace
+
+std::string isa_name(Isa isa) {
+    switch (isa) {
+        case Isa::Scalar: return "scalar";
+        case Isa::SSE: return "sse";
+        case Isa::AVX2: return "avx2";
+        case Isa::AVX512: return "avx512";
+    }
+    return "unknown";
+}
+
+Isa detected_isa() {
+    for (Isa isa : {Isa::AVX512, Isa::AVX2, Isa::SSE}) {
+        if (cpu_supports(isa)) return isa;
+    }
+    return Isa::Scalar;
+}
+
+Isa active_isa() {
+    return k().isa;
+}
+
+void set_isa(Isa isa) {
+    if (!cpu_supports(isa)) {
+        throw std::invalid_argument("Instruction set not supported on this CPU: " + isa_name(isa));
+    }
+    active_kernels().store(kernels_for(isa), std::memory_order_relaxed);
+}
+
+// ==========================================
+// One-vs-one
+// ==========================================
+
+float dot(const float* a, const float* b, size_t n) {
+    return k().dot(a, b, n);
+}
+
+float cosine(const float* a, const float* b, size_t n) {
+    float ab, aa, bb;
+    k().cosine_parts(a, b, n, ab, aa, bb);
+    return cosine_from_parts(ab, aa, bb);
+}
+
+float l1_distance(const float* a, const float* b, size_t n) {
+    return k().l1(a, b, n);
+}
+
+float l2_squared(const float* a, const float* b, size_t n) {
+    return k().l2_squared(a, b, n);
+}
+
+float l2_distance(const float* a, const float* b, size_t n) {
+    return std::sqrt(k().l2_squared(a, b, n));
+}
+
+float norm(const float* a, size_t n) {
+    return std::sqrt(k().dot(a, a, n));
+}
+
+void axpy(float alpha, const float* x, float* y, size_t n) {
+    k().axpy(alpha, x, y, n);
+}
+
+float normalize(float* a, size_t n, float min_norm) {
+    const Kernels& kernels = k();
+    float length = std::sqrt(kernels.dot(a, a, n));
+    if (length > min_norm && length > 0.0f) {
+        kernels.scale(1.0f / length, a, n);
+    }
+    return length;
+}
+
+// ==========================================
+// One-vs-many
+// ==========================================
+
+void dot_many(const float* query, const float* rows, size_t count, size_t n, float* out) {
+    const Kernels& kernels = k();
+    for (size_t r = 0; r < count; ++r) {
+        out[r] = kernels.dot(query, rows + r * n, n);
+    }
+}
+
+void cosine_many(const float* query, const float* rows, size_t count, size_t n, float* out) {
+    const Kernels& kernels = k();
+    float qq = kernels.dot(query, query, n);
+    for (size_t r = 0; r < count; ++r) {
+        const float* row = rows + r * n;
+        out[r] = cosine_from_parts(kernels.dot(query, row, n), qq, kernels.dot(row, row, n));
+    }
+}
+
+void l1_distance_many(const float* query, const float* rows, size_t count, size_t n, float* out) {
+    const Kernels& kernels = k();
+    for (size_t r = 0; r < count; ++r) {
+        out[r] = kernels.l1(query, rows + r * n, n);
+    }
+}
+
+void l2_squared_many(const float* query, const float* rows, size_t count, size_t n, float* out) {
+    const Kernels& kernels = k();
+    for (size_t r = 0; r < count; ++r) {
+        out[r] = kernels.l2_squared(query, rows + r * n, n);
+    }
+}
+
+// ==========================================
+// Many-vs-many
+// ==========================================
+
+namespace {
+
+template <typename Kernel>
+void tiled_matrix(const float* a, size_t a_count, const float* b, size_t b_count,
+                  size_t n, float* out, Kernel kernel) {
+    for (size_t tile = 0; tile < b_count; tile += kTileRows) {
+        size_t tile_end = std::min(tile + kTileRows, b_count);
+        for (size_t i = 0; i < a_count; ++i) {
+            const float* row = a + i * n;
+            float* dst = out + i * b_count;
+            for (size_t j = tile; j < tile_end; ++j) {
+                dst[j] = kernel(row, b + j * n, n);
+            }
+        }
+    }
+}
+
+} // anonymous namespace
+
+void dot_matrix(const float* a, size_t a_count, const float* b, size_t b_count,
+                size_t n, float* out) {
+    tiled_matrix(a, a_count, b, b_count, n, out, k().dot);
+}
+
+void cosine_matrix(const float* a, size_t a_count, const float* b, size_t b_count,
+                   size_t n, float* out) {
+    const Kernels& kernels = k();
+    std::vector<float> a_norms(a_count), b_norms(b_count);
+    for (size_t i = 0; i < a_count; ++i) a_norms[i] = kernels.dot(a + i * n, a + i * n, n);
+    for (size_t j = 0; j < b_count; ++j) b_norms[j] = kernels.dot(b + j * n, b + j * n, n);
+
+    tiled_matrix(a, a_count, b, b_count, n, out, kernels.dot);
+    for (size_t i = 0; i < a_count; ++i) {
+        for (size_t j = 0; j < b_count; ++j) {
+            float& cell = out[i * b_count + j];
+            cell = cosine_from_parts(cell, a_norms[i], b_norms[j]);
+        }
+    }
+}
+
+void l2_squared_matrix(const float* a, size_t a_count, const float* b, size_t b_count,
+                       size_t n, float* out) {
+    tiled_matrix(a, a_count, b, b_count, n, out, k().l2_squared);
+}
+
+} // namespace vec
+} // namespace kg
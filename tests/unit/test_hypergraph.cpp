@@ -1,5 +1,30 @@
 #include <gtest/gtest.h>
 #include "graph/hypergraph.hpp"
+#include "graph/graph_snapshot.hpp"
+#include "index/hypergraph_index.hpp"
+#include "llm/llm_provider.hpp"
+#include "pipeline/extraction_journal.hpp"
+#include "pipeline/extraction_pipeline.hpp"
+#include "util/vector_math.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <chrono>
+#include <random>
+#include <set>
+#include <sstream>
+#include <tuple>
+#include <thread>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
 
 using namespace kg;
 
@@ -110,6 +135,217 @@ TEST_F(HypergraphTest, KShortestPaths) {
     }
 }
 
+TEST(PathSearchTest, KShortestPathsAreDistinctAndOrdered) {
+    Hypergraph graph;
+    graph.add_hyperedge({"origin"}, "r", {"m1"});
+    graph.add_hyperedge({"m1"}, "r", {"goal"});
+    graph.add_hyperedge({"origin"}, "r", {"m2"});
+    graph.add_hyperedge({"m2"}, "r", {"goal"});
+    graph.add_hyperedge({"origin"}, "r", {"m3"});
+    graph.add_hyperedge({"m3"}, "r", {"m4"});
+    graph.add_hyperedge({"m4"}, "r", {"goal"});
+
+    const std::string origin = graph.get_node("origin")->id;
+    const std::string goal = graph.get_node("goal")->id;
+
+    auto result = graph.find_k_shortest_paths("origin", "goal", 6, 1);
+    ASSERT_TRUE(result.found);
+    ASSERT_EQ(result.paths.size(), 6);
+    EXPECT_EQ(result.paths[0].size(), 2);
+    EXPECT_EQ(result.paths[1].size(), 2);
+    EXPECT_EQ(result.intersection_nodes.size(), 1);
+
+    std::set<std::vector<std::string>> seen;
+    for (size_t p = 0; p < result.paths.size(); ++p) {
+        const auto& path = result.paths[p];
+        if (p > 0) {
+            EXPECT_GE(path.size(), result.paths[p - 1].size());
+        }
+        EXPECT_TRUE(path.front().contains_node(origin));
+        EXPECT_TRUE(path.back().contains_node(goal));
+        std::vector<std::string> ids;
+        for (size_t i = 0; i < path.size(); ++i) {
+            ids.push_back(path[i].id);
+            if (i > 0) {
+                EXPECT_FALSE(path[i - 1].intersection(path[i]).empty());
+            }
+        }
+        EXPECT_TRUE(seen.insert(ids).second);
+    }
+
+    // A hop bound keeps only the two-edge routes
+    auto bounded = graph.find_k_shortest_paths("origin", "goal", 6, 1, 2);
+    EXPECT_EQ(bounded.paths.size(), 2);
+}
+
+TEST(PathSearchTest, PathLengthsMatchShortestPaths) {
+    Hypergraph graph;
+    for (int i = 0; i < 40; ++i) {
+        graph.add_hyperedge({"v" + std::to_string(i % 13)}, "r",
+                            {"v" + std::to_string((i * 5 + 3) % 19), "v" + std::to_string((i * 11) % 17)});
+    }
+
+    std::vector<std::string> targets;
+    for (int i = 0; i < 19; ++i) {
+        targets.push_back("v" + std::to_string(i));
+    }
+    targets.push_back("missing");
+
+    for (int s = 1; s <= 2; ++s) {
+        auto lengths = graph.find_path_lengths("v0", targets, s);
+        auto bounded = graph.find_path_lengths("v0", targets, s, 2);
+        for (size_t t = 0; t < targets.size(); ++t) {
+            auto path = graph.find_shortest_path("v0", targets[t], s);
+            int expected = path.empty() ? -1 : static_cast<int>(path.size());
+            EXPECT_EQ(lengths[t], expected) << targets[t] << " s=" << s;
+            EXPECT_EQ(bounded[t], expected <= 2 ? expected : -1) << targets[t] << " s=" << s;
+        }
+
+        // Yen's from the sweep's paths ranks the same path lengths
+        auto ranked = graph.find_k_shortest_paths_to("v0", targets, 4, s, 3);
+        ASSERT_EQ(ranked.size(), targets.size());
+        for (size_t t = 0; t < targets.size(); ++t) {
+            auto single = graph.find_k_shortest_paths("v0", targets[t], 4, s, 3);
+            EXPECT_EQ(ranked[t].found, single.found) << targets[t] << " s=" << s;
+            ASSERT_EQ(ranked[t].paths.size(), single.paths.size()) << targets[t] << " s=" << s;
+            for (size_t p = 0; p < single.paths.size(); ++p) {
+                EXPECT_EQ(ranked[t].paths[p].size(), single.paths[p].size()) << targets[t] << " s=" << s;
+            }
+        }
+    }
+}
+
+TEST(PathSearchTest, EveryStepSharesAtLeastSNodes) {
+    Hypergraph graph;
+    graph.add_hyperedge({"a", "b"}, "r", {"c"});
+    graph.add_hyperedge({"b"}, "r", {"z"});          // Shares only b with the first edge
+    graph.add_hyperedge({"b", "c"}, "r", {"d"});
+    graph.add_hyperedge({"c", "d"}, "r", {"z"});
+
+    EXPECT_EQ(graph.find_shortest_path("a", "z", 1).size(), 2u);
+
+    auto path = graph.find_shortest_path("a", "z", 2);
+    ASSERT_EQ(path.size(), 3u);
+    for (size_t i = 1; i < path.size(); ++i) {
+        EXPECT_GE(path[i - 1].intersection(path[i]).size(), 2u);
+    }
+
+    EXPECT_TRUE(graph.find_shortest_path("a", "z", 3).empty());
+}
+
+TEST(PathSearchTest, HopLimitCutsOffLongerPaths) {
+    Hypergraph graph;
+    graph.add_hyperedge({"a"}, "r", {"b"});
+    graph.add_hyperedge({"b"}, "r", {"c"});
+    graph.add_hyperedge({"c"}, "r", {"d"});
+    graph.add_hyperedge({"d"}, "r", {"e"});
+    graph.add_hyperedge({"e"}, "r", {"f"});
+
+    // Both frontiers stop at the limit, even when they would meet one hop later
+    for (size_t limit = 1; limit <= 4; ++limit) {
+        EXPECT_FALSE(graph.find_k_shortest_paths("a", "f", 1, 1, limit).found) << limit;
+    }
+    auto exact = graph.find_k_shortest_paths("a", "f", 1, 1, 5);
+    ASSERT_TRUE(exact.found);
+    EXPECT_EQ(exact.paths[0].size(), 5u);
+    EXPECT_EQ(graph.find_k_shortest_paths("a", "f", 1, 1, 0).paths[0].size(), 5u);
+}
+
+// Hub-heavy random graph checked against a plain BFS over s-adjacent edges.
+// Yen's spur searches ban the edges other paths already took, so they only
+// return every shortest path if banned edges are honoured.
+TEST(PathSearchTest, MatchesReferenceSearchOnHubHeavyGraph) {
+    Hypergraph graph;
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> node(0, 59);
+    std::uniform_int_distribution<int> hub(0, 2);
+    std::bernoulli_distribution via_hub(0.5);
+    auto name = [](int i) { return "n" + std::to_string(i); };
+    for (int e = 0; e < 120; ++e) {
+        std::set<std::string> members;
+        if (via_hub(rng)) members.insert("hub" + std::to_string(hub(rng)));
+        while (members.size() < 3) members.insert(name(node(rng)));
+        std::vector<std::string> list(members.begin(), members.end());
+        graph.add_hyperedge({list[0]}, "r", {list[1], list[2]});
+    }
+
+    const auto edges = graph.get_all_edges();
+
+    for (int s = 1; s <= 2; ++s) {
+        // Line graph of edges sharing at least s nodes
+        std::vector<std::vector<size_t>> adjacent(edges.size());
+        for (size_t i = 0; i < edges.size(); ++i) {
+            for (size_t j = i + 1; j < edges.size(); ++j) {
+                if (edges[i].intersection(edges[j]).size() >= static_cast<size_t>(s)) {
+                    adjacent[i].push_back(j);
+                    adjacent[j].push_back(i);
+                }
+            }
+        }
+
+        for (int a = 0; a < 60; a += 7) {
+            const auto* start = graph.get_node(name(a));
+            if (!start) continue;
+
+            // BFS from every edge containing start, counting shortest walks
+            std::vector<int> dist(edges.size(), -1);
+            std::vector<size_t> count(edges.size(), 0);
+            std::vector<size_t> queue;
+            for (size_t i = 0; i < edges.size(); ++i) {
+                if (edges[i].contains_node(start->id)) {
+                    dist[i] = 1;
+                    count[i] = 1;
+                    queue.push_back(i);
+                }
+            }
+            for (size_t head = 0; head < queue.size(); ++head) {
+                size_t e = queue[head];
+                for (size_t f : adjacent[e]) {
+                    if (dist[f] < 0) {
+                        dist[f] = dist[e] + 1;
+                        queue.push_back(f);
+                    }
+                    if (dist[f] == dist[e] + 1) count[f] += count[e];
+                }
+            }
+
+            for (int b = 0; b < 60; ++b) {
+                const auto* end = graph.get_node(name(b));
+                if (!end || b == a) continue;
+
+                int expected = -1;
+                size_t shortest_paths = 0;
+                for (size_t i = 0; i < edges.size(); ++i) {
+                    if (dist[i] < 0 || !edges[i].contains_node(end->id)) continue;
+                    if (expected < 0 || dist[i] < expected) {
+                        expected = dist[i];
+                        shortest_paths = 0;
+                    }
+                    if (dist[i] == expected) shortest_paths += count[i];
+                }
+
+                auto path = graph.find_shortest_path(name(a), name(b), s);
+                EXPECT_EQ(path.empty() ? -1 : static_cast<int>(path.size()), expected)
+                    << name(a) << " -> " << name(b) << " s=" << s;
+
+                if (expected < 0 || shortest_paths > 20) continue;
+                auto ranked = graph.find_k_shortest_paths(name(a), name(b),
+                                                          static_cast<int>(shortest_paths) + 1, s);
+                ASSERT_TRUE(ranked.found);
+                size_t found_shortest = 0;
+                std::set<std::vector<std::string>> seen;
+                for (const auto& p : ranked.paths) {
+                    std::vector<std::string> ids;
+                    for (const auto& edge : p) ids.push_back(edge.id);
+                    EXPECT_TRUE(seen.insert(ids).second);
+                    found_shortest += p.size() == static_cast<size_t>(expected);
+                }
+                EXPECT_EQ(found_shortest, shortest_paths) << name(a) << " -> " << name(b) << " s=" << s;
+            }
+        }
+    }
+}
+
 TEST_F(HypergraphTest, Neighborhood) {
     auto neighbors = graph.get_neighborhood("A", 1, 1);
     EXPECT_GT(neighbors.size(), 0);
@@ -199,6 +435,142 @@ TEST_F(HypergraphTest, MergeDuplicates) {
     EXPECT_LT(graph.num_edges(), initial_count + 1);
 }
 
+TEST_F(HypergraphTest, MergeNodesTransfersEdges) {
+    graph.merge_nodes("C", "F");
+
+    EXPECT_FALSE(graph.has_node("F"));
+    EXPECT_EQ(graph.num_edges(), 3);
+    EXPECT_EQ(graph.get_node_degree("C"), 3);
+
+    for (const auto& edge : graph.get_incident_edges("C")) {
+        EXPECT_TRUE(edge.contains_node("c"));
+        EXPECT_FALSE(edge.contains_node("f"));
+    }
+}
+
+// ==========================================
+// Integer-ID Tests
+// ==========================================
+
+TEST_F(HypergraphTest, IntegerIdLookup) {
+    NodeId c = graph.find_node_id("C");
+    ASSERT_NE(c, INVALID_ID);
+    EXPECT_TRUE(graph.is_live_node(c));
+    EXPECT_EQ(graph.node_at(c).id, "c");
+    EXPECT_EQ(graph.incident_edge_ids(c).size(), 2);
+    EXPECT_EQ(graph.find_node_id("missing"), INVALID_ID);
+
+    for (EdgeId e : graph.incident_edge_ids(c)) {
+        const auto& members = graph.edge_node_ids(e);
+        EXPECT_TRUE(std::is_sorted(members.begin(), members.end()));
+        EXPECT_TRUE(std::binary_search(members.begin(), members.end(), c));
+        EXPECT_EQ(graph.find_edge_id(graph.edge_at(e).id), e);
+    }
+}
+
+TEST_F(HypergraphTest, RemovalKeepsHandlesStable) {
+    NodeId f = graph.find_node_id("F");
+    std::string edge_id = graph.get_incident_edges("A")[0].id;
+    EdgeId e = graph.find_edge_id(edge_id);
+
+    ASSERT_TRUE(graph.remove_hyperedge(edge_id));
+    EXPECT_FALSE(graph.is_live_edge(e));
+    EXPECT_EQ(graph.find_edge_id(edge_id), INVALID_ID);
+    EXPECT_EQ(graph.find_node_id("F"), f);
+    EXPECT_EQ(graph.edge_id_bound(), 3);
+    EXPECT_EQ(graph.num_edges(), 2);
+}
+
+TEST_F(HypergraphTest, IncidenceCSRMatchesGraph) {
+    auto csr = graph.incidence();
+    ASSERT_EQ(csr->num_node_rows(), graph.node_id_bound());
+    ASSERT_EQ(csr->num_edge_rows(), graph.edge_id_bound());
+
+    for (NodeId n = 0; n < graph.node_id_bound(); ++n) {
+        const auto& expected = graph.incident_edge_ids(n);
+        auto row = csr->edges_of(n);
+        EXPECT_TRUE(std::equal(row.begin(), row.end(), expected.begin(), expected.end()));
+    }
+    for (EdgeId e = 0; e < graph.edge_id_bound(); ++e) {
+        const auto& expected = graph.edge_node_ids(e);
+        auto row = csr->nodes_of(e);
+        EXPECT_TRUE(std::equal(row.begin(), row.end(), expected.begin(), expected.end()));
+    }
+
+    // Cached until the next structural change
+    EXPECT_EQ(graph.incidence(), csr);
+    graph.add_hyperedge({"F"}, "rel4", {"G"});
+    auto rebuilt = graph.incidence();
+    EXPECT_NE(rebuilt, csr);
+    EXPECT_EQ(rebuilt->num_edge_rows(), 4);
+    EXPECT_EQ(csr->num_edge_rows(), 3);
+}
+
+TEST_F(HypergraphTest, ViewsSkipRemovedEntries) {
+    std::string removed_id = graph.get_incident_edges("A")[0].id;
+    graph.remove_node("A");
+
+    size_t edge_count = 0;
+    for (const auto& edge : graph.edges_view()) {
+        EXPECT_NE(edge.id, removed_id);
+        ++edge_count;
+    }
+    EXPECT_EQ(edge_count, graph.num_edges());
+    EXPECT_EQ(graph.edges_view().size(), graph.num_edges());
+
+    size_t node_count = 0;
+    graph.for_each_node([&node_count](const HyperNode& node) {
+        EXPECT_NE(node.id, "a");
+        ++node_count;
+    });
+    EXPECT_EQ(node_count, graph.num_nodes());
+
+    auto incident = graph.incident_view("E");
+    ASSERT_EQ(incident.size(), 2);
+    EXPECT_EQ(&incident[0], graph.get_hyperedge(incident[0].id));
+    EXPECT_TRUE(graph.incident_view("missing").empty());
+}
+
+TEST_F(HypergraphTest, DuplicateGroupingUsesSetSemantics) {
+    // Same relation, same source/target sets in a different order
+    graph.add_hyperedge({"B", "A"}, "rel1", {"C"});
+    graph.add_hyperedge({"A", "B", "A"}, "rel1", {"C"});
+    // Different direction is not a duplicate
+    graph.add_hyperedge({"C"}, "rel1", {"A", "B"});
+
+    auto duplicates = graph.find_duplicate_edges();
+    ASSERT_EQ(duplicates.size(), 1);
+    EXPECT_EQ(duplicates.begin()->second.size(), 2);
+
+    EXPECT_EQ(graph.merge_duplicate_edges(), 2);
+    EXPECT_TRUE(graph.find_duplicate_edges().empty());
+}
+
+TEST(HypergraphStatisticsTest, DuplicateCountIsRedundantEdges) {
+    Hypergraph graph;
+    graph.add_hyperedge({"A"}, "rel", {"B"});
+    graph.add_hyperedge({"A"}, "rel", {"B"});
+    graph.add_hyperedge({"A"}, "rel", {"B"});
+    graph.add_hyperedge({"B"}, "rel", {"C"});
+
+    auto stats = graph.compute_statistics();
+    EXPECT_EQ(stats.num_duplicate_edges, 2u);
+    EXPECT_EQ(stats.to_json()["num_duplicate_edges"], 2);
+}
+
+TEST_F(HypergraphTest, MergeSeesRelationEdits) {
+    Hypergraph other;
+    other.add_hyperedge({"A", "B"}, "renamed", {"C"});
+
+    // Prime the signature index, then edit a relation through the mutable accessor
+    graph.merge(Hypergraph(), true);
+    graph.get_hyperedge(graph.get_incident_edges("A")[0].id)->relation = "renamed";
+
+    size_t before = graph.num_edges();
+    graph.merge(other, true);
+    EXPECT_EQ(graph.num_edges(), before);
+}
+
 // ==========================================
 // Statistics Tests
 // ==========================================
@@ -212,6 +584,85 @@ TEST_F(HypergraphTest, ComputeStatistics) {
     EXPECT_GT(stats.avg_node_degree, 0.0);
 }
 
+TEST_F(HypergraphTest, CheapStatisticsTrackMutations) {
+    graph.add_hyperedge({"F", "G", "H"}, "rel4", {"I"});
+    graph.merge_nodes("A", "B");
+    graph.remove_node("D");
+
+    size_t max_edge_size = 0;
+    size_t min_edge_size = std::numeric_limits<size_t>::max();
+    for (const auto& edge : graph.edges_view()) {
+        max_edge_size = std::max(max_edge_size, edge.size());
+        min_edge_size = std::min(min_edge_size, edge.size());
+    }
+    size_t max_degree = 0;
+    size_t min_degree = std::numeric_limits<size_t>::max();
+    for (const auto& node : graph.nodes_view()) {
+        max_degree = std::max(max_degree, static_cast<size_t>(node.degree));
+        min_degree = std::min(min_degree, static_cast<size_t>(node.degree));
+    }
+
+    auto stats = graph.compute_statistics(StatisticsTier::Cheap);
+    EXPECT_EQ(stats.num_nodes, graph.num_nodes());
+    EXPECT_EQ(stats.num_edges, graph.num_edges());
+    EXPECT_EQ(stats.max_edge_size, max_edge_size);
+    EXPECT_EQ(stats.min_edge_size, min_edge_size);
+    EXPECT_EQ(stats.max_node_degree, max_degree);
+    EXPECT_EQ(stats.min_node_degree, min_degree);
+
+    // The full tier is memoized until the graph changes
+    auto full = graph.compute_statistics();
+    EXPECT_EQ(graph.compute_statistics().to_json(), full.to_json());
+    graph.add_hyperedge({"I"}, "rel5", {"C", "F"});
+    EXPECT_EQ(graph.compute_statistics().num_edges, full.num_edges + 1);
+}
+
+TEST(OverlapStatisticsTest, KernelMatchesPairwiseCount) {
+    Hypergraph graph;
+    for (int i = 0; i < 120; ++i) {
+        graph.add_hyperedge(
+            {"n" + std::to_string(i % 17), "n" + std::to_string((i * 7) % 23)},
+            "rel",
+            {"n" + std::to_string((i * 13) % 29), "n" + std::to_string(i % 5)}
+        );
+    }
+
+    auto edges = graph.get_all_edges();
+    size_t expected[3] = {0, 0, 0};
+    size_t expected_max = 0;
+    for (size_t i = 0; i < edges.size(); ++i) {
+        for (size_t j = i + 1; j < edges.size(); ++j) {
+            size_t shared = edges[i].intersection(edges[j]).size();
+            if (shared >= 1) expected[0]++;
+            if (shared >= 2) expected[1]++;
+            if (shared >= 3) expected[2]++;
+            expected_max = std::max(expected_max, shared);
+        }
+    }
+
+    StatisticsOptions options;
+    options.num_threads = 4;
+    auto stats = graph.compute_statistics(options);
+
+    EXPECT_FALSE(stats.overlap_estimated);
+    EXPECT_EQ(stats.num_pairs_overlap_1, expected[0]);
+    EXPECT_EQ(stats.num_pairs_overlap_2, expected[1]);
+    EXPECT_EQ(stats.num_pairs_overlap_3, expected[2]);
+    EXPECT_EQ(stats.max_edge_intersection, expected_max);
+
+    // A sampled estimate should bracket the exact count
+    options.overlap_sample_threshold = 10;
+    options.overlap_sample_size = 60;
+    auto sampled = graph.compute_statistics(options);
+
+    EXPECT_TRUE(sampled.overlap_estimated);
+    EXPECT_EQ(sampled.overlap_sample_size, 60);
+    EXPECT_NEAR(static_cast<double>(sampled.num_pairs_overlap_1),
+                static_cast<double>(expected[0]),
+                sampled.overlap_1_margin * 2 + 1);
+    EXPECT_TRUE(sampled.to_json().contains("overlap_estimate"));
+}
+
 TEST_F(HypergraphTest, DegreeDistribution) {
     auto dist = graph.compute_degree_distribution();
     EXPECT_GT(dist.size(), 0);
@@ -240,6 +691,47 @@ TEST_F(HypergraphTest, ConnectedComponents) {
     EXPECT_EQ(total_edges, graph.num_edges());
 }
 
+TEST(ComponentTest, MultiThresholdMatchesPairwiseUnion) {
+    Hypergraph graph;
+    for (int i = 0; i < 80; ++i) {
+        graph.add_hyperedge({"w" + std::to_string(i % 11), "w" + std::to_string((i * 3) % 31)}, "r",
+                            {"w" + std::to_string((i * 7) % 29)});
+    }
+
+    auto edges = graph.get_all_edges();
+    auto by_s = graph.find_s_connected_components_multi({3, 1, 2, 2, 0}, 3);
+    ASSERT_EQ(by_s.size(), 4);
+
+    for (int s : {0, 1, 2, 3}) {
+        // Reference: repeated relaxation of component labels over all pairs
+        std::vector<size_t> label(edges.size());
+        std::iota(label.begin(), label.end(), 0);
+        for (bool changed = true; changed;) {
+            changed = false;
+            for (size_t i = 0; i < edges.size(); ++i) {
+                for (size_t j = i + 1; j < edges.size(); ++j) {
+                    if (edges[i].intersection(edges[j]).size() >= static_cast<size_t>(std::max(s, 1))
+                        && label[i] != label[j]) {
+                        label[i] = label[j] = std::min(label[i], label[j]);
+                        changed = true;
+                    }
+                }
+            }
+        }
+        std::map<size_t, std::set<std::string>> expected;
+        for (size_t i = 0; i < edges.size(); ++i) {
+            expected[label[i]].insert(edges[i].id);
+        }
+
+        const auto& components = by_s.at(s);
+        EXPECT_EQ(components.size(), expected.size()) << "s=" << s;
+        for (const auto& [root, members] : expected) {
+            EXPECT_NE(std::find(components.begin(), components.end(), members), components.end()) << "s=" << s;
+        }
+        EXPECT_EQ(components, graph.find_s_connected_components(s));
+    }
+}
+
 // ==========================================
 // Subgraph Tests
 // ==========================================
@@ -276,6 +768,59 @@ TEST_F(HypergraphTest, MergeGraphs) {
     EXPECT_TRUE(graph.has_node("Y"));
 }
 
+TEST_F(HypergraphTest, MergeReportsCounts) {
+    Hypergraph other;
+    other.add_hyperedge({"A", "B"}, "rel1", {"C"});   // duplicate of fixture edge
+    other.add_hyperedge({"X"}, "rel", {"X"});         // self-loop
+    other.add_hyperedge({"X"}, "rel", {"Y"});
+    other.add_hyperedge({"X"}, "rel", {"Y"});         // duplicate within the batch
+
+    auto result = graph.merge(other, true);
+
+    EXPECT_EQ(result.edges_merged, 1);
+    EXPECT_EQ(result.duplicate_edges, 2);
+    EXPECT_EQ(result.self_loops, 1);
+    EXPECT_EQ(result.nodes_added, 2);
+    EXPECT_EQ(graph.num_edges(), 4);
+    EXPECT_TRUE(graph.find_duplicate_edges().empty());
+}
+
+TEST_F(HypergraphTest, MergeKeepsEdgesWithCollidingIds) {
+    HyperEdge edge;
+    edge.id = graph.get_incident_edges("A")[0].id;
+    edge.sources = {"X"};
+    edge.relation = "rel";
+    edge.targets = {"Y"};
+
+    Hypergraph other;
+    other.add_hyperedge(edge);
+
+    graph.merge(other, false);
+    EXPECT_EQ(graph.num_edges(), 4);
+    EXPECT_EQ(graph.get_node_degree("A"), 1);
+    EXPECT_EQ(graph.get_node_degree("X"), 1);
+}
+
+TEST(HypergraphMergeTest, KeepsNormalizedIdsVerbatim) {
+    // "Analyses" normalizes to "analys", which would normalize again to "analy"
+    Hypergraph other;
+    other.add_hyperedge({"Analyses"}, "supports", {"Hypotheses"});
+
+    Hypergraph graph;
+    graph.add_hyperedge({"Analyses"}, "cites", {"Papers"});
+
+    auto result = graph.merge(other, false);
+    EXPECT_EQ(result.nodes_added, 1);
+    EXPECT_EQ(result.edges_merged, 1);
+
+    std::set<std::string> ids;
+    for (const auto& node : graph.nodes_view()) ids.insert(node.id);
+    EXPECT_EQ(ids, (std::set<std::string>{"analys", "hypothes", "paper"}));
+    for (const auto& edge : graph.edges_view()) {
+        EXPECT_EQ(edge.sources, std::vector<std::string>{"analys"});
+    }
+}
+
 // ==========================================
 // Export/Import Tests
 // ==========================================
@@ -303,6 +848,397 @@ TEST_F(HypergraphTest, ExportImportRoundtrip) {
     EXPECT_EQ(loaded.num_edges(), graph.num_edges());
 }
 
+TEST_F(HypergraphTest, BinarySnapshotRoundtrip) {
+    HyperEdge edge;
+    edge.sources = {"A", "G"};
+    edge.relation = "rel4";
+    edge.targets = {"H"};
+    edge.properties = {{"method", "assay"}, {"year", "2021"}};
+    edge.source_document = "paper.pdf";
+    edge.source_chunk_id = "chunk-7";
+    edge.source_page = 3;
+    edge.confidence = 0.75;
+    graph.add_hyperedge(edge);
+
+    HyperNode embedded = *graph.get_node("G");
+    embedded.embedding = {0.5f, -1.0f, 2.0f};
+    embedded.properties["type"] = "material";
+    graph.add_node(embedded);
+
+    // Tombstones are dropped on export and handles renumbered
+    graph.remove_hyperedge(graph.get_incident_edges("D").front().id);
+    graph.merge_nodes("B", "F");
+
+    std::string path = ::testing::TempDir() + "kg_snapshot_roundtrip.kgb";
+    graph.export_to_binary(path);
+    ASSERT_TRUE(GraphSnapshot::is_snapshot_file(path));
+
+    auto loaded = Hypergraph::load(path);
+    ASSERT_EQ(loaded.num_nodes(), graph.num_nodes());
+    ASSERT_EQ(loaded.num_edges(), graph.num_edges());
+
+    for (const auto& node : graph.get_all_nodes()) {
+        const HyperNode* copy = loaded.get_node(node.id);
+        ASSERT_NE(copy, nullptr) << node.id;
+        EXPECT_EQ(copy->label, node.label);
+        EXPECT_EQ(copy->properties, node.properties);
+        EXPECT_EQ(copy->embedding, node.embedding);
+        EXPECT_EQ(copy->degree, node.degree);
+        EXPECT_EQ(copy->incident_edges, node.incident_edges);
+    }
+    for (const auto& original : graph.get_all_edges()) {
+        const HyperEdge* copy = loaded.get_hyperedge(original.id);
+        ASSERT_NE(copy, nullptr) << original.id;
+        EXPECT_EQ(copy->sources, original.sources);
+        EXPECT_EQ(copy->targets, original.targets);
+        EXPECT_EQ(copy->relation, original.relation);
+        EXPECT_EQ(copy->properties, original.properties);
+        EXPECT_EQ(copy->source_document, original.source_document);
+        EXPECT_EQ(copy->source_chunk_id, original.source_chunk_id);
+        EXPECT_EQ(copy->source_page, original.source_page);
+        EXPECT_DOUBLE_EQ(copy->confidence, original.confidence);
+    }
+
+    // Derived structures behave as if the graph had been built in place
+    EXPECT_EQ(loaded.compute_statistics(StatisticsTier::Cheap).avg_node_degree,
+              graph.compute_statistics(StatisticsTier::Cheap).avg_node_degree);
+    EXPECT_EQ(loaded.find_shortest_path("A", "E").size(), graph.find_shortest_path("A", "E").size());
+    loaded.add_hyperedge({"H"}, "rel5", {"Z"});
+    EXPECT_EQ(loaded.num_nodes(), graph.num_nodes() + 1);
+
+    GraphSnapshot snapshot(path);
+    EXPECT_NO_THROW(snapshot.validate());
+    EXPECT_EQ(snapshot.num_nodes(), graph.num_nodes());
+    auto csr = snapshot.incidence();
+    EXPECT_EQ(csr.edge_nodes.size(), graph.incidence()->edge_nodes.size());
+}
+
+TEST(StreamingJsonTest, MatchesDomLoader) {
+    Hypergraph graph;
+    HyperEdge edge;
+    edge.sources = {"Buses", "Knowledge Graphs"};
+    edge.relation = "uses";
+    edge.targets = {"Glasses"};
+    edge.properties = {{"year", "2020"}};
+    edge.source_document = "paper.pdf";
+    edge.source_page = 4;
+    edge.confidence = 0.5;
+    graph.add_hyperedge(edge);
+    graph.add_hyperedge({"Glasses"}, "made_of", {"Sand", "Soda"}, "chunk-2");
+    HyperNode node = *graph.get_node("sand");
+    node.embedding = {1.0f, 0.25f};
+    node.properties["type"] = "material";
+    graph.add_node(node);
+
+    // Legacy file: nodes declared first with display labels, no normalized flag
+    std::string legacy = R"({"nodes": [{"id": "Ions", "label": "Ions", "degree": 3}],
+        "extra": {"ignored": [1, {"x": null}]},
+        "hyperedges": [{"id": "e1", "sources": ["ions"], "relation": "r", "targets": ["Salts"]}]})";
+
+    for (const auto& text : {graph.to_json().dump(), graph.to_json().dump(2), legacy}) {
+        auto dom = Hypergraph::from_json(nlohmann::json::parse(text));
+        std::istringstream input(text);
+        auto streamed = Hypergraph::load_from_json_stream(input);
+
+        ASSERT_EQ(streamed.num_nodes(), dom.num_nodes());
+        ASSERT_EQ(streamed.num_edges(), dom.num_edges());
+        auto dom_nodes = dom.get_all_nodes();
+        auto streamed_nodes = streamed.get_all_nodes();
+        for (size_t i = 0; i < dom_nodes.size(); ++i) {
+            EXPECT_EQ(streamed_nodes[i].id, dom_nodes[i].id);
+            EXPECT_EQ(streamed_nodes[i].label, dom_nodes[i].label);
+            EXPECT_EQ(streamed_nodes[i].properties, dom_nodes[i].properties);
+            EXPECT_EQ(streamed_nodes[i].embedding, dom_nodes[i].embedding);
+            EXPECT_EQ(streamed_nodes[i].incident_edges, dom_nodes[i].incident_edges);
+        }
+        EXPECT_EQ(streamed.to_json(), dom.to_json());
+    }
+
+    // Exported IDs are taken verbatim, so a reload does not singularize twice
+    // ("analyses" -> "analys" -> "analy")
+    graph.add_hyperedge({"Analyses"}, "cover", {"Sand"});
+    std::istringstream input(graph.to_json().dump());
+    auto reloaded = Hypergraph::load_from_json_stream(input);
+    std::set<std::string> original_ids, reloaded_ids;
+    for (const auto& n : graph.get_all_nodes()) original_ids.insert(n.id);
+    for (const auto& n : reloaded.get_all_nodes()) reloaded_ids.insert(n.id);
+    EXPECT_EQ(reloaded_ids, original_ids);
+    EXPECT_EQ(reloaded_ids.count("analys"), 1);
+}
+
+TEST(StreamingJsonTest, ProjectionsAndErrors) {
+    Hypergraph graph;
+    HyperEdge edge;
+    edge.sources = {"A"};
+    edge.relation = "r";
+    edge.targets = {"B"};
+    edge.properties = {{"k", "v"}};
+    edge.source_document = "doc";
+    graph.add_hyperedge(edge);
+    HyperNode node = *graph.get_node("a");
+    node.embedding = {1.0f, 2.0f};
+    node.properties["p"] = "q";
+    graph.add_node(node);
+
+    JsonLoadOptions projection;
+    projection.embeddings = false;
+    projection.node_properties = false;
+    projection.provenance = false;
+    std::istringstream input(graph.to_json().dump());
+    auto loaded = Hypergraph::load_from_json_stream(input, projection);
+    ASSERT_EQ(loaded.num_edges(), 1);
+    EXPECT_TRUE(loaded.get_node("a")->embedding.empty());
+    EXPECT_TRUE(loaded.get_node("a")->properties.empty());
+    const auto loaded_edge = loaded.get_all_edges().front();
+    EXPECT_TRUE(loaded_edge.source_document.empty());
+    EXPECT_EQ(loaded_edge.properties, edge.properties);
+
+    for (const char* text : {R"({"nodes": [{"id": "a"}]})",
+                             R"({"hyperedges": [{"id": "e", "sources": ["a"], "targets": ["b"]}]})",
+                             R"({"nodes": [{"id": "a", "label": 5}]})",
+                             R"({"nodes": [)"}) {
+        std::istringstream bad(text);
+        EXPECT_THROW(Hypergraph::load_from_json_stream(bad), std::runtime_error) << text;
+    }
+}
+
+TEST(JsonWriterTest, MatchesNlohmannLayout) {
+    nlohmann::json doc = {
+        {"name", "quote \" slash \\ tab \t ctrl \x01 caf\xC3\xA9"},
+        {"count", 42},
+        {"negative", -7},
+        {"flag", false},
+        {"nothing", nullptr},
+        {"empty_list", nlohmann::json::array()},
+        {"empty_map", nlohmann::json::object()},
+        {"nested", {{"ids", {"a", "b"}}, {"deep", {{"x", {1, 2, {{"y", true}}}}}}}}
+    };
+
+    for (bool compact : {false, true}) {
+        std::ostringstream out;
+        JsonWriter writer(out, compact);
+        writer.value(doc);
+        EXPECT_TRUE(writer.done());
+        EXPECT_EQ(out.str(), compact ? doc.dump() : doc.dump(2));
+    }
+
+    // Floats round-trip and stay floats; invalid UTF-8 is replaced
+    std::ostringstream out;
+    JsonWriter writer(out, true);
+    writer.begin_array().value(1.0).value(0.1f).value(1e-300).value(std::nan("")).value("bad\xFF").end_array();
+    auto parsed = nlohmann::json::parse(out.str());
+    EXPECT_TRUE(parsed[0].is_number_float());
+    EXPECT_EQ(parsed[1].get<float>(), 0.1f);
+    EXPECT_EQ(parsed[2].get<double>(), 1e-300);
+    EXPECT_TRUE(parsed[3].is_null());
+    EXPECT_EQ(parsed[4].get<std::string>(), "bad\xEF\xBF\xBD");
+
+    EXPECT_THROW(JsonWriter(out).begin_object().value(1), std::logic_error);
+}
+
+TEST(JsonWriterTest, StreamedExportRoundtrips) {
+    Hypergraph graph;
+    HyperEdge edge;
+    edge.sources = {"Analyses", "Line\nBreak"};
+    edge.relation = "uses";
+    edge.targets = {"Sand"};
+    edge.properties = {{"k", "v"}};
+    edge.source_chunk_id = "chunk-1";
+    edge.source_page = 2;
+    edge.confidence = 0.3;
+    graph.add_hyperedge(edge);
+    HyperNode node = *graph.get_node("sand");
+    node.embedding = {0.1f, -2.5f, 3.0f};
+    graph.add_node(node);
+
+    const auto expected = graph.to_json();
+    std::vector<std::pair<std::string, JsonWriteOptions>> cases = {
+        {"kg_stream_pretty.json", {}},
+        {"kg_stream_compact.json", {true, false, 6}},
+        {"kg_stream_gzip.json.gz", {true, false, 6}},
+    };
+    for (const auto& [name, options] : cases) {
+        std::string path = ::testing::TempDir() + name;
+        graph.export_to_json(path, true, options);
+        EXPECT_EQ(is_gzip_file(path), name.size() > 3 && name.substr(name.size() - 3) == ".gz") << name;
+
+        auto loaded = Hypergraph::load(path);
+        EXPECT_EQ(loaded.to_json(), expected) << name;
+        auto input = open_json_input(path);
+        EXPECT_EQ(Hypergraph::from_json(nlohmann::json::parse(*input)).to_json(), expected) << name;
+    }
+}
+
+TEST(SnapshotTest, RejectsForeignAndTruncatedFiles) {
+    std::string json_path = ::testing::TempDir() + "kg_snapshot_foreign.json";
+    { std::ofstream(json_path) << R"({"nodes": [], "hyperedges": []})"; }
+    EXPECT_FALSE(GraphSnapshot::is_snapshot_file(json_path));
+    EXPECT_THROW(GraphSnapshot{json_path}, std::runtime_error);
+
+    Hypergraph graph;
+    graph.add_hyperedge({"A", "B"}, "rel", {"C"});
+    std::string path = ::testing::TempDir() + "kg_snapshot_truncated.kgb";
+    graph.export_to_binary(path);
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) / 2);
+    EXPECT_THROW(Hypergraph::load_from_binary(path), std::runtime_error);
+}
+
+static std::vector<std::tuple<std::string, std::string, int>> cooccurrence_triples(const CooccurrenceIndex& cooc) {
+    std::vector<std::tuple<std::string, std::string, int>> triples;
+    cooc.for_each_pair([&](auto a, auto b, int count) {
+        triples.emplace_back(cooc.name(a), cooc.name(b), count);
+    });
+    return triples;
+}
+
+TEST(IndexTest, CooccurrenceMatchesPairwiseCounts) {
+    Hypergraph graph;
+    std::mt19937 rng(7);
+    for (int e = 0; e < 300; ++e) {
+        std::vector<std::string> sources, targets;
+        for (int k = 0; k < 1 + static_cast<int>(rng() % 3); ++k) sources.push_back("v" + std::to_string(rng() % 40));
+        for (int k = 0; k < 1 + static_cast<int>(rng() % 2); ++k) targets.push_back("v" + std::to_string(rng() % 40));
+        graph.add_hyperedge(sources, "r", targets);
+    }
+
+    // Reference: every ordered position pair of sources + targets
+    std::map<std::pair<std::string, std::string>, int> expected;
+    for (const auto& edge : graph.edges_view()) {
+        std::vector<std::string> members(edge.sources);
+        members.insert(members.end(), edge.targets.begin(), edge.targets.end());
+        for (size_t i = 0; i < members.size(); ++i) {
+            for (size_t j = i + 1; j < members.size(); ++j) {
+                expected[std::minmax(members[i], members[j])]++;
+            }
+        }
+    }
+
+    auto serial = CooccurrenceIndex::build(graph, 1);
+    auto parallel = CooccurrenceIndex::build(graph, 4);
+    EXPECT_EQ(cooccurrence_triples(serial), cooccurrence_triples(parallel));
+    EXPECT_EQ(serial.num_pairs(), expected.size());
+    for (const auto& [pair, count] : expected) {
+        auto a = serial.find(pair.first), b = serial.find(pair.second);
+        EXPECT_EQ(serial.count(a, b), count);
+        EXPECT_EQ(serial.count(b, a), count);
+    }
+    EXPECT_EQ(serial.count(serial.find("v1"), CooccurrenceIndex::NO_ENTITY), 0);
+
+    auto hub = serial.find("v0");
+    auto top = serial.top_partners(hub, 3);
+    ASSERT_FALSE(top.empty());
+    auto row = serial.counts(hub);
+    EXPECT_EQ(top[0].second, *std::max_element(row.begin(), row.end()));
+    for (size_t i = 1; i < top.size(); ++i) EXPECT_GE(top[i - 1].second, top[i].second);
+}
+
+TEST(IndexTest, BinaryAndJsonRoundtripKeepFullTables) {
+    Hypergraph graph;
+    for (int i = 0; i < 1200; ++i) {
+        graph.add_hyperedge({"entity_" + std::to_string(i)}, "Rel" + std::to_string(i % 3),
+                            {"entity_" + std::to_string(i + 1), "hub|x"});
+    }
+    HypergraphIndex built;
+    built.source_graph_path = "graph.json";
+    built.build(graph, {1, 2});
+    ASSERT_EQ(built.degree_ranked_nodes().size(), graph.num_nodes());
+
+    std::string binary_path = ::testing::TempDir() + "kg_index.kgi";
+    std::string json_path = ::testing::TempDir() + "kg_index.json";
+    built.save_to_binary(binary_path);
+    built.save_to_json(json_path);
+    EXPECT_TRUE(HypergraphIndex::is_binary_index(binary_path));
+    EXPECT_FALSE(HypergraphIndex::is_binary_index(json_path));
+
+    for (const auto& loaded : {HypergraphIndex::load(binary_path), HypergraphIndex::load(json_path)}) {
+        // Point queries first: a binary index answers them without materializing
+        EXPECT_EQ(loaded.get_cooccurrence("entity_7", "Entity_8"), built.get_cooccurrence("entity_7", "entity_8"));
+        EXPECT_EQ(loaded.get_cooccurrence("hub|x", "entity_3"), 2);
+        EXPECT_EQ(loaded.get_cooccurrence("entity_7", "missing"), 0);
+        EXPECT_EQ(loaded.get_top_hubs(3), built.get_top_hubs(3));
+        EXPECT_EQ(loaded.get_top_cooccurring("hub|x", 2), built.get_top_cooccurring("hub|x", 2));
+        EXPECT_EQ(loaded.cooccurrence().num_pairs(), built.cooccurrence().num_pairs());
+
+        EXPECT_EQ(loaded.created_utc, built.created_utc);
+        EXPECT_EQ(loaded.source_graph_path, "graph.json");
+        EXPECT_EQ(loaded.node_count, built.node_count);
+        EXPECT_EQ(loaded.relation_to_edges(), built.relation_to_edges());
+        EXPECT_EQ(loaded.label_to_nodes(), built.label_to_nodes());
+        EXPECT_EQ(loaded.s_components(), built.s_components());
+        EXPECT_EQ(loaded.degree_ranked_nodes(), built.degree_ranked_nodes());
+        EXPECT_EQ(cooccurrence_triples(loaded.cooccurrence()), cooccurrence_triples(built.cooccurrence()));
+    }
+
+    std::filesystem::resize_file(binary_path, std::filesystem::file_size(binary_path) / 2);
+    EXPECT_THROW(HypergraphIndex::load_from_binary(binary_path), std::runtime_error);
+}
+
+static HypergraphIndex::Postings sorted_postings(HypergraphIndex::Postings postings) {
+    for (auto& [key, ids] : postings) std::sort(ids.begin(), ids.end());
+    return postings;
+}
+
+TEST(IndexTest, AttachedIndexMatchesRebuild) {
+    Hypergraph graph;
+    for (int i = 0; i < 60; ++i) {
+        graph.add_hyperedge({"n" + std::to_string(i % 25), "n" + std::to_string(i % 7)},
+                            i % 2 ? "Uses" : "part_of", {"n" + std::to_string((i * 3) % 25)});
+    }
+
+    // Start from a binary index, which attach() reads into memory
+    HypergraphIndex built;
+    built.build(graph, {1, 2});
+    std::string path = ::testing::TempDir() + "kg_attached.kgi";
+    built.save_to_binary(path);
+    HypergraphIndex index = HypergraphIndex::load(path);
+    index.attach(graph);
+    ASSERT_TRUE(index.is_attached());
+
+    auto first = graph.add_hyperedge({"n1", "new_a"}, "uses", {"new_b", "n1"});
+    graph.add_hyperedge({"new_b"}, "Cites", {"n3"});
+    graph.remove_hyperedge(first);
+    graph.merge_nodes("n2", "n9");
+    graph.merge_nodes("n4", "n11");
+    graph.remove_node("n5");
+    HyperNode isolated;
+    isolated.id = "Isolated";
+    isolated.label = "Isolated";
+    graph.add_node(isolated);
+
+    HypergraphIndex fresh;
+    fresh.build(graph, {1, 2});
+    EXPECT_EQ(index.get_top_hubs(5), fresh.get_top_hubs(5));
+    EXPECT_EQ(index.get_cooccurrence("n2", "n1"), fresh.get_cooccurrence("n2", "n1"));
+    EXPECT_EQ(sorted_postings(index.relation_to_edges()), sorted_postings(fresh.relation_to_edges()));
+    EXPECT_EQ(sorted_postings(index.label_to_nodes()), sorted_postings(fresh.label_to_nodes()));
+    EXPECT_EQ(index.degree_ranked_nodes(), fresh.degree_ranked_nodes());
+    EXPECT_EQ(index.s_components(), fresh.s_components());
+    EXPECT_EQ(cooccurrence_triples(index.cooccurrence()), cooccurrence_triples(fresh.cooccurrence()));
+    EXPECT_EQ(index.cooccurrence().num_entities(), fresh.cooccurrence().num_entities());
+
+    // Saved counts follow the graph, and the index can be re-attached to it
+    index.save_to_binary(path);
+    index.detach();
+    HypergraphIndex reloaded = HypergraphIndex::load(path);
+    EXPECT_EQ(reloaded.node_count, graph.num_nodes());
+    EXPECT_NO_THROW(reloaded.attach(graph));
+    EXPECT_THROW(built.attach(graph), std::runtime_error);
+
+    // A graph going away detaches its observers
+    {
+        Hypergraph scratch;
+        scratch.add_hyperedge({"a"}, "r", {"b"});
+        HypergraphIndex scratch_index;
+        scratch_index.build(scratch, {1});
+        scratch_index.attach(scratch);
+        scratch.clear();
+        reloaded = scratch_index;
+    }
+    EXPECT_FALSE(reloaded.is_attached());
+    EXPECT_THROW(reloaded.s_components(), std::runtime_error);
+    EXPECT_TRUE(reloaded.relation_to_edges().empty());
+}
+
 TEST_F(HypergraphTest, IncidenceMatrix) {
     auto matrix = graph.to_incidence_matrix();
 
@@ -330,6 +1266,143 @@ TEST(UtilityTest, CosineSimilarity) {
     EXPECT_NEAR(sim_orthogonal, 0.0, 1e-6);
 }
 
+TEST(VectorIndexTest, HnswRecallAgainstExact) {
+    std::mt19937 rng(7);
+    std::normal_distribution<float> noise(0.0f, 1.0f);
+
+    std::vector<std::vector<float>> vectors(3000, std::vector<float>(24));
+    for (auto& v : vectors) {
+        for (auto& x : v) x = noise(rng);
+    }
+
+    AnnConfig config;
+    auto report = evaluate_vector_index(vectors, config, 100, 10);
+
+    EXPECT_EQ(report.method, "hnsw");
+    EXPECT_EQ(report.num_queries, 100);
+    EXPECT_GE(report.recall_at_k, 0.9);
+
+    // Threshold queries never return anything below the threshold
+    HnswVectorIndex index(24, config);
+    for (const auto& v : vectors) index.add(v);
+    for (const auto& hit : index.search_threshold(index.vector(0), 0.5f)) {
+        EXPECT_GE(hit.similarity, 0.5f);
+    }
+    EXPECT_EQ(index.search(index.vector(0), 1).front().id, 0u);
+}
+
+TEST(VectorIndexTest, MergeSimilarNodesMatchesExact) {
+    auto build = []() {
+        Hypergraph graph;
+        std::mt19937 rng(11);
+        std::normal_distribution<float> noise(0.0f, 1.0f);
+
+        // 200 clusters of 5 near-identical embeddings each
+        for (int c = 0; c < 200; ++c) {
+            std::vector<float> center(16);
+            for (auto& x : center) x = noise(rng);
+            for (int m = 0; m < 5; ++m) {
+                HyperNode node;
+                node.id = "c" + std::to_string(c) + "_" + std::to_string(m);
+                node.label = node.id;
+                node.embedding = center;
+                for (auto& x : node.embedding) x += 0.01f * noise(rng);
+                graph.add_node(node);
+            }
+            graph.add_hyperedge({"c" + std::to_string(c) + "_0"}, "rel",
+                                {"c" + std::to_string(c) + "_1"});
+        }
+        return graph;
+    };
+
+    Hypergraph exact_graph = build();
+    AnnConfig exact;
+    exact.method = AnnMethod::Exact;
+    size_t exact_merged = exact_graph.merge_similar_nodes(0.98, exact);
+
+    Hypergraph ann_graph = build();
+    AnnConfig hnsw;
+    hnsw.exact_below = 0;
+    size_t ann_merged = ann_graph.merge_similar_nodes(0.98, hnsw);
+
+    // The threshold-only overload stays an exact, uncapped scan
+    Hypergraph legacy_graph = build();
+    legacy_graph.merge_similar_nodes(0.98);
+    EXPECT_EQ(legacy_graph.num_nodes(), exact_graph.num_nodes());
+
+    EXPECT_EQ(exact_merged, 800u);
+    EXPECT_EQ(ann_merged, exact_merged);
+    EXPECT_EQ(ann_graph.num_nodes(), 200u);
+    EXPECT_EQ(ann_graph.num_edges(), 200u);
+
+    EXPECT_THROW(ann_graph.merge_similar_nodes(1.5, hnsw), std::invalid_argument);
+}
+
+TEST(VectorMathTest, DispatchLevelsAgreeWithScalar) {
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> uniform(-1.0f, 1.0f);
+
+    // Lengths straddle every lane width and remainder path
+    const size_t n = 37;
+    const size_t rows = 9;
+    std::vector<float> a(n), b(rows * n);
+    for (auto& x : a) x = uniform(rng);
+    for (auto& x : b) x = uniform(rng);
+
+    auto reference = [&](size_t r) {
+        const float* row = b.data() + r * n;
+        double dot = 0, aa = 0, bb = 0, l1 = 0, l2 = 0;
+        for (size_t i = 0; i < n; ++i) {
+            dot += a[i] * row[i];
+            aa += a[i] * a[i];
+            bb += row[i] * row[i];
+            l1 += std::fabs(a[i] - row[i]);
+            l2 += (a[i] - row[i]) * (a[i] - row[i]);
+        }
+        return std::vector<double>{dot, dot / std::sqrt(aa * bb), l1, l2};
+    };
+
+    vec::Isa original = vec::active_isa();
+    for (vec::Isa isa : {vec::Isa::Scalar, vec::Isa::SSE, vec::Isa::AVX2, vec::Isa::AVX512}) {
+        if (static_cast<int>(isa) > static_cast<int>(vec::detected_isa())) continue;
+        vec::set_isa(isa);
+        SCOPED_TRACE(vec::isa_name(isa));
+
+        std::vector<float> dots(rows), cosines(rows), l1s(rows), l2s(rows), matrix(rows * rows);
+        vec::dot_many(a.data(), b.data(), rows, n, dots.data());
+        vec::cosine_many(a.data(), b.data(), rows, n, cosines.data());
+        vec::l1_distance_many(a.data(), b.data(), rows, n, l1s.data());
+        vec::l2_squared_many(a.data(), b.data(), rows, n, l2s.data());
+        vec::cosine_matrix(b.data(), rows, b.data(), rows, n, matrix.data());
+
+        for (size_t r = 0; r < rows; ++r) {
+            auto expected = reference(r);
+            const float* row = b.data() + r * n;
+            EXPECT_NEAR(vec::dot(a.data(), row, n), expected[0], 1e-4);
+            EXPECT_NEAR(vec::cosine(a.data(), row, n), expected[1], 1e-5);
+            EXPECT_NEAR(vec::l1_distance(a.data(), row, n), expected[2], 1e-4);
+            EXPECT_NEAR(vec::l2_squared(a.data(), row, n), expected[3], 1e-4);
+            EXPECT_NEAR(dots[r], expected[0], 1e-4);
+            EXPECT_NEAR(cosines[r], expected[1], 1e-5);
+            EXPECT_NEAR(l1s[r], expected[2], 1e-4);
+            EXPECT_NEAR(l2s[r], expected[3], 1e-4);
+            EXPECT_NEAR(matrix[r * rows + r], 1.0, 1e-5);
+        }
+
+        std::vector<float> y(b.begin(), b.begin() + n);
+        vec::axpy(0.5f, a.data(), y.data(), n);
+        for (size_t i = 0; i < n; ++i) {
+            EXPECT_NEAR(y[i], b[i] + 0.5f * a[i], 1e-6);
+        }
+        vec::normalize(y.data(), n);
+        EXPECT_NEAR(vec::norm(y.data(), n), 1.0, 1e-5);
+
+        std::vector<float> zero(n, 0.0f);
+        EXPECT_EQ(vec::cosine(zero.data(), a.data(), n), 0.0f);
+    }
+    vec::set_isa(original);
+}
+
 TEST(UtilityTest, GenerateEdgeID) {
     std::string id1 = Hypergraph::generate_edge_id();
     std::string id2 = Hypergraph::generate_edge_id();
@@ -338,6 +1411,522 @@ TEST(UtilityTest, GenerateEdgeID) {
     EXPECT_TRUE(id1.find("edge_") == 0);
 }
 
+TEST(UtilityTest, NormalizeNodeIdForms) {
+    const std::vector<std::pair<std::string, std::string>> cases = {
+        {"  Knowledge Graphs \t", "knowledge graph"},
+        {"Studies", "study"},
+        {"Boxes", "box"},
+        {"CHURCHES", "church"},
+        {"Class", "class"},
+        {"gas", "gas"},
+        {"C++ Libs", "c++ lib"},
+        {"Caf\xC3\xA9 Drinks", "caf\xC3\xA9 drink"},
+        {"\xC3\x89TUDES", "\xC3\x89tudes"},
+        {" \n ", ""},
+    };
+
+    // A buffer holding a longer previous result must be fully overwritten
+    std::string buffer = "a much longer previous normalized id";
+    std::vector<std::string> labels;
+    for (const auto& [label, expected] : cases) {
+        EXPECT_EQ(Hypergraph::normalize_node_id(label), expected) << label;
+        Hypergraph::normalize_node_id(label, buffer);
+        EXPECT_EQ(buffer, expected) << label;
+        labels.push_back(label);
+    }
+
+    // Large enough to take the parallel path
+    while (labels.size() < 10000) labels.push_back("Node " + std::to_string(labels.size()) + "s");
+    auto batch = Hypergraph::normalize_node_ids(labels, 4);
+    ASSERT_EQ(batch.size(), labels.size());
+    for (size_t i = 0; i < labels.size(); ++i) EXPECT_EQ(batch[i], Hypergraph::normalize_node_id(labels[i]));
+}
+
+TEST(UtilityTest, AddHyperedgesMatchesSequentialAdds) {
+    std::vector<HyperEdge> edges;
+    for (int i = 0; i < 50; ++i) {
+        HyperEdge edge;
+        edge.id = "e" + std::to_string(i);
+        edge.sources = {"Graph " + std::to_string(i % 7) + "s", "Hub"};
+        edge.relation = "links";
+        edge.targets = {"graph " + std::to_string((i + 1) % 7)};
+        edges.push_back(edge);
+    }
+
+    Hypergraph sequential, batched;
+    for (const auto& edge : edges) sequential.add_hyperedge(edge);
+    auto ids = batched.add_hyperedges(edges);
+    ASSERT_EQ(ids.size(), edges.size());
+    EXPECT_EQ(ids.front(), "e0");
+
+    ASSERT_EQ(batched.num_nodes(), sequential.num_nodes());
+    for (const auto& node : sequential.nodes_view()) {
+        const HyperNode* other = batched.get_node(node.id);
+        ASSERT_NE(other, nullptr) << node.id;
+        EXPECT_EQ(other->label, node.label);
+        EXPECT_EQ(other->degree, node.degree);
+    }
+    EXPECT_EQ(batched.get_hyperedge("e3")->sources, sequential.get_hyperedge("e3")->sources);
+}
+
+TEST(RateLimiterTest, TokenBudgetPacesCallsAndPausesAll) {
+    using clock = std::chrono::steady_clock;
+    auto elapsed_ms = [](clock::time_point start) {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(clock::now() - start).count();
+    };
+
+    // 6000 tokens a minute refill at 100 per second; one second is banked
+    RateLimiter limiter(0, 6000);
+    auto start = clock::now();
+    limiter.acquire(100);
+    EXPECT_LT(elapsed_ms(start), 100);
+    limiter.acquire(50);
+    EXPECT_GE(elapsed_ms(start), 400);
+
+    // Reported usage below the estimate is refunded
+    RateLimiter refunded(0, 6000);
+    refunded.acquire(100);
+    refunded.reconcile(100, 50);
+    start = clock::now();
+    refunded.acquire(50);
+    EXPECT_LT(elapsed_ms(start), 100);
+
+    // Limiting an unlimited limiter allows one second of requests, not a minute
+    RateLimiter burst;
+    burst.set_limits(1200, 0);
+    for (int i = 0; i < 20; ++i) {
+        EXPECT_EQ(burst.try_acquire(1).count(), 0);
+    }
+    EXPECT_GT(burst.try_acquire(1).count(), 0);
+
+    // A pause holds callers even without budgets
+    RateLimiter unlimited;
+    unlimited.pause_for(std::chrono::milliseconds(200));
+    start = clock::now();
+    unlimited.acquire(1);
+    EXPECT_GE(elapsed_ms(start), 190);
+
+    std::vector<Message> messages = {Message(Message::Role::User, std::string(384, 'x'))};
+    EXPECT_EQ(RateLimiter::estimate_tokens(messages, 100), 200);
+    for (int attempt = 1; attempt <= 4; ++attempt) {
+        auto delay = RateLimiter::backoff_delay(attempt, std::chrono::milliseconds(100));
+        EXPECT_LE(delay.count(), 100 << (attempt - 1));
+    }
+    EXPECT_EQ(RateLimiter::shared("test/model"), RateLimiter::shared("test/model"));
+}
+
+TEST(LLMTransportTest, BlockingChatFailsOnTheLoopThread) {
+    OpenAIProvider provider("test-key", "test-model");
+    EXPECT_FALSE(HttpTransport::shared().on_loop_thread());
+
+    // Waiting for a reply inside a callback would stall the loop that delivers it
+    std::promise<LLMResponse> inside;
+    HttpTransport::shared().schedule(HttpTransport::Clock::now(), [&](bool) {
+        inside.set_value(provider.complete("hi"));
+    });
+    auto future = inside.get_future();
+    ASSERT_EQ(future.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    LLMResponse response = future.get();
+    EXPECT_FALSE(response.success);
+    EXPECT_NE(response.error_message.find("loop thread"), std::string::npos);
+}
+
+// Minimal HTTP/1.1 server on 127.0.0.1: answers each request with the next
+// canned response (repeating the last), one connection at a time
+class CannedHttpServer {
+public:
+    explicit CannedHttpServer(std::vector<std::string> responses) : responses_(std::move(responses)) {
+        listener_ = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        bind(listener_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+        listen(listener_, 64);
+        socklen_t len = sizeof(addr);
+        getsockname(listener_, reinterpret_cast<sockaddr*>(&addr), &len);
+        port_ = ntohs(addr.sin_port);
+        thread_ = std::thread([this]() { serve(); });
+    }
+
+    ~CannedHttpServer() {
+        stop_ = true;
+        thread_.join();
+        close(listener_);
+    }
+
+    std::string url() const { return "http://127.0.0.1:" + std::to_string(port_); }
+    size_t requests() const { return requests_; }
+
+    void set_responses(std::vector<std::string> responses) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        responses_ = std::move(responses);
+        next_ = 0;
+    }
+
+    static std::string reply(int status, const std::string& body, const std::string& headers = "") {
+        return "HTTP/1.1 " + std::to_string(status) + " Canned\r\nContent-Type: application/json\r\n" +
+               headers + "Content-Length: " + std::to_string(body.size()) +
+               "\r\nConnection: close\r\n\r\n" + body;
+    }
+
+private:
+    int listener_ = -1;
+    int port_ = 0;
+    std::vector<std::string> responses_;
+    size_t next_ = 0;
+    std::mutex mutex_;
+    std::atomic<size_t> requests_{0};
+    std::atomic<bool> stop_{false};
+    std::thread thread_;
+
+    void serve() {
+        while (!stop_) {
+            pollfd pfd{listener_, POLLIN, 0};
+            if (poll(&pfd, 1, 20) <= 0) continue;
+            int client = accept(listener_, nullptr, nullptr);
+            if (client < 0) continue;
+
+            // Read the headers, then Content-Length bytes of body
+            std::string request;
+            char buffer[4096];
+            size_t header_end = std::string::npos;
+            size_t wanted = 0;
+            while (true) {
+                ssize_t n = recv(client, buffer, sizeof(buffer), 0);
+                if (n <= 0) break;
+                request.append(buffer, static_cast<size_t>(n));
+                if (header_end == std::string::npos && (header_end = request.find("\r\n\r\n")) != std::string::npos) {
+                    size_t at = request.find("Content-Length: ");
+                    size_t length = at < header_end ? std::stoul(request.substr(at + 16)) : 0;
+                    wanted = header_end + 4 + length;
+                }
+                if (header_end != std::string::npos && request.size() >= wanted) break;
+            }
+
+            std::string response;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                response = responses_[std::min(next_++, responses_.size() - 1)];
+            }
+            ++requests_;
+            send(client, response.data(), response.size(), MSG_NOSIGNAL);
+            close(client);
+        }
+    }
+};
+
+TEST(LLMTransportTest, ChatRetriesThrottlingAndRunsConcurrently) {
+    const std::string completion =
+        R"({"model":"test","choices":[{"message":{"content":"hello"}}],)"
+        R"("usage":{"prompt_tokens":3,"completion_tokens":2,"total_tokens":5}})";
+    CannedHttpServer server({
+        CannedHttpServer::reply(429, "{}", "Retry-After: 0\r\n"),
+        CannedHttpServer::reply(200, completion),
+    });
+
+    OpenAIProvider provider("test-key", "test-model");
+    LLMConfig config = provider.get_config();
+    config.api_base_url = server.url();
+    provider.set_config(config);
+    provider.set_rate_limiter(std::make_shared<RateLimiter>());
+
+    LLMResponse response = provider.complete("hi");
+    EXPECT_TRUE(response.success) << response.error_message;
+    EXPECT_EQ(response.content, "hello");
+    EXPECT_EQ(response.total_tokens, 5);
+    EXPECT_EQ(server.requests(), 2u);
+
+    std::vector<std::future<LLMResponse>> calls;
+    for (int i = 0; i < 16; ++i) {
+        calls.push_back(provider.chat_async({Message(Message::Role::User, "q" + std::to_string(i))}));
+    }
+    for (auto& call : calls) {
+        EXPECT_EQ(call.get().content, "hello");
+    }
+    EXPECT_EQ(server.requests(), 18u);
+
+    // Client errors fail without retrying
+    server.set_responses({CannedHttpServer::reply(400, R"({"error":{"message":"bad request"}})")});
+    auto extraction = provider.extract_relations_async("text", "chunk_0").get();
+    EXPECT_FALSE(extraction.success);
+    EXPECT_EQ(extraction.chunk_id, "chunk_0");
+    EXPECT_EQ(server.requests(), 19u);
+}
+
+TEST(LLMTransportTest, ShutdownCancelsScheduledTasks) {
+    std::atomic<int> ran{0};
+    std::atomic<int> cancelled{0};
+    auto task = [&](bool was_cancelled) { ++(was_cancelled ? cancelled : ran); };
+    {
+        HttpTransport transport;
+        transport.schedule(HttpTransport::Clock::now(), task);
+        transport.schedule(HttpTransport::Clock::now() + std::chrono::hours(1), task);
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (ran == 0 && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    EXPECT_EQ(ran, 1);
+    EXPECT_EQ(cancelled, 1);
+}
+
+TEST(ResponseCacheTest, ServesRepeatedRequestsFromDisk) {
+    // Key is SHA-256 over length-prefixed provider, model and payload
+    EXPECT_EQ(ResponseCache::make_key("OpenAI", "gpt-4", "{}"),
+              "7d2c65a32abb2f6adf8b56dfd3cb6183beb78b124b4825d787c027d57091c946");
+    EXPECT_NE(ResponseCache::make_key("OpenAI", "gpt-4", "{}"), ResponseCache::make_key("Gemini", "gpt-4", "{}"));
+
+    auto dir = std::filesystem::temp_directory_path() / ("kg_cache_test_" + std::to_string(::getpid()));
+    std::filesystem::remove_all(dir);
+
+    const std::string completion =
+        R"({"model":"test","choices":[{"message":{"content":"cached"}}],)"
+        R"("usage":{"prompt_tokens":3,"completion_tokens":2,"total_tokens":5}})";
+    CannedHttpServer server({CannedHttpServer::reply(200, completion)});
+
+    OpenAIProvider provider("test-key", "test-model");
+    LLMConfig config = provider.get_config();
+    config.api_base_url = server.url();
+    provider.set_config(config);
+    provider.set_response_cache(std::make_shared<ResponseCache>(dir.string()));
+
+    LLMResponse first = provider.complete("same prompt");
+    EXPECT_EQ(first.metadata["cache"], "miss");
+    LLMResponse again = provider.complete("same prompt");
+    EXPECT_EQ(again.metadata["cache"], "hit");
+    EXPECT_EQ(again.content, "cached");
+    EXPECT_EQ(again.total_tokens, 5);
+    EXPECT_EQ(server.requests(), 1u);
+
+    // Writes happen off the calling thread; flush() waits for them
+    provider.get_response_cache()->flush();
+    size_t entries = 0;
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(dir)) {
+        entries += entry.path().extension() == ".json";
+    }
+    EXPECT_EQ(entries, 1u);
+
+    // A different generation parameter is a different entry, and a fresh
+    // cache object reads the entries written by the first
+    config.temperature = 0.5;
+    provider.set_config(config);
+    EXPECT_EQ(provider.complete("same prompt").metadata["cache"], "miss");
+    provider.get_response_cache()->flush();
+    auto reopened = std::make_shared<ResponseCache>(dir.string());
+    provider.set_response_cache(reopened);
+    EXPECT_EQ(provider.complete("same prompt").metadata["cache"], "hit");
+    EXPECT_EQ(reopened->hits(), 1u);
+    EXPECT_EQ(server.requests(), 2u);
+
+    std::filesystem::remove_all(dir);
+}
+
+TEST(ResponseCacheTest, RefetchesRepliesWhoseRelationsDoNotParse) {
+    auto dir = std::filesystem::temp_directory_path() / ("kg_cache_parse_test_" + std::to_string(::getpid()));
+    std::filesystem::remove_all(dir);
+
+    const std::string malformed =
+        R"({"model":"test","choices":[{"message":{"content":"Sorry, no JSON today."}}]})";
+    const std::string extraction =
+        R"({"model":"test","choices":[{"message":{"content":)"
+        R"("{\"relations\":[{\"sources\":[\"aspirin\"],\"relation\":\"inhibits\",\"targets\":[\"COX-1\"]}]}"}}]})";
+    CannedHttpServer server({
+        CannedHttpServer::reply(200, malformed),
+        CannedHttpServer::reply(200, extraction),
+    });
+
+    OpenAIProvider provider("test-key", "test-model");
+    LLMConfig config = provider.get_config();
+    config.api_base_url = server.url();
+    provider.set_config(config);
+    provider.set_response_cache(std::make_shared<ResponseCache>(dir.string()));
+
+    ExtractionResult first = provider.extract_relations("Aspirin inhibits COX-1.", "c0");
+    EXPECT_FALSE(first.success);
+    EXPECT_EQ(server.requests(), 1u);
+
+    // The unparseable reply was dropped, so the same request goes out again
+    ExtractionResult second = provider.extract_relations("Aspirin inhibits COX-1.", "c0");
+    EXPECT_TRUE(second.success) << second.error_message;
+    ASSERT_EQ(second.relations.size(), 1u);
+    EXPECT_EQ(second.llm_response.metadata["cache"], "miss");
+    EXPECT_EQ(server.requests(), 2u);
+
+    ExtractionResult third = provider.extract_relations("Aspirin inhibits COX-1.", "c0");
+    EXPECT_EQ(third.llm_response.metadata["cache"], "hit");
+    EXPECT_EQ(server.requests(), 2u);
+
+    provider.get_response_cache()->flush();
+    size_t entries = 0;
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(dir)) {
+        entries += entry.path().extension() == ".json";
+    }
+    EXPECT_EQ(entries, 1u);
+
+    std::filesystem::remove_all(dir);
+}
+
+TEST(ExtractionJournalTest, ResumesJournalledChunksAfterTornWrite) {
+    auto path = std::filesystem::temp_directory_path() /
+        ("kg_journal_test_" + std::to_string(::getpid()) + ".jsonl");
+    std::filesystem::remove(path);
+
+    ExtractionResult result;
+    result.chunk_id = "doc_chunk_0";
+    result.success = true;
+    ExtractedRelation rel;
+    rel.sources = {"aspirin"};
+    rel.relation = "inhibits";
+    rel.targets = {"COX-1", "COX-2"};
+    rel.confidence = 0.9;
+    rel.properties["section"] = "results";
+    result.relations.push_back(rel);
+    result.llm_response.total_tokens = 42;
+
+    ExtractionResult failed;
+    failed.chunk_id = "doc_chunk_1";
+
+    // Request keys cover the chunk text, model, prompts and generation parameters
+    OpenAIProvider provider("test-key", "gpt-4o-mini");
+    LLMConfig llm_config = provider.get_config();
+    const std::string text = "Aspirin inhibits COX-1 and COX-2.";
+    const std::string key_a = provider.extraction_key(text);
+    EXPECT_EQ(provider.extraction_key(text), key_a);
+    EXPECT_NE(provider.extraction_key("Aspirin inhibits COX-2."), key_a);
+    EXPECT_NE(provider.extraction_key(text, "Extract drug targets."), key_a);
+    llm_config.temperature = 0.7;
+    provider.set_config(llm_config);
+    EXPECT_NE(provider.extraction_key(text), key_a);
+    llm_config.temperature = 0.0;
+    llm_config.model = "gpt-4o";
+    provider.set_config(llm_config);
+    EXPECT_NE(provider.extraction_key(text), key_a);
+
+    {
+        ExtractionJournal journal(path.string());
+        journal.append("doc", key_a, result);
+        journal.append("doc", "key_b", failed);
+        EXPECT_EQ(journal.size(), 1u);
+        EXPECT_EQ(journal.recovered(), 0u);
+        // Appended records go to disk only
+        EXPECT_FALSE(journal.lookup("doc", "doc_chunk_0", key_a));
+    }
+
+    // A crash mid-append leaves a line without its newline
+    {
+        std::ofstream torn(path, std::ios::app);
+        torn << R"({"document_id":"doc","chunk_id":"doc_chunk_2","rel)";
+    }
+
+    ExtractionJournal reopened(path.string());
+    EXPECT_EQ(reopened.recovered(), 1u);
+    auto resumed = reopened.lookup("doc", "doc_chunk_0", key_a);
+    ASSERT_TRUE(resumed.has_value());
+    EXPECT_TRUE(resumed->success);
+    ASSERT_EQ(resumed->relations.size(), 1u);
+    EXPECT_EQ(resumed->relations[0].targets, rel.targets);
+    EXPECT_EQ(resumed->relations[0].properties["section"], "results");
+    EXPECT_EQ(resumed->llm_response.total_tokens, 42);
+    EXPECT_EQ(resumed->llm_response.metadata["journal"], "resumed");
+
+    // Failed, torn, changed requests and other documents' chunks are extracted again
+    EXPECT_FALSE(reopened.lookup("doc", "doc_chunk_1", "key_b"));
+    EXPECT_FALSE(reopened.lookup("doc", "doc_chunk_0", provider.extraction_key(text)));
+    EXPECT_FALSE(reopened.lookup("other", "doc_chunk_0", key_a));
+
+    // The torn tail was cut, so new records start on their own line
+    result.chunk_id = "doc_chunk_2";
+    reopened.append("doc", "key_c", result);
+    reopened.sync();
+    EXPECT_EQ(ExtractionJournal(path.string()).recovered(), 2u);
+
+    // Without resume the earlier run's records are discarded
+    ExtractionJournal::Options fresh;
+    fresh.resume = false;
+    EXPECT_EQ(ExtractionJournal(path.string(), fresh).recovered(), 0u);
+    EXPECT_EQ(ExtractionJournal(path.string()).recovered(), 0u);
+
+    std::filesystem::remove(path);
+}
+
+// Provider whose async calls complete in reverse order of submission, once
+// `batch` of them are pending; each reply names the call it answers
+class ReverseOrderProvider : public LLMProvider {
+public:
+    explicit ReverseOrderProvider(size_t batch) : batch_(batch) {}
+    ~ReverseOrderProvider() override {
+        if (replier_.joinable()) replier_.join();
+    }
+
+    LLMResponse complete(const std::string&) override { return {}; }
+    LLMResponse chat(const std::vector<Message>&) override { return {}; }
+    ExtractionResult extract_relations(const std::string&, const std::string&, const std::string&) override {
+        return {};
+    }
+    std::string get_provider_name() const override { return "reverse"; }
+    std::string get_model() const override { return "reverse"; }
+    bool is_configured() const override { return true; }
+    void set_config(const LLMConfig& config) override { config_ = config; }
+    LLMConfig get_config() const override { return config_; }
+
+    void chat_async(const std::vector<Message>&, std::function<void(LLMResponse)> on_done) override {
+        pending_.push_back(std::move(on_done));
+        if (pending_.size() < batch_) return;
+
+        replier_ = std::thread([this]() {
+            for (size_t call = pending_.size(); call-- > 0;) {
+                LLMResponse response;
+                response.success = true;
+                response.content = R"({"relations":[{"sources":["call)" + std::to_string(call) +
+                    R"("],"relation":"answers","targets":["chunk"]}]})";
+                pending_[call](response);
+            }
+        });
+    }
+
+private:
+    size_t batch_;
+    std::vector<std::function<void(LLMResponse)>> pending_;
+    std::thread replier_;
+};
+
+TEST(ExtractionPipelineTest, CollectsChunksInOrderWhenCompletedOutOfOrder) {
+    PipelineConfig config;
+    config.llm_api_key = "test";
+    config.output_directory = (std::filesystem::temp_directory_path() /
+        ("kg_pipeline_test_" + std::to_string(::getpid()))).string();
+    config.parallel_processing = true;
+    config.max_concurrent_requests = 8;
+    config.enable_llm_cache = false;
+    config.enable_journal = false;
+    config.save_extractions = false;
+    config.save_intermediate = false;
+    config.verbose = false;
+
+    const size_t num_chunks = 5;
+    ExtractionPipeline pipeline(config);
+    pipeline.set_llm_provider(std::make_unique<ReverseOrderProvider>(num_chunks));
+
+    std::vector<TextChunk> chunks(num_chunks);
+    for (size_t i = 0; i < num_chunks; ++i) {
+        chunks[i].text = "Chunk " + std::to_string(i) + " text.";
+        chunks[i].chunk_id = "doc_chunk_" + std::to_string(i);
+        chunks[i].chunk_index = static_cast<int>(i);
+    }
+
+    auto results = pipeline.extract_from_chunks(chunks, "doc");
+    ASSERT_EQ(results.size(), num_chunks);
+    for (size_t i = 0; i < num_chunks; ++i) {
+        EXPECT_TRUE(results[i].success);
+        EXPECT_EQ(results[i].chunk_id, chunks[i].chunk_id);
+        ASSERT_EQ(results[i].relations.size(), 1u);
+        EXPECT_EQ(results[i].relations[0].sources[0], "call" + std::to_string(i));
+    }
+    EXPECT_EQ(pipeline.get_statistics().extraction_successes, static_cast<int>(num_chunks));
+
+    std::filesystem::remove_all(config.output_directory);
+}
+
 // ==========================================
 // Edge Cases
 // ==========================================